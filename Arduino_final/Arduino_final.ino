@@ -4,7 +4,17 @@
 #include "Utils.h"
 #include "CommandTable.h"
 #include "EEPROMManager.h"
-#include "EMGSensor.h"
+#include "EMGSensorBank.h"
+#include "EMGTelemetry.h"
+#include "EMGCommandLink.h"
+#include "TxBuffer.h"
+#include "LineParser.h"
+#include "RttHistogram.h"
+#include "TimerWheel.h"
+#include "HttpRequestParser.h"
+#include "FormParser.h"
+#include "GzipPage.h"
+#include "WebPages.h"
 #include "EMGSystem.h"
 #include "WiFiConfigSystem.h"
 #include "LCDDisplay.h"
@@ -21,11 +31,17 @@ WiFiConfigSystem wifiConfig(emgSystem, &display);
  */
 void setup()
 {
+    // Nejmenší rezerva SRAM za běh se hlásí v GET /status (ramUnused)
+    paintFreeMemory();
+
     pinMode(debugPin, INPUT_PULLUP);
     pinMode(serialPrintPin, INPUT_PULLUP);
     pinMode(resetNetworkCreds, INPUT_PULLUP);
     Serial.begin(serialBaudRate);
-    while (!Serial)
+
+    // Bez připojeného USB hostitele se nečeká, start jen krátce počká na terminál
+    unsigned long serialStart = millis();
+    while (!Serial && millis() - serialStart < serialWaitMs)
         ;
 
     // Kontrola reset síťových přihlašovacích údajů
@@ -60,14 +76,14 @@ void setup()
     {
         display.printAt(0, 0, F("EMG System"));
         display.printAt(0, 1, F("Inicializace..."));
-        delay(1000);
     }
 
     // Předání LCD displeje do systémů
     emgSystem.setLCDDisplay(&display);
 
+    // Připojení k síti dokončí loop(), vzorkování už běží
     wifiConfig.begin();
-    printIfPinLow(F("Systém připraven."), debugPin);
+    printIfPinLow(F("Systém spuštěn, připojování k WiFi probíhá na pozadí."), debugPin);
 
     while (digitalRead(debugPin) == LOW && digitalRead(serialPrintPin) == LOW)
     {
@@ -85,8 +101,6 @@ void setup()
  */
 void loop()
 {
-    int timeStart = millis();
+    // Vzorkovací takt drží časovač v EMGAcquisition, smyčka běží bez čekání
     wifiConfig.update();
-    int timeEnd = millis();
-    delay(max(0, refreshRate - (timeEnd - timeStart)));
 }
@@ -6,13 +6,20 @@
 /**
  * @brief WiFi konfigurace a systémové parametry
  */
-const char apSSID[] = "ArduinoAP";        // SSID Access Pointu
-const char apPass[] = "12345678";         // Heslo Access Pointu
-const int httpPort = 80;                  // HTTP port pro web server
-const int tcpPort = 8888;                 // TCP port pro EMG server
-const int serialBaudRate = 9600;          // Baud rate pro Serial komunikaci
-const uint16_t wifiTimeoutMs = 20000;     // Timeout pro WiFi připojení v ms
-const uint16_t apStabilizationMs = 10000; // Čas pro stabilizaci AP v ms
+const char apSSID[] = "ArduinoAP";            // SSID Access Pointu
+const char apPass[] = "12345678";             // Heslo Access Pointu
+const int httpPort = 80;                      // HTTP port pro web server
+const int tcpPort = 8888;                     // TCP port pro EMG server
+const int serialBaudRate = 9600;              // Baud rate pro Serial komunikaci
+const uint16_t serialWaitMs = 1500;           // Nejdelší čekání na USB Serial po zapnutí v ms
+const uint16_t wifiTimeoutMs = 20000;         // Timeout pro WiFi připojení v ms
+const uint16_t wifiNoSsidGraceMs = 4000;      // Doba hlášení nenalezené sítě, po které se pokus vzdá v ms
+const uint16_t wifiPollIntervalMs = 250;      // Interval dotazu na stav WiFi modulu při připojování v ms
+const uint16_t wifiProgressIntervalMs = 1000; // Interval obnovy průběhu připojování na LCD v ms
+const uint16_t apStartTimeoutMs = 10000;      // Timeout pro spuštění AP v ms
+const uint16_t wifiLinkCheckMs = 1000;        // Interval kontroly spojení v režimu STA v ms
+const uint16_t wifiRetryMinMs = 1000;         // První odklad opakovaného připojení po výpadku v ms
+const uint16_t wifiRetryMaxMs = 30000;        // Nejdelší odklad opakovaného připojení (odklad se zdvojuje) v ms
 
 /**
  * @brief EEPROM konfigurace
@@ -20,6 +27,7 @@ const uint16_t apStabilizationMs = 10000; // Čas pro stabilizaci AP v ms
 const int EEPROM_ADDR_WIFISSID = 0;  // EEPROM adresa pro WiFi SSID
 const int EEPROM_ADDR_WIFIPASS = 40; // EEPROM adresa pro WiFi heslo (odděleno dostatečně)
 const int maxStringLength = 31;      // Maximální délka řetězce v EEPROM
+const int EEPROM_ADDR_CALIB = 80;    // EEPROM adresa pro záznam kalibrace EMG kanálů (za WiFi heslem)
 
 /**
  * @brief Placeholder hodnoty pro reset síťových přihlašovacích údajů
@@ -30,14 +38,74 @@ const char placeholderPass[] = "PLACEHOLDER"; // Placeholder heslo
 /**
  * @brief EMG systém parametry
  */
-const int refreshRateHz = 1000;                   // Frekvence aktualizace v Hz
-const int refreshRate = 1000 / refreshRateHz;     // Perioda smyčky v ms
 const int debugPin = 7;                           // Pin pro výpis debug informací
 const int serialPrintPin = 6;                     // Pin pro výpis dat přes Serial
 const int resetNetworkCreds = 5;                  // Pin pro reset síťových přihlašovacích údajů
-const int maxSensors = 4;                         // Maximální počet podporovaných senzorů
 const int emgPins[maxSensors] = {A0, A1, A2, A3}; // Analogové piny EMG senzorů
-const uint16_t aliveIntervalMs = 10000;           // Interval mezi "ALIVE" zprávami
+const uint8_t emgChannelCount = 2;                // Výchozí počet používaných kanálů (nejvýše maxSensors)
+const uint16_t aliveIntervalMs = 1000;            // Interval mezi "ALIVE" zprávami (heartbeat zařízení)
+const uint16_t calibrationWindowMs = 3000;        // Délka kalibračního okna v ms (všechny kanály současně)
+
+/**
+ * @brief Parametry obálky EMG signálu
+ */
+const EMGEnvelopeMode envelopeMode = EMG_ENVELOPE_EMA; // Výchozí způsob výpočtu obálky
+
+/**
+ * @brief Parametry detekce nástupu a konce aktivity
+ */
+const uint16_t onsetDebounceMs = 5;     // Jak dlouho musí obálka setrvat nad horním prahem
+const uint16_t offsetDebounceMs = 50;   // Jak dlouho musí obálka setrvat pod dolním prahem
+const uint16_t commandCooldownMs = 250; // Minimální odstup dvou akcí téhož kanálu
+
+/**
+ * @brief Parametry průběžného sledování klidové úrovně a šumu
+ */
+const uint16_t restHoldoffMs = 200;     // Po konci aktivity se klid začne sledovat až po této době
+const uint16_t activityLimitMs = 10000; // Delší souvislá aktivita se považuje za posun klidové úrovně
+const uint8_t baselineFlatFactor = 4;   // Dlouhá aktivita se sleduje jen s rozptylem nejvýše tolikrát větším než v klidu
+const uint8_t calibrationSaveShift = 3; // Kalibrace se uloží, jen když se práh změní o více než 1/2^n uložené hodnoty (12,5 %)
+
+/**
+ * @brief Parametry příjmu příkazů od klienta TCP serveru EMG
+ */
+const uint8_t clientRxBudgetBytes = 64;      // Max. počet bajtů zpracovaných za průchod smyčkou
+const uint16_t clientRxBudgetUs = 500;       // Max. doba zpracování příkazů za průchod smyčkou v µs
+const uint16_t clientStatusIntervalMs = 250; // Interval dotazů na stav socketů (každý dotaz je přenos po SPI)
+const uint16_t clientTimeoutMs = 3000;       // Klient s heartbeatem, který tak dlouho nic nepošle, se odpojí (3 ALIVE)
+
+/**
+ * @brief Parametry HTTP serveru (REST API a konfigurační stránka)
+ */
+const uint8_t httpRxBudgetBytes = 64;       // Max. počet bajtů požadavků zpracovaných za průchod smyčkou
+const uint16_t httpRxBudgetUs = 300;        // Max. doba čtení požadavků za průchod smyčkou v µs
+const uint16_t httpRequestTimeoutMs = 2000; // Nedokončený požadavek se po této době zahodí (pomalý nebo nečinný prohlížeč)
+const uint8_t httpMaxBacklogFrames = 8;     // Čeká-li víc nezpracovaných snímků, HTTP se v průchodu vynechá (zpracování EMG má přednost)
+
+/**
+ * @brief Parametry binární telemetrie obálek (příkaz STREAM)
+ */
+const uint8_t telemetrySamplesPerFrame = 16; // Výchozí počet vzorků v rámci (jeden client.write na rámec)
+
+/**
+ * @brief Parametry odesílání příkazů přes UDP (příkaz UDP)
+ */
+const int udpCommandPort = 8889;           // Lokální UDP port zařízení (zdrojový port datagramů)
+const uint8_t udpCommandRepeats = 3;       // Výchozí počet kopií každého příkazu
+const uint8_t udpMaxRepeats = 8;           // Max. počet kopií každého příkazu
+const uint16_t udpRepeatIntervalUs = 2000; // Odstup kopií téhož příkazu v µs (kopie nepadnou do jedné dávky ztrát)
+
+/**
+ * @brief Parametry časového kola odložených akcí (TimerWheel)
+ */
+const uint8_t timerHandlersPerPass = 1; // Max. obsluh časovačů za jeden průchod smyčky (zbytek čeká)
+const uint16_t autoStopDelayMs = 500;   // Po příkazu robotovi se za tuto dobu pošle "0" (0 = vypnuto)
+
+/**
+ * @brief Parametry měření odezvy řídicího klienta (příkaz RTT)
+ */
+const uint16_t rttPingIntervalMs = 1000; // Interval PINGů zařízení
+const uint16_t rttPingTimeoutMs = 2000;  // PING bez odpovědi po této době se počítá jako ztracený
 
 /**
  * @brief Resetuje síťové přihlašovací údaje na placeholder hodnoty
@@ -6,13 +6,20 @@
 /**
  * @brief WiFi konfigurace a systémové parametry
  */
-extern const char apSSID[];              // SSID Access Pointu
-extern const char apPass[];              // Heslo Access Pointu
-extern const int httpPort;               // HTTP port pro web server
-extern const int tcpPort;                // TCP port pro EMG server
-extern const int serialBaudRate;         // Baud rate pro Serial komunikaci
-extern const uint16_t wifiTimeoutMs;     // Timeout pro WiFi připojení v ms
-extern const uint16_t apStabilizationMs; // Čas pro stabilizaci AP v ms
+extern const char apSSID[];                   // SSID Access Pointu
+extern const char apPass[];                   // Heslo Access Pointu
+extern const int httpPort;                    // HTTP port pro web server
+extern const int tcpPort;                     // TCP port pro EMG server
+extern const int serialBaudRate;              // Baud rate pro Serial komunikaci
+extern const uint16_t serialWaitMs;           // Nejdelší čekání na USB Serial po zapnutí v ms
+extern const uint16_t wifiTimeoutMs;          // Timeout pro WiFi připojení v ms
+extern const uint16_t wifiNoSsidGraceMs;      // Doba hlášení nenalezené sítě, po které se pokus vzdá v ms
+extern const uint16_t wifiPollIntervalMs;     // Interval dotazu na stav WiFi modulu při připojování v ms
+extern const uint16_t wifiProgressIntervalMs; // Interval obnovy průběhu připojování na LCD v ms
+extern const uint16_t apStartTimeoutMs;       // Timeout pro spuštění AP v ms
+extern const uint16_t wifiLinkCheckMs;        // Interval kontroly spojení v režimu STA v ms
+extern const uint16_t wifiRetryMinMs;         // První odklad opakovaného připojení po výpadku v ms
+extern const uint16_t wifiRetryMaxMs;         // Nejdelší odklad opakovaného připojení (odklad se zdvojuje) v ms
 
 /**
  * @brief EEPROM konfigurace
@@ -20,6 +27,7 @@ extern const uint16_t apStabilizationMs; // Čas pro stabilizaci AP v ms
 extern const int EEPROM_ADDR_WIFISSID; // EEPROM adresa pro WiFi SSID
 extern const int EEPROM_ADDR_WIFIPASS; // EEPROM adresa pro WiFi heslo
 extern const int maxStringLength;      // Maximální délka řetězce v EEPROM
+extern const int EEPROM_ADDR_CALIB;    // EEPROM adresa pro záznam kalibrace EMG kanálů
 
 /**
  * @brief Placeholder hodnoty pro reset síťových přihlašovacích údajů
@@ -35,13 +43,154 @@ void resetNetworkCredentials();
 /**
  * @brief EMG systém parametry
  */
-extern const int refreshRateHz;        // Frekvence aktualizace v Hz
-extern const int refreshRate;          // Perioda smyčky v ms
-extern const int debugPin;             // Pin pro výpis debug informací
-extern const int serialPrintPin;       // Pin pro výpis dat přes Serial
-extern const int resetNetworkCreds;    // Pin pro reset síťových přihlašovacích údajů
-extern const int maxSensors;           // Maximální počet podporovaných senzorů
-extern const int emgPins[];            // Analogové piny EMG senzorů
-extern const uint16_t aliveIntervalMs; // Interval mezi "ALIVE" zprávami
+const int refreshRateHz = 1000;               // Frekvence vzorkování v Hz (v hlavičce kvůli návrhu filtrů)
+const int refreshRate = 1000 / refreshRateHz; // Perioda vzorkování v ms
+extern const int debugPin;                    // Pin pro výpis debug informací
+extern const int serialPrintPin;              // Pin pro výpis dat přes Serial
+extern const int resetNetworkCreds;           // Pin pro reset síťových přihlašovacích údajů
+const int maxSensors = 4;                     // Maximální počet podporovaných senzorů (v hlavičce kvůli velikosti polí)
+extern const int emgPins[];                   // Analogové piny EMG senzorů
+extern const uint8_t emgChannelCount;         // Výchozí počet používaných kanálů (nejvýše maxSensors)
+extern const uint16_t aliveIntervalMs;        // Interval mezi "ALIVE" zprávami
+extern const uint16_t calibrationWindowMs;    // Délka kalibračního okna v ms (všechny kanály současně)
+
+/**
+ * @brief Parametry přerušením řízeného vzorkování
+ */
+const uint8_t acquisitionBufferFrames = 32; // Kapacita kruhového bufferu vzorků (mocnina dvou)
+
+/**
+ * @brief Parametry filtrace EMG kanálů
+ */
+const uint8_t filterCpuBudgetPercent = 25; // Max. podíl CPU pro filtry všech kanálů (kontrola odhadů při překladu)
+
+/**
+ * @brief Způsob výpočtu obálky EMG signálu
+ */
+enum EMGEnvelopeMode : uint8_t
+{
+    EMG_ENVELOPE_EMA, // Exponenciální vyhlazování (alpha 0.6)
+    EMG_ENVELOPE_MAV, // Průměr absolutních hodnot přes okno
+    EMG_ENVELOPE_RMS  // Efektivní hodnota přes okno
+};
+
+/**
+ * @brief Parametry obálky EMG signálu
+ */
+const uint8_t envelopeWindowLog2 = 6;                          // Max. délka okna MAV/RMS jako mocnina dvou (64 vzorků)
+const uint8_t envelopeWindowSamples = 1 << envelopeWindowLog2; // Max. délka okna MAV/RMS ve vzorcích
+const uint8_t envelopeWindowPoolSamples = 128;                 // Vzorky oken všech používaných kanálů dohromady (v hlavičce kvůli velikosti pole)
+extern const EMGEnvelopeMode envelopeMode;                     // Výchozí způsob výpočtu obálky
+
+/**
+ * @brief Parametry detekce nástupu a konce aktivity
+ */
+extern const uint16_t onsetDebounceMs;   // Jak dlouho musí obálka setrvat nad horním prahem
+extern const uint16_t offsetDebounceMs;  // Jak dlouho musí obálka setrvat pod dolním prahem
+extern const uint16_t commandCooldownMs; // Minimální odstup dvou akcí téhož kanálu
+
+/**
+ * @brief Parametry průběžného sledování klidové úrovně a šumu
+ */
+const uint8_t baselineTrackingShift = 14;  // Časová konstanta sledování 2^14 vzorků (~16 s), v hlavičce kvůli posunu při překladu
+extern const uint16_t restHoldoffMs;       // Po konci aktivity se klid začne sledovat až po této době
+extern const uint16_t activityLimitMs;     // Delší souvislá aktivita se považuje za posun klidové úrovně
+extern const uint8_t baselineFlatFactor;   // Dlouhá aktivita se sleduje jen s rozptylem nejvýše tolikrát větším než v klidu
+extern const uint8_t calibrationSaveShift; // Kalibrace se uloží, jen když se práh změní o více než 1/2^n uložené hodnoty
+
+/**
+ * @brief Parametry příjmu příkazů od klienta TCP serveru EMG
+ */
+const uint8_t maxClients = 4;                 // Max. počet současně připojených klientů (v hlavičce kvůli velikosti pole)
+const uint8_t clientLineBytes = 32;           // Max. délka řádku příkazu včetně '\0', nejdelší je "STREAM 32 RAW" (v hlavičce kvůli velikosti bufferu)
+const uint8_t clientRxChunkBytes = 16;        // Bajty přečtené z modulu jedním voláním client.read
+extern const uint8_t clientRxBudgetBytes;     // Max. počet bajtů zpracovaných za průchod smyčkou
+extern const uint16_t clientRxBudgetUs;       // Max. doba zpracování příkazů za průchod smyčkou v µs
+extern const uint16_t clientStatusIntervalMs; // Interval dotazů na stav socketů (connected, nová spojení)
+extern const uint16_t clientTimeoutMs;        // Klient s heartbeatem, který tak dlouho nic nepošle, se odpojí
+
+/**
+ * @brief Parametry HTTP serveru (REST API a konfigurační stránka)
+ */
+const uint8_t httpMaxConnections = 2;       // Max. počet rozpracovaných HTTP spojení (v hlavičce kvůli velikosti pole)
+const uint8_t httpRequestBytes = 192;       // Společný buffer cesty s dotazem a těla, obojí včetně '\0' (v hlavičce kvůli velikosti bufferu)
+const uint8_t httpTargetBytes = 128;        // Max. délka cesty s dotazem včetně '\0'
+const uint8_t httpBodyBytes = 160;          // Tělo, které se vejde vždy (s cestou "/"), pojme formulář s SSID a heslem
+const uint8_t httpTxBytes = 128;            // Kapacita výstupního bufferu odpovědi (v hlavičce kvůli velikosti pole)
+const uint8_t httpPageChunkBytes = 64;      // Bajty stránky kopírované z flash najednou (v hlavičce kvůli velikosti bufferu)
+const uint8_t httpMaxFormParams = 8;        // Max. počet parametrů dotazu nebo formuláře (v hlavičce kvůli velikosti pole)
+extern const uint8_t httpRxBudgetBytes;     // Max. počet bajtů požadavků zpracovaných za průchod smyčkou
+extern const uint16_t httpRxBudgetUs;       // Max. doba čtení požadavků za průchod smyčkou v µs
+extern const uint16_t httpRequestTimeoutMs; // Nedokončený požadavek se po této době zahodí
+extern const uint8_t httpMaxBacklogFrames;  // Čeká-li víc nezpracovaných snímků, HTTP se v průchodu vynechá
+
+/**
+ * @brief Parametry výstupního bufferu TCP serveru EMG
+ */
+const uint8_t clientTxBytes = 76; // Kapacita bufferu zpráv jednoho průchodu smyčkou pro každého klienta, pojme celý rámec telemetrie (v hlavičce kvůli velikosti pole)
+
+/**
+ * @brief Parametry binární telemetrie obálek (příkaz STREAM)
+ */
+const uint8_t telemetryMaxSamplesPerFrame = 32; // Max. počet vzorků v jednom rámci
+const uint16_t telemetryPayloadBytes = 64;      // Kapacita dat rámce, pojme 16 vzorků 2 kanálů (rámec se musí vejít do clientTxBytes)
+extern const uint8_t telemetrySamplesPerFrame;  // Výchozí počet vzorků v rámci (jeden client.write na rámec)
+
+/**
+ * @brief Parametry odesílání příkazů přes UDP (příkaz UDP)
+ */
+extern const int udpCommandPort;           // Lokální UDP port zařízení (zdrojový port datagramů)
+extern const uint8_t udpCommandRepeats;    // Výchozí počet kopií každého příkazu
+extern const uint8_t udpMaxRepeats;        // Max. počet kopií každého příkazu
+extern const uint16_t udpRepeatIntervalUs; // Odstup kopií téhož příkazu v µs
+
+/**
+ * @brief Parametry časového kola odložených akcí (TimerWheel)
+ */
+const uint8_t timerWheelTickMs = 10;       // Délka tiku (rozlišení časovačů)
+const uint8_t timerWheelBuckets = 32;      // Počet košů, mocnina dvou (v hlavičce kvůli velikosti pole)
+const uint8_t timerWheelCapacity = 8;      // Max. počet časovačů (v hlavičce kvůli velikosti pole)
+extern const uint8_t timerHandlersPerPass; // Max. obsluh časovačů za jeden průchod smyčky (zbytek čeká)
+extern const uint16_t autoStopDelayMs;     // Po příkazu robotovi se za tuto dobu pošle "0" (0 = vypnuto)
+
+/**
+ * @brief Parametry měření odezvy řídicího klienta (příkaz RTT)
+ */
+const uint8_t rttHistogramBuckets = 16;  // Počet košů histogramu (v hlavičce kvůli velikosti pole)
+const uint8_t rttHistogramMinLog2 = 7;   // Horní mez prvního koše 2^7 = 128 µs, každý další koš dvojnásobný
+extern const uint16_t rttPingIntervalMs; // Interval PINGů zařízení
+extern const uint16_t rttPingTimeoutMs;  // PING bez odpovědi po této době se počítá jako ztracený
+
+/**
+ * @brief Teager-Kaiserův operátor před vyhlazením obálky
+ *
+ * Odkomentováním se v řetězcích kanálů místo usměrnění použije TKEO
+ * (EMGTeagerChain v EMGFilter.h), který zostří nástup kontrakce. Prahy se
+ * kalibrují z dat, další úpravy nejsou potřeba.
+ */
+// #define EMG_TKEO_PRESTAGE
+
+/**
+ * @brief Okenní obálky MAV a RMS
+ *
+ * Obálku lze přepnout i na MAV nebo RMS (envelopeMode, příkaz SET MODE).
+ * Okna používaných kanálů sdílí envelopeWindowPoolSamples x 2 B SRAM
+ * (256 B): do dvou kanálů má okno envelopeWindowSamples vzorků, při třech
+ * a čtyřech kanálech polovinu. Zakomentováním se okna nealokují a používá
+ * se jen EMA.
+ */
+#define EMG_WINDOW_ENVELOPE
+
+/**
+ * @brief Volba výpočetní cesty obálky EMG signálu
+ *
+ * Ve výchozím stavu se obálka počítá v pevné řádové čárce za filtračním
+ * řetězcem kanálu (ATmega4809 nemá FPU). Odkomentováním se vrátí původní
+ * výpočet ve float z doby před filtry: bez řetězce z EMGFilter.h a jen s EMA.
+ * Slouží jako historické srovnání rychlosti a chování původní verze, nikoli
+ * jako kontrola shody s pevnou řádovou čárkou, protože zpracovává jiný signál
+ * a detekuje jiný počet nástupů.
+ */
+// #define EMG_FLOAT_PIPELINE
 
 #endif // CONFIG_H
@@ -1,6 +1,11 @@
 #include "EEPROMManager.h"
 #include "Config.h"
 
+const uint8_t *EEPROMManager::pendingData = NULL;
+int EEPROMManager::pendingAddr = 0;
+int EEPROMManager::pendingLength = 0;
+int EEPROMManager::pendingIndex = 0;
+
 /**
  * @brief Inicializuje EEPROM
  */
@@ -63,3 +68,84 @@ int EEPROMManager::readString(int startAddr, char *buffer, int bufferSize)
     buffer[len] = '\0'; // Null terminator
     return len;
 }
+
+/**
+ * @brief Zapíše blok bajtů do EEPROM (přepisuje jen změněné bajty)
+ * @param startAddr Počáteční adresa v EEPROM
+ * @param data Data k zápisu
+ * @param length Délka dat v bajtech
+ */
+void EEPROMManager::writeBlock(int startAddr, const void *data, int length)
+{
+    const uint8_t *bytes = (const uint8_t *)data;
+    for (int i = 0; i < length; i++)
+    {
+        if (EEPROM.read(startAddr + i) != bytes[i])
+        {
+            EEPROM.write(startAddr + i, bytes[i]);
+        }
+    }
+}
+
+/**
+ * @brief Zahájí postupný zápis bloku (dokončí ho volání serviceBlockWrite)
+ * @param startAddr Počáteční adresa v EEPROM
+ * @param data Data k zápisu (musí platit až do dokončení zápisu)
+ * @param length Délka dat v bajtech
+ */
+void EEPROMManager::beginBlockWrite(int startAddr, const void *data, int length)
+{
+    // Nový blok přepíše rozpracovaný od začátku, CRC záznamu hlídá přerušený zápis
+    pendingData = (const uint8_t *)data;
+    pendingAddr = startAddr;
+    pendingLength = length;
+    pendingIndex = 0;
+}
+
+/**
+ * @brief Zapíše nejvýše jeden bajt rozpracovaného bloku (volat v každém průchodu loop)
+ * @return True pokud zápis bloku ještě neskončil
+ */
+bool EEPROMManager::serviceBlockWrite()
+{
+    if (pendingIndex >= pendingLength)
+        return false;
+
+    // EEPROM.write by na dokončení předchozího bajtu čekal aktivně (jednotky ms)
+    if (isBusy())
+        return true;
+
+    int addr = pendingAddr + pendingIndex;
+    uint8_t value = pendingData[pendingIndex++];
+    if (EEPROM.read(addr) != value)
+        EEPROM.write(addr, value);
+
+    return pendingIndex < pendingLength;
+}
+
+/**
+ * @brief Vrací true, pokud EEPROM nedokončila předchozí zápis
+ */
+bool EEPROMManager::isBusy()
+{
+#ifdef NVMCTRL_EEBUSY_bm
+    return NVMCTRL.STATUS & NVMCTRL_EEBUSY_bm;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Načte blok bajtů z EEPROM
+ * @param startAddr Počáteční adresa v EEPROM
+ * @param data Buffer pro načtená data
+ * @param length Délka dat v bajtech
+ */
+void EEPROMManager::readBlock(int startAddr, void *data, int length)
+{
+    uint8_t *bytes = (uint8_t *)data;
+    for (int i = 0; i < length; i++)
+    {
+        bytes[i] = EEPROM.read(startAddr + i);
+    }
+}
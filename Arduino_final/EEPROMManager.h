@@ -31,6 +31,47 @@ public:
      * @return Počet načtených znaků nebo -1 při chybě
      */
     static int readString(int startAddr, char *buffer, int bufferSize);
+
+    /**
+     * @brief Zapíše blok bajtů do EEPROM (přepisuje jen změněné bajty)
+     * @param startAddr Počáteční adresa v EEPROM
+     * @param data Data k zápisu
+     * @param length Délka dat v bajtech
+     */
+    static void writeBlock(int startAddr, const void *data, int length);
+
+    /**
+     * @brief Zahájí postupný zápis bloku (dokončí ho volání serviceBlockWrite)
+     * @param startAddr Počáteční adresa v EEPROM
+     * @param data Data k zápisu (musí platit až do dokončení zápisu)
+     * @param length Délka dat v bajtech
+     */
+    static void beginBlockWrite(int startAddr, const void *data, int length);
+
+    /**
+     * @brief Zapíše nejvýše jeden bajt rozpracovaného bloku (volat v každém průchodu loop)
+     * @return True pokud zápis bloku ještě neskončil
+     */
+    static bool serviceBlockWrite();
+
+    /**
+     * @brief Vrací true, pokud EEPROM nedokončila předchozí zápis
+     */
+    static bool isBusy();
+
+    /**
+     * @brief Načte blok bajtů z EEPROM
+     * @param startAddr Počáteční adresa v EEPROM
+     * @param data Buffer pro načtená data
+     * @param length Délka dat v bajtech
+     */
+    static void readBlock(int startAddr, void *data, int length);
+
+private:
+    static const uint8_t *pendingData; // Data rozpracovaného zápisu bloku
+    static int pendingAddr;            // Počáteční adresa rozpracovaného bloku
+    static int pendingLength;          // Délka rozpracovaného bloku
+    static int pendingIndex;           // Index dalšího porovnávaného bajtu
 };
 
 #endif // EEPROM_MANAGER_H
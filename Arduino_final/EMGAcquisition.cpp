@@ -0,0 +1,280 @@
+#include "EMGAcquisition.h"
+#include "Utils.h"
+
+/**
+ * @brief Globální instance vzorkování
+ */
+EMGAcquisition emgAcquisition;
+
+/**
+ * @brief Přečte 32bitový čítač sdílený s přerušením bez roztržení hodnoty
+ * @param counter Čítač
+ * @return Konzistentní hodnota čítače
+ */
+static uint32_t readCounter(const volatile uint32_t &counter)
+{
+    noInterrupts();
+    uint32_t value = counter;
+    interrupts();
+    return value;
+}
+
+#if defined(ARDUINO_ARCH_MEGAAVR)
+/**
+ * @brief Převede Arduino pin na vstup multiplexeru ADC0 (stejně jako analogRead)
+ * @param pin Arduino pin
+ * @return Číslo vstupu ADC0
+ */
+static uint8_t pinToAdcChannel(uint8_t pin)
+{
+    uint8_t channel = digitalPinToAnalogInput(pin);
+#if defined(analogPinToChannel)
+    channel = analogPinToChannel(channel);
+#endif
+    return channel;
+}
+
+/**
+ * @brief Přerušení časovače TCB2 - začátek nové vzorkovací periody
+ */
+ISR(TCB2_INT_vect)
+{
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    emgAcquisition.onTimer();
+}
+
+/**
+ * @brief Přerušení ADC0 - převod jednoho kanálu dokončen
+ */
+ISR(ADC0_RESRDY_vect)
+{
+    // Čtení výsledku zároveň maže příznak přerušení
+    emgAcquisition.onConversion(ADC0.RES);
+}
+#endif
+
+/**
+ * @brief Spustí periodické vzorkování
+ * @param channels Počet vzorkovaných kanálů z emgPins (nejvýše maxSensors)
+ * @param sampleRateHz Vzorkovací frekvence v Hz
+ */
+void EMGAcquisition::begin(uint8_t channels, uint16_t sampleRateHz)
+{
+    end();
+
+    channelCount = channels > maxSensors ? maxSensors : channels;
+    periodUs = 1000000UL / sampleRateHz;
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        pins[i] = emgPins[i];
+        pinMode(pins[i], INPUT);
+#if defined(ARDUINO_ARCH_MEGAAVR)
+        adcChannels[i] = pinToAdcChannel(pins[i]);
+#else
+        adcChannels[i] = pins[i];
+#endif
+    }
+
+    buffer.clear();
+    converting = false;
+    running = true;
+    nextSampleUs = micros();
+
+#if defined(ARDUINO_ARCH_MEGAAVR)
+    // TCB2 v režimu periodického přerušení, takt CLK_PER / 2
+    TCB2.CTRLA = 0;
+    TCB2.CTRLB = TCB_CNTMODE_INT_gc;
+    TCB2.CCMP = (uint16_t)(F_CPU / 2 / sampleRateHz - 1);
+    TCB2.CNT = 0;
+    TCB2.INTFLAGS = TCB_CAPT_bm;
+    TCB2.INTCTRL = TCB_CAPT_bm;
+    TCB2.CTRLA = TCB_CLKSEL_CLKDIV2_gc | TCB_ENABLE_bm;
+#endif
+
+    printIfPinLow(F("Vzorkování EMG spuštěno"), debugPin);
+}
+
+/**
+ * @brief Zastaví vzorkování
+ */
+void EMGAcquisition::end()
+{
+    if (!running)
+        return;
+
+#if defined(ARDUINO_ARCH_MEGAAVR)
+    TCB2.CTRLA = 0;
+    TCB2.INTCTRL = 0;
+    ADC0.INTCTRL = 0;
+#endif
+
+    running = false;
+    converting = false;
+}
+
+/**
+ * @brief Softwarové vzorkování pro platformy bez časovače TCB (volat v loop)
+ */
+void EMGAcquisition::poll()
+{
+#if !defined(ARDUINO_ARCH_MEGAAVR)
+    if (!running)
+        return;
+
+    // Dohnání zmeškaných period; co se nevejde do bufferu, je započteno jako přetečení
+    unsigned long now = micros();
+    while ((long)(now - nextSampleUs) >= 0)
+    {
+        // Dohnaný snímek nese plánovaný čas, ne čas dohnání
+        sequenceUs = nextSampleUs;
+        onTimer();
+        nextSampleUs += periodUs;
+    }
+#endif
+}
+
+/**
+ * @brief Spustí převod na zvoleném kanálu
+ * @param channel Index kanálu
+ */
+void EMGAcquisition::startConversion(uint8_t channel)
+{
+    currentChannel = channel;
+#if defined(ARDUINO_ARCH_MEGAAVR)
+    ADC0.MUXPOS = (adcChannels[channel] << ADC_MUXPOS_gp);
+    ADC0.COMMAND = ADC_STCONV_bm;
+#else
+    onConversion(analogRead(pins[channel]));
+#endif
+}
+
+/**
+ * @brief Obsluha přerušení časovače (neveřejné použití)
+ */
+void EMGAcquisition::onTimer()
+{
+    if (converting)
+    {
+        lateCount++;
+        return;
+    }
+    if (channelCount == 0)
+        return;
+
+    converting = true;
+#if defined(ARDUINO_ARCH_MEGAAVR)
+    sequenceUs = micros();
+    ADC0.INTFLAGS = ADC_RESRDY_bm;
+    ADC0.INTCTRL = ADC_RESRDY_bm;
+#endif
+    startConversion(0);
+}
+
+/**
+ * @brief Obsluha přerušení dokončeného převodu (neveřejné použití)
+ * @param value Výsledek převodu
+ */
+void EMGAcquisition::onConversion(uint16_t value)
+{
+    uint8_t channel = currentChannel;
+    pending.raw[channel] = value;
+
+    if (++channel < channelCount)
+    {
+        startConversion(channel);
+        return;
+    }
+    completeFrame();
+}
+
+/**
+ * @brief Dokončí snímek a vloží ho do bufferu
+ */
+void EMGAcquisition::completeFrame()
+{
+#if defined(ARDUINO_ARCH_MEGAAVR)
+    ADC0.INTCTRL = 0;
+#endif
+    converting = false;
+
+    if (buffer.push(pending))
+    {
+        frameCount++;
+        newestFrameUs = sequenceUs;
+    }
+    else
+        overrunCount++;
+}
+
+/**
+ * @brief Vyjme nejstarší snímek z bufferu
+ * @param frame Reference pro vyjmutý snímek
+ * @return False pokud žádný snímek nečeká
+ */
+bool EMGAcquisition::read(EMGFrame &frame)
+{
+    return buffer.pop(frame);
+}
+
+/**
+ * @brief Vrací počet snímků čekajících ve bufferu
+ */
+uint8_t EMGAcquisition::available() const
+{
+    return buffer.available();
+}
+
+/**
+ * @brief Vrací čas pořízení snímku naposledy vyjmutého funkcí read (micros)
+ */
+uint32_t EMGAcquisition::getReadFrameTime() const
+{
+    noInterrupts();
+    uint32_t newest = newestFrameUs;
+    uint8_t waiting = buffer.available();
+    interrupts();
+
+    // Za vyjmutým snímkem čeká ve bufferu waiting novějších snímků
+    return newest - (uint32_t)waiting * periodUs;
+}
+
+/**
+ * @brief Zahodí všechny čekající snímky
+ */
+void EMGAcquisition::discard()
+{
+    buffer.clear();
+}
+
+/**
+ * @brief Vrací počet vzorkovaných kanálů
+ */
+uint8_t EMGAcquisition::getChannelCount() const
+{
+    return channelCount;
+}
+
+/**
+ * @brief Vrací celkový počet uložených snímků
+ */
+uint32_t EMGAcquisition::getFrameCount() const
+{
+    return readCounter(frameCount);
+}
+
+/**
+ * @brief Vrací počet snímků zahozených kvůli plnému bufferu
+ */
+uint32_t EMGAcquisition::getOverrunCount() const
+{
+    return readCounter(overrunCount);
+}
+
+/**
+ * @brief Vrací počet period, kdy se sekvence převodů nestihla dokončit
+ */
+uint32_t EMGAcquisition::getLateCount() const
+{
+    return readCounter(lateCount);
+}
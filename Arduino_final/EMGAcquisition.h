@@ -0,0 +1,136 @@
+#ifndef EMG_ACQUISITION_H
+#define EMG_ACQUISITION_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "RingBuffer.h"
+
+/**
+ * @struct EMGFrame
+ * @brief Jeden vzorek ze všech vzorkovaných kanálů ve stejném okamžiku
+ */
+struct EMGFrame
+{
+    uint16_t raw[maxSensors]; // Surové hodnoty ADC jednotlivých kanálů
+};
+
+/**
+ * @class EMGAcquisition
+ * @brief Vzorkování EMG kanálů řízené časovačem do kruhového bufferu
+ *
+ * Na ATmega4809 spouští časovač TCB2 s přesnou periodou převod prvního kanálu,
+ * další kanály se řetězí z přerušení ADC0 RESRDY a kompletní snímek se vloží do
+ * bufferu. Hlavní smyčka tak vzorkovací takt nijak neovlivňuje. Na ostatních
+ * platformách se vzorkuje softwarově v poll() podle micros().
+ */
+class EMGAcquisition
+{
+private:
+    RingBuffer<EMGFrame, acquisitionBufferFrames> buffer; // Snímky čekající na zpracování
+    EMGFrame pending;                                     // Právě vzorkovaný snímek
+    uint8_t pins[maxSensors];                             // Arduino piny kanálů
+    uint8_t adcChannels[maxSensors];                      // Odpovídající vstupy ADC0
+    uint8_t channelCount = 0;                             // Počet vzorkovaných kanálů
+    volatile uint8_t currentChannel = 0;                  // Kanál, jehož převod právě běží
+    volatile bool converting = false;                     // Probíhá sekvence převodů
+    volatile uint32_t frameCount = 0;                     // Počet uložených snímků
+    volatile uint32_t overrunCount = 0;                   // Počet zahozených snímků (plný buffer)
+    volatile uint32_t lateCount = 0;                      // Počet period, kdy předchozí sekvence neskončila
+    volatile uint32_t sequenceUs = 0;                     // Začátek právě běžící sekvence převodů (micros)
+    volatile uint32_t newestFrameUs = 0;                  // Začátek sekvence posledního uloženého snímku (micros)
+    bool running = false;                                 // Příznak spuštěného vzorkování
+    unsigned long periodUs = 1000;                        // Perioda vzorkování v µs
+    unsigned long nextSampleUs = 0;                       // Čas dalšího softwarového vzorku
+
+    /**
+     * @brief Dokončí snímek a vloží ho do bufferu
+     */
+    void completeFrame();
+
+    /**
+     * @brief Spustí převod na zvoleném kanálu
+     * @param channel Index kanálu
+     */
+    void startConversion(uint8_t channel);
+
+public:
+    /**
+     * @brief Spustí periodické vzorkování
+     * @param channels Počet vzorkovaných kanálů z emgPins (nejvýše maxSensors)
+     * @param sampleRateHz Vzorkovací frekvence v Hz
+     */
+    void begin(uint8_t channels, uint16_t sampleRateHz);
+
+    /**
+     * @brief Zastaví vzorkování
+     */
+    void end();
+
+    /**
+     * @brief Softwarové vzorkování pro platformy bez časovače TCB (volat v loop)
+     */
+    void poll();
+
+    /**
+     * @brief Vyjme nejstarší snímek z bufferu
+     * @param frame Reference pro vyjmutý snímek
+     * @return False pokud žádný snímek nečeká
+     */
+    bool read(EMGFrame &frame);
+
+    /**
+     * @brief Vrací počet snímků čekajících ve bufferu
+     */
+    uint8_t available() const;
+
+    /**
+     * @brief Vrací čas pořízení snímku naposledy vyjmutého funkcí read (micros)
+     *
+     * Odvozuje se od nejnovějšího snímku a počtu snímků za ním, které jsou
+     * od sebe přesně jednu periodu časovače.
+     */
+    uint32_t getReadFrameTime() const;
+
+    /**
+     * @brief Zahodí všechny čekající snímky
+     */
+    void discard();
+
+    /**
+     * @brief Vrací počet vzorkovaných kanálů
+     */
+    uint8_t getChannelCount() const;
+
+    /**
+     * @brief Vrací celkový počet uložených snímků
+     */
+    uint32_t getFrameCount() const;
+
+    /**
+     * @brief Vrací počet snímků zahozených kvůli plnému bufferu
+     */
+    uint32_t getOverrunCount() const;
+
+    /**
+     * @brief Vrací počet period, kdy se sekvence převodů nestihla dokončit
+     */
+    uint32_t getLateCount() const;
+
+    /**
+     * @brief Obsluha přerušení časovače (neveřejné použití)
+     */
+    void onTimer();
+
+    /**
+     * @brief Obsluha přerušení dokončeného převodu (neveřejné použití)
+     * @param value Výsledek převodu
+     */
+    void onConversion(uint16_t value);
+};
+
+/**
+ * @brief Globální instance vzorkování (obsluhy přerušení na ni odkazují)
+ */
+extern EMGAcquisition emgAcquisition;
+
+#endif // EMG_ACQUISITION_H
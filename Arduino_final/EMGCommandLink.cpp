@@ -0,0 +1,147 @@
+#include "EMGCommandLink.h"
+
+/**
+ * @brief Zapne odesílání příkazů na zadanou adresu a vynuluje čítače
+ * @param ip Adresa příjemce
+ * @param port UDP port příjemce
+ * @param copies Počet kopií každého příkazu (1 až udpMaxRepeats)
+ * @return False pokud jsou parametry mimo rozsah nebo nejde otevřít socket
+ */
+bool EMGCommandLink::start(const IPAddress &ip, uint16_t port, uint8_t copies)
+{
+    if (port == 0 || copies == 0 || copies > udpMaxRepeats)
+        return false;
+
+    // Socket zůstává otevřený i po vypnutí, modul NINA má socketů málo
+    if (!socketOpen)
+    {
+        if (!udp.begin(udpCommandPort))
+            return false;
+        socketOpen = true;
+    }
+
+    target = ip;
+    targetPort = port;
+    repeats = copies;
+    copiesSent = copies; // Žádný rozpracovaný příkaz
+    sequence = 0;
+    commandsSent = 0;
+    datagramsSent = 0;
+    sendFailures = 0;
+    enabled = true;
+    return true;
+}
+
+/**
+ * @brief Vypne odesílání (nedoručené kopie se zahodí)
+ */
+void EMGCommandLink::stop()
+{
+    enabled = false;
+    copiesSent = repeats;
+}
+
+/**
+ * @brief Vrací příznak zapnutého odesílání
+ */
+bool EMGCommandLink::isEnabled() const
+{
+    return enabled;
+}
+
+/**
+ * @brief Odešle první kopii příkazu, ostatní odejdou z poll()
+ * @param command Kód příkazu
+ */
+void EMGCommandLink::send(uint8_t command)
+{
+    if (!enabled)
+        return;
+
+    // Nový příkaz má přednost před zbylými kopiemi předchozího
+    uint32_t now = micros();
+    datagram[0] = commandDatagramSync;
+    datagram[2] = repeats;
+    datagram[3] = command;
+    datagram[4] = sequence & 0xFF;
+    datagram[5] = sequence >> 8;
+    for (uint8_t i = 0; i < 4; i++)
+        datagram[6 + i] = now >> (8 * i);
+
+    sequence++;
+    commandsSent++;
+    copiesSent = 0;
+    sendCopy();
+}
+
+/**
+ * @brief Odešle další kopii, pokud uplynul interval opakování (volat v každém průchodu)
+ */
+void EMGCommandLink::poll()
+{
+    if (!enabled || copiesSent >= repeats)
+        return;
+    if (micros() - lastCopyTime >= udpRepeatIntervalUs)
+        sendCopy();
+}
+
+/**
+ * @brief Odešle další kopii datagramu a zapíše do ní čas odeslání
+ */
+void EMGCommandLink::sendCopy()
+{
+    uint32_t now = micros();
+    datagram[1] = copiesSent;
+    for (uint8_t i = 0; i < 4; i++)
+        datagram[10 + i] = now >> (8 * i);
+
+    bool ok = udp.beginPacket(target, targetPort) && udp.write(datagram, sizeof(datagram)) == sizeof(datagram) &&
+              udp.endPacket();
+    if (ok)
+        datagramsSent++;
+    else
+        sendFailures++;
+
+    copiesSent++;
+    lastCopyTime = now;
+}
+
+/**
+ * @brief Vrací počet kopií každého příkazu
+ */
+uint8_t EMGCommandLink::getRepeats() const
+{
+    return repeats;
+}
+
+/**
+ * @brief Vrací UDP port příjemce
+ */
+uint16_t EMGCommandLink::getTargetPort() const
+{
+    return targetPort;
+}
+
+/**
+ * @brief Vrací počet odeslaných příkazů
+ */
+uint32_t EMGCommandLink::getCommandsSent() const
+{
+    return commandsSent;
+}
+
+/**
+ * @brief Vrací počet odeslaných datagramů (včetně kopií)
+ */
+uint32_t EMGCommandLink::getDatagramsSent() const
+{
+    return datagramsSent;
+}
+
+/**
+ * @brief Vrací počet datagramů, které modul odmítl odeslat
+ */
+uint32_t EMGCommandLink::getSendFailures() const
+{
+    return sendFailures;
+}
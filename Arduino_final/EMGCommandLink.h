@@ -0,0 +1,110 @@
+#ifndef EMG_COMMAND_LINK_H
+#define EMG_COMMAND_LINK_H
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include "Config.h"
+
+/**
+ * @brief Formát datagramu příkazu (little-endian)
+ *
+ *  0  uint8   synchronizační bajt 0xC3
+ *  1  uint8   index kopie (0 až opakování - 1)
+ *  2  uint8   počet opakování
+ *  3  uint8   kód příkazu (stejný jako textový příkaz přes TCP)
+ *  4  uint16  pořadové číslo příkazu (všechny kopie stejné)
+ *  6  uint32  čas vzniku příkazu v µs (micros zařízení, všechny kopie stejné)
+ * 10  uint32  čas odeslání této kopie v µs
+ */
+const uint8_t commandDatagramSync = 0xC3; // Synchronizační bajt datagramu
+const uint8_t commandDatagramBytes = 14;  // Délka datagramu
+
+/**
+ * @class EMGCommandLink
+ * @brief Odesílání příkazů robotovi přes UDP s pořadovým číslem a opakováním
+ *
+ * Doplňuje textový příkaz přes TCP. Datagram nečeká na potvrzení ani na
+ * opakování ztraceného segmentu, ztrátu vyrovnávají kopie rozložené
+ * po udpRepeatIntervalUs. Příjemce kopie rozliší podle pořadového čísla
+ * a ze stejného čísla pozná i ztracené příkazy.
+ */
+class EMGCommandLink
+{
+private:
+    WiFiUDP udp;                            // UDP socket zařízení
+    IPAddress target;                       // Adresa příjemce (robota)
+    uint16_t targetPort = 0;                // Port příjemce
+    uint8_t repeats = 1;                    // Počet kopií každého příkazu
+    bool enabled = false;                   // Odesílání je zapnuté
+    bool socketOpen = false;                // Socket je otevřený (udp.begin)
+    uint8_t datagram[commandDatagramBytes]; // Datagram posledního příkazu
+    uint8_t copiesSent = 0;                 // Odeslané kopie posledního příkazu
+    unsigned long lastCopyTime = 0;         // Čas odeslání poslední kopie (micros)
+    uint16_t sequence = 0;                  // Pořadové číslo dalšího příkazu
+    uint32_t commandsSent = 0;              // Počet odeslaných příkazů
+    uint32_t datagramsSent = 0;             // Počet odeslaných datagramů (včetně kopií)
+    uint32_t sendFailures = 0;              // Počet datagramů, které modul odmítl
+
+    /**
+     * @brief Odešle další kopii datagramu a zapíše do ní čas odeslání
+     */
+    void sendCopy();
+
+public:
+    /**
+     * @brief Zapne odesílání příkazů na zadanou adresu a vynuluje čítače
+     * @param ip Adresa příjemce
+     * @param port UDP port příjemce
+     * @param copies Počet kopií každého příkazu (1 až udpMaxRepeats)
+     * @return False pokud jsou parametry mimo rozsah nebo nejde otevřít socket
+     */
+    bool start(const IPAddress &ip, uint16_t port, uint8_t copies);
+
+    /**
+     * @brief Vypne odesílání (nedoručené kopie se zahodí)
+     */
+    void stop();
+
+    /**
+     * @brief Vrací příznak zapnutého odesílání
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Odešle první kopii příkazu, ostatní odejdou z poll()
+     * @param command Kód příkazu
+     */
+    void send(uint8_t command);
+
+    /**
+     * @brief Odešle další kopii, pokud uplynul interval opakování (volat v každém průchodu)
+     */
+    void poll();
+
+    /**
+     * @brief Vrací počet kopií každého příkazu
+     */
+    uint8_t getRepeats() const;
+
+    /**
+     * @brief Vrací UDP port příjemce
+     */
+    uint16_t getTargetPort() const;
+
+    /**
+     * @brief Vrací počet odeslaných příkazů
+     */
+    uint32_t getCommandsSent() const;
+
+    /**
+     * @brief Vrací počet odeslaných datagramů (včetně kopií)
+     */
+    uint32_t getDatagramsSent() const;
+
+    /**
+     * @brief Vrací počet datagramů, které modul odmítl odeslat
+     */
+    uint32_t getSendFailures() const;
+};
+
+#endif // EMG_COMMAND_LINK_H
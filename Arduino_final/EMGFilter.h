@@ -0,0 +1,429 @@
+#ifndef EMG_FILTER_H
+#define EMG_FILTER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @file EMGFilter.h
+ * @brief Kaskády biquad filtrů v pevné řádové čárce skládané při překladu
+ *
+ * Koeficienty se počítají constexpr funkcemi (RBJ Audio EQ Cookbook) přímo
+ * z parametrů šablony a do programu se dostanou jen jako celočíselné konstanty
+ * ve formátu Q14. Vzorky uvnitř řetězce jsou v jednotkách ADC ve formátu Q3
+ * (1 LSB ADC = 8). Každý kanál má vlastní typ řetězce, volání se tedy
+ * rozbalí při překladu bez virtuálních metod.
+ *
+ * Každý stupeň deklaruje ruční odhad počtu cyklů na ATmega4809 (avr-gcc -Os,
+ * spočtený z instrukcí, ne změřený). Součet za všechny kanály se při překladu
+ * porovná s rozpočtem CPU, takže kontrola hlídá jen odhady. Skutečnou dobu
+ * řetězců měří EMGSensorBank na desce (EMGFilterProbe, GET /status) a
+ * emg_replay_bench --filters na PC.
+ */
+
+/**
+ * @brief Počet desetinných bitů koeficientů
+ */
+const uint8_t filterCoeffShift = 14;
+
+/**
+ * @brief Počet desetinných bitů vzorků uvnitř řetězce
+ */
+const uint8_t filterSampleShift = 3;
+
+/**
+ * @brief Taylorova řada sinu pro |x| <= pi (constexpr, C++11)
+ */
+constexpr double filterSinSeries(double term, double x2, int k)
+{
+    return k > 12 ? term : term + filterSinSeries(-term * x2 / ((2.0 * k) * (2.0 * k + 1.0)), x2, k + 1);
+}
+
+/**
+ * @brief Sinus vyhodnocený při překladu
+ */
+constexpr double filterSin(double x)
+{
+    return filterSinSeries(x, x * x, 1);
+}
+
+/**
+ * @brief Kosinus vyhodnocený při překladu
+ */
+constexpr double filterCos(double x)
+{
+    return filterSin(3.14159265358979323846 / 2.0 - x);
+}
+
+/**
+ * @brief Normovaná úhlová frekvence w0 = 2 pi f0 / fs
+ */
+constexpr double filterOmega(double sampleRateHz, double cutoffHz)
+{
+    return 2.0 * 3.14159265358979323846 * cutoffHz / sampleRateHz;
+}
+
+/**
+ * @brief Parametr alpha = sin(w0) / (2 Q)
+ */
+constexpr double filterAlpha(double omega, double q)
+{
+    return filterSin(omega) / (2.0 * q);
+}
+
+/**
+ * @brief Zaokrouhlí koeficient do formátu Q14
+ */
+constexpr int32_t filterQuantize(double value)
+{
+    return (int32_t)(value * (1L << filterCoeffShift) + (value >= 0 ? 0.5 : -0.5));
+}
+
+/**
+ * @struct BiquadFeedback
+ * @brief Společná zpětnovazební část (a1, a2) normovaná a0 = 1 + alpha
+ * @tparam SampleRateHz Vzorkovací frekvence v Hz
+ * @tparam CutoffDeciHz Mezní (střední) frekvence v desetinách Hz
+ * @tparam QMilli Činitel jakosti v tisícinách
+ */
+template <uint16_t SampleRateHz, uint16_t CutoffDeciHz, uint16_t QMilli>
+struct BiquadFeedback
+{
+    static constexpr double omega = filterOmega(SampleRateHz, CutoffDeciHz / 10.0);
+    static constexpr double alpha = filterAlpha(omega, QMilli / 1000.0);
+    static constexpr double a0 = 1.0 + alpha;
+
+    static const int32_t a1 = filterQuantize(-2.0 * filterCos(omega) / a0);
+    static const int32_t a2 = filterQuantize((1.0 - alpha) / a0);
+
+    static_assert(CutoffDeciHz < SampleRateHz * 5U, "Mezni frekvence musi byt pod Nyquistovou");
+};
+
+/**
+ * @struct LowPassDesign
+ * @brief Dolní propust 2. řádu, koeficienty b dorovnané na přesný zisk 1 na DC
+ */
+template <uint16_t SampleRateHz, uint16_t CutoffDeciHz, uint16_t QMilli = 707>
+struct LowPassDesign : BiquadFeedback<SampleRateHz, CutoffDeciHz, QMilli>
+{
+    typedef BiquadFeedback<SampleRateHz, CutoffDeciHz, QMilli> Feedback;
+    static const int32_t sum = (1L << filterCoeffShift) + Feedback::a1 + Feedback::a2;
+    static const int32_t b0 = (sum + 2) / 4;
+    static const int32_t b1 = sum - 2 * b0;
+    static const int32_t b2 = b0;
+};
+
+/**
+ * @struct HighPassDesign
+ * @brief Horní propust 2. řádu, koeficienty b dorovnané na nulový zisk na DC
+ */
+template <uint16_t SampleRateHz, uint16_t CutoffDeciHz, uint16_t QMilli = 707>
+struct HighPassDesign : BiquadFeedback<SampleRateHz, CutoffDeciHz, QMilli>
+{
+    typedef BiquadFeedback<SampleRateHz, CutoffDeciHz, QMilli> Feedback;
+    static const int32_t b0 = filterQuantize((1.0 + filterCos(Feedback::omega)) / 2.0 / Feedback::a0);
+    static const int32_t b1 = -2 * b0;
+    static const int32_t b2 = b0;
+};
+
+/**
+ * @struct NotchDesign
+ * @brief Pásmová zádrž (např. síťový brum 50 Hz)
+ */
+template <uint16_t SampleRateHz, uint16_t CenterDeciHz, uint16_t QMilli>
+struct NotchDesign : BiquadFeedback<SampleRateHz, CenterDeciHz, QMilli>
+{
+    typedef BiquadFeedback<SampleRateHz, CenterDeciHz, QMilli> Feedback;
+    static const int32_t b0 = filterQuantize(1.0 / Feedback::a0);
+    static const int32_t b1 = Feedback::a1;
+    static const int32_t b2 = b0;
+};
+
+/**
+ * @class Biquad
+ * @brief Jeden biquad stupeň (Direct Form I) s přenosem zbytku po zaokrouhlení
+ *
+ * Zbytek po posunu o 14 bitů se přičítá k dalšímu vzorku, takže ani propusti
+ * s nízkou mezní frekvencí nezamrznou v mrtvém pásmu.
+ *
+ * @tparam Design Návrh s konstantami b0, b1, b2, a1, a2 ve formátu Q14
+ */
+template <class Design>
+class Biquad
+{
+    static_assert(Design::b0 >= -32768 && Design::b0 <= 32767, "Koeficient b0 mimo rozsah Q14");
+    static_assert(Design::b1 >= -32768 && Design::b1 <= 32767, "Koeficient b1 mimo rozsah Q14");
+    static_assert(Design::b2 >= -32768 && Design::b2 <= 32767, "Koeficient b2 mimo rozsah Q14");
+    static_assert(Design::a1 >= -32768 && Design::a1 <= 32767, "Koeficient a1 mimo rozsah Q14");
+    static_assert(Design::a2 >= -32768 && Design::a2 <= 32767, "Koeficient a2 mimo rozsah Q14");
+
+private:
+    int16_t x1 = 0, x2 = 0; // Předchozí vstupy
+    int16_t y1 = 0, y2 = 0; // Předchozí výstupy
+    uint16_t error = 0;     // Zbytek po posledním zaokrouhlení
+
+public:
+    static const uint16_t cycles = 230; // Odhad cyklů AVR na vzorek (5x MUL 16x16, akumulace 32 bit)
+
+    /**
+     * @brief Nastaví ustálený stav pro konstantní vstup (bez přechodového jevu)
+     * @param input Konstantní vstupní hodnota
+     * @return Ustálená výstupní hodnota
+     */
+    int16_t reset(int16_t input)
+    {
+        const int32_t numerator = Design::b0 + Design::b1 + Design::b2;
+        const int32_t denominator = (1L << filterCoeffShift) + Design::a1 + Design::a2;
+        int16_t output = (int16_t)((int32_t)input * numerator / denominator);
+        x1 = x2 = input;
+        y1 = y2 = output;
+        error = 0;
+        return output;
+    }
+
+    /**
+     * @brief Zpracuje jeden vzorek
+     * @param x Vstupní vzorek
+     * @return Výstupní vzorek
+     */
+    int16_t process(int16_t x)
+    {
+        int32_t acc = (int32_t)Design::b0 * x + (int32_t)Design::b1 * x1 + (int32_t)Design::b2 * x2 -
+                      (int32_t)Design::a1 * y1 - (int32_t)Design::a2 * y2 + error;
+        error = (uint16_t)(acc & ((1L << filterCoeffShift) - 1));
+        acc >>= filterCoeffShift;
+        if (acc > 32767)
+            acc = 32767;
+        else if (acc < -32768)
+            acc = -32768;
+
+        x2 = x1;
+        x1 = x;
+        y2 = y1;
+        y1 = (int16_t)acc;
+        return y1;
+    }
+};
+
+/**
+ * @class Rectifier
+ * @brief Dvoucestné usměrnění (absolutní hodnota)
+ */
+class Rectifier
+{
+public:
+    static const uint16_t cycles = 8; // Odhad cyklů AVR na vzorek
+
+    int16_t reset(int16_t input) { return input < 0 ? -input : input; }
+    int16_t process(int16_t x) { return x < 0 ? -x : x; }
+};
+
+/**
+ * @class Teager
+ * @brief Teager-Kaiserův energetický operátor ψ[n] = x[n]² - x[n-1]·x[n+1]
+ *
+ * Zvýrazní krátké špičky motorických jednotek proti pomalým složkám a šumu,
+ * nástup kontrakce je pak ostřejší. Výstup je zpožděn o jeden vzorek, je
+ * kladný (absolutní hodnota) a nahrazuje usměrňovač.
+ * @tparam Shift Posun výsledku doprava (ψ je ve formátu Q6, výstup se saturuje na int16)
+ */
+template <uint8_t Shift>
+class Teager
+{
+private:
+    int16_t x1 = 0; // Předchozí vzorek
+    int16_t x2 = 0; // Vzorek před dvěma kroky
+
+public:
+    static const uint16_t cycles = 140; // Odhad cyklů AVR na vzorek (dvě násobení 16x16)
+
+    int16_t reset(int16_t input)
+    {
+        x1 = x2 = input;
+        return 0;
+    }
+
+    int16_t process(int16_t x)
+    {
+        int32_t psi = (int32_t)x1 * x1 - (int32_t)x * x2;
+        x2 = x1;
+        x1 = x;
+
+        if (psi < 0)
+            psi = -psi;
+        psi >>= Shift;
+        return psi > 32767 ? 32767 : (int16_t)psi;
+    }
+};
+
+/**
+ * @class FixedOffset
+ * @brief Odečtení pevného stejnosměrného offsetu (původní Vref / 3)
+ * @tparam OffsetCounts Offset v jednotkách ADC
+ */
+template <int16_t OffsetCounts>
+class FixedOffset
+{
+public:
+    static const uint16_t cycles = 6; // Odhad cyklů AVR na vzorek
+
+    int16_t reset(int16_t input) { return input - (OffsetCounts << filterSampleShift); }
+    int16_t process(int16_t x) { return x - (OffsetCounts << filterSampleShift); }
+};
+
+/**
+ * @class FilterChain
+ * @brief Sériové zapojení stupňů, typ celého řetězce je znám při překladu
+ * @tparam Stages Stupně v pořadí zpracování
+ */
+template <class... Stages>
+class FilterChain;
+
+template <>
+class FilterChain<>
+{
+public:
+    static const uint16_t cycles = 0;
+
+    int16_t reset(int16_t input) { return input; }
+    int16_t process(int16_t x) { return x; }
+};
+
+template <class First, class... Rest>
+class FilterChain<First, Rest...>
+{
+private:
+    First stage;               // První stupeň
+    FilterChain<Rest...> rest; // Zbytek řetězce
+
+public:
+    static const uint16_t cycles = First::cycles + FilterChain<Rest...>::cycles;
+
+    /**
+     * @brief Nastaví všechny stupně do ustáleného stavu pro konstantní vstup
+     * @param input Konstantní vstupní hodnota (Q3)
+     * @return Ustálená výstupní hodnota řetězce
+     */
+    int16_t reset(int16_t input) { return rest.reset(stage.reset(input)); }
+
+    /**
+     * @brief Zpracuje jeden vzorek celým řetězcem
+     * @param x Vstupní vzorek (Q3)
+     * @return Výstupní vzorek (Q3)
+     */
+    int16_t process(int16_t x) { return rest.process(stage.process(x)); }
+};
+
+/**
+ * @class FilterBank
+ * @brief Sada řetězců, i-tý řetězec patří i-tému kanálu
+ * @tparam Chains Typy řetězců jednotlivých kanálů
+ */
+template <class... Chains>
+class FilterBank;
+
+template <>
+class FilterBank<>
+{
+public:
+    static const uint32_t cycles = 0;
+    static const uint8_t channels = 0;
+
+    static uint32_t cyclesFor(uint8_t) { return 0; }
+
+    void reset(const uint16_t *, uint8_t) {}
+    void process(const uint16_t *, int16_t *, uint8_t) {}
+};
+
+template <class Chain, class... Rest>
+class FilterBank<Chain, Rest...>
+{
+private:
+    Chain chain;               // Řetězec tohoto kanálu
+    FilterBank<Rest...> rest;  // Řetězce dalších kanálů
+
+public:
+    static const uint32_t cycles = Chain::cycles + FilterBank<Rest...>::cycles;
+    static const uint8_t channels = 1 + FilterBank<Rest...>::channels;
+
+    /**
+     * @brief Odhad cyklů prvních count řetězců (používané kanály)
+     */
+    static uint32_t cyclesFor(uint8_t count)
+    {
+        return count == 0 ? 0 : Chain::cycles + FilterBank<Rest...>::cyclesFor(count - 1);
+    }
+
+    /**
+     * @brief Nastaví řetězce do ustáleného stavu podle aktuálních hodnot ADC
+     * @param raw Surové hodnoty ADC jednotlivých kanálů
+     * @param count Počet používaných kanálů
+     */
+    void reset(const uint16_t *raw, uint8_t count)
+    {
+        if (count == 0)
+            return;
+        chain.reset((int16_t)(raw[0] << filterSampleShift));
+        rest.reset(raw + 1, count - 1);
+    }
+
+    /**
+     * @brief Zpracuje jeden snímek všemi řetězci najednou
+     * @param raw Surové hodnoty ADC jednotlivých kanálů
+     * @param out Výstupy řetězců (Q3)
+     * @param count Počet používaných kanálů
+     */
+    void process(const uint16_t *raw, int16_t *out, uint8_t count)
+    {
+        if (count == 0)
+            return;
+        out[0] = chain.process((int16_t)(raw[0] << filterSampleShift));
+        rest.process(raw + 1, out + 1, count - 1);
+    }
+};
+
+/**
+ * @brief Původní zpracování: odečtení Vref / 3 a usměrnění, vyhlazení dělá EMA
+ */
+typedef FilterChain<FixedOffset<341>, Rectifier> EMGLegacyChain;
+
+/**
+ * @brief Horní propust 20 Hz (DC a drift), zádrž 50 Hz, usměrnění a dolní propust 10 Hz
+ */
+typedef FilterChain<Biquad<HighPassDesign<refreshRateHz, 200> >,
+                    Biquad<NotchDesign<refreshRateHz, 500, 5000> >,
+                    Rectifier,
+                    Biquad<LowPassDesign<refreshRateHz, 100> > >
+    EMGBandNotchChain;
+
+/**
+ * @brief Jako EMGBandNotchChain, místo usměrnění Teager-Kaiserův operátor
+ */
+typedef FilterChain<Biquad<HighPassDesign<refreshRateHz, 200> >,
+                    Biquad<NotchDesign<refreshRateHz, 500, 5000> >,
+                    Teager<7>,
+                    Biquad<LowPassDesign<refreshRateHz, 100> > >
+    EMGTeagerChain;
+
+#ifdef EMG_TKEO_PRESTAGE
+typedef EMGTeagerChain EMGDefaultChain;
+#else
+typedef EMGBandNotchChain EMGDefaultChain;
+#endif
+
+/**
+ * @brief Volba řetězce pro jednotlivé kanály (pořadí podle emgPins)
+ */
+typedef EMGDefaultChain EMGChannel0Chain;
+typedef EMGDefaultChain EMGChannel1Chain;
+typedef EMGDefaultChain EMGChannel2Chain;
+typedef EMGDefaultChain EMGChannel3Chain;
+
+typedef FilterBank<EMGChannel0Chain, EMGChannel1Chain, EMGChannel2Chain, EMGChannel3Chain> EMGChannelFilters;
+
+static_assert(EMGChannelFilters::channels == maxSensors, "Kazdy kanal musi mit svuj filtracni retezec");
+// Hlídá jen ruční odhady cyklů, změřenou dobu vrací EMGSensorBank::getFilterProbe
+static_assert(EMGChannelFilters::cycles * (uint32_t)refreshRateHz <= F_CPU / 100 * filterCpuBudgetPercent,
+              "Filtrace vsech kanalu se nevejde do rozpoctu CPU");
+
+#endif // EMG_FILTER_H
@@ -0,0 +1,947 @@
+#include "EMGSensorBank.h"
+#include "EEPROMManager.h"
+#include "Utils.h"
+#include <stddef.h>
+
+static const uint8_t calibrationRecordMagic = 0xEC; // Značka záznamu kalibrace v EEPROM
+#ifdef EMG_FLOAT_PIPELINE
+static const uint8_t calibrationRecordVersion = 0x81; // Verze záznamu, horní bit = float výpočet
+static const float calibrationScale = 1000000.0;      // Obálka ve voltech se do kalibrace sčítá v µV (celá čísla)
+#else
+static const uint8_t calibrationRecordVersion = 0x01; // Verze záznamu, horní bit = float výpočet
+#endif
+
+#ifdef EMG_HAS_WINDOW
+static const uint16_t windowSampleMax = 8191; // Strop vzorku v okně, 64 čtverců se vejde do uint32
+#endif
+
+#ifndef EMG_FLOAT_PIPELINE
+static const int32_t trackedDeviationMax = 4095;                                    // Strop odchylky od klidu, 64 čtverců se vejde do uint32
+static const float flatVarianceFloor = 16384.0;                                     // Nejmenší klidový rozptyl pro test plochosti, (0.5 LSB)^2 v Q16
+
+/**
+ * @brief Odmocnina z float hodnoty omezené na rozsah uint32
+ * @param value Nezáporná hodnota
+ * @return Celočíselná odmocnina
+ */
+static int32_t isqrtClamped(float value)
+{
+    return isqrt32(value >= 4294967295.0 ? 0xFFFFFFFFUL : (uint32_t)value);
+}
+
+/**
+ * @brief Převede hodnotu v ADC jednotkách Q8 na mikrovolty (pro výpisy)
+ * @param valueQ8 Hodnota v ADC jednotkách ve formátu Q8
+ * @return Hodnota v µV
+ */
+static long q8ToMicrovolts(int32_t valueQ8)
+{
+    return (long)((int64_t)valueQ8 * 5000000L / (1023L * 256L));
+}
+#endif
+
+/**
+ * @brief Konstruktor sady kanálů
+ */
+EMGSensorBank::EMGSensorBank() : mode(envelopeMode)
+{
+#ifndef EMG_HAS_WINDOW
+    mode = EMG_ENVELOPE_EMA; // Okenní režimy nejsou přeloženy
+#endif
+    begin(0);
+}
+
+/**
+ * @brief Nastaví počet kanálů a vynuluje jejich stav i prahy
+ * @param channels Počet kanálů (nejvýše maxSensors)
+ */
+void EMGSensorBank::begin(uint8_t channels)
+{
+    channelCount = channels > maxSensors ? maxSensors : channels;
+    activeMask = 0;
+    onsetMask = 0;
+    armedMask = 0;
+
+    // Doby z Config převedené na vzorky, aspoň jeden vzorek
+    uint32_t onsetSamples = (uint32_t)onsetDebounceMs * refreshRateHz / 1000;
+    uint32_t offsetSamples = (uint32_t)offsetDebounceMs * refreshRateHz / 1000;
+    onsetDebounce = onsetSamples < 1 ? 1 : onsetSamples > 255 ? 255 : onsetSamples;
+    offsetDebounce = offsetSamples < 1 ? 1 : offsetSamples > 255 ? 255 : offsetSamples;
+    uint32_t holdoffSamples = (uint32_t)restHoldoffMs * refreshRateHz / 1000;
+    restHoldoff = holdoffSamples > 0xFFFF ? 0xFFFF : holdoffSamples;
+    uint32_t limitSamples = (uint32_t)activityLimitMs * refreshRateHz / 1000;
+    activityLimit = limitSamples > 0xFFFF ? 0xFFFF : limitSamples;
+
+    calibrated = false;
+    refreshCountdown = 0;
+    refreshChannel = 0;
+    baselineFaultMask = 0;
+    baselineFaults = 0;
+
+#ifdef EMG_HAS_WINDOW
+    // Nejdelší okno, při kterém se okna všech kanálů vejdou do společného bufferu
+    windowLog2 = envelopeWindowLog2;
+    while (windowLog2 > 0 && ((uint16_t)channelCount << windowLog2) > envelopeWindowPoolSamples)
+        windowLog2--;
+#endif
+    resetEnvelopes();
+    for (uint8_t i = 0; i < maxSensors; i++)
+    {
+#ifdef EMG_FLOAT_PIPELINE
+        thresholdUpper[i] = 0.2;
+        thresholdLower[i] = 0.05;
+        mean[i] = 0.0;
+        noiseVariance[i] = 0.0;
+#else
+        thresholdUpper[i] = 10476; // 0.2 V
+        thresholdLower[i] = 2619;  // 0.05 V
+        mean[i] = 0;
+        restSum[i] = 0;
+        restSquareSum[i] = 0;
+        restSamples[i] = 0;
+        trackedMean[i] = 0.0;
+        trackedVariance[i] = 0.0;
+#endif
+        calibrationStats[i].reset();
+        restCountdown[i] = 0;
+        activeRun[i] = 0;
+        debounceRun[i] = 0;
+        onsetSample[i] = 0;
+    }
+    resetOnsetStats();
+
+#ifndef EMG_FLOAT_PIPELINE
+    filtersSeeded = false;
+#endif
+}
+
+/**
+ * @brief Vrací počet používaných kanálů
+ */
+uint8_t EMGSensorBank::getChannelCount() const
+{
+    return channelCount;
+}
+
+/**
+ * @brief Nastaví způsob výpočtu obálky (prahy je poté nutné znovu kalibrovat)
+ * @param newMode EMA, MAV nebo RMS
+ * @return False pokud okenní režimy nejsou přeloženy (EMG_WINDOW_ENVELOPE)
+ */
+bool EMGSensorBank::setEnvelopeMode(EMGEnvelopeMode newMode)
+{
+#ifndef EMG_HAS_WINDOW
+    if (newMode != EMG_ENVELOPE_EMA)
+        return false;
+#endif
+    mode = newMode;
+    begin(channelCount);
+    return true;
+}
+
+/**
+ * @brief Vrací používaný způsob výpočtu obálky
+ */
+EMGEnvelopeMode EMGSensorBank::getEnvelopeMode() const
+{
+    return mode;
+}
+
+/**
+ * @brief Navaže zpracování po přerušení toku snímků, prahy a sledování zůstanou
+ */
+void EMGSensorBank::resync()
+{
+    activeMask = 0;
+    onsetMask = 0;
+    armedMask = 0;
+    baselineFaultMask = 0;
+    for (uint8_t i = 0; i < maxSensors; i++)
+    {
+        debounceRun[i] = 0;
+        activeRun[i] = 0;
+        restCountdown[i] = restHoldoff;
+    }
+    resetEnvelopes();
+
+#ifndef EMG_FLOAT_PIPELINE
+    filtersSeeded = false;
+#endif
+}
+
+/**
+ * @brief Vynuluje obálky a okna všech kanálů
+ */
+void EMGSensorBank::resetEnvelopes()
+{
+    for (uint8_t i = 0; i < maxSensors; i++)
+    {
+#ifdef EMG_FLOAT_PIPELINE
+        envelope[i] = 0.0;
+#else
+        envelope[i] = 0;
+#endif
+#ifdef EMG_HAS_WINDOW
+        windowSum[i] = 0;
+#endif
+    }
+#ifdef EMG_HAS_WINDOW
+    for (uint8_t j = 0; j < envelopeWindowPoolSamples; j++)
+        window[j] = 0;
+    windowPos = 0;
+#endif
+}
+
+/**
+ * @brief Posune detektor kanálu o jeden vzorek
+ * @param channel Index kanálu
+ * @param aboveUpper Obálka je nad horním prahem
+ * @param aboveLower Obálka je nad dolním prahem
+ */
+void EMGSensorBank::detect(uint8_t channel, bool aboveUpper, bool aboveLower)
+{
+    uint8_t bit = 1 << channel;
+
+    if (activeMask & bit)
+    {
+        // Konec aktivity až po souvislém běhu pod dolním prahem
+        if (aboveLower)
+            debounceRun[channel] = 0;
+        else if (++debounceRun[channel] >= offsetDebounce)
+        {
+            activeMask &= ~bit;
+            armedMask &= ~bit;
+            debounceRun[channel] = 0;
+        }
+        return;
+    }
+
+    // Začátek události je první vzorek nad dolním prahem
+    if (!aboveLower)
+    {
+        armedMask &= ~bit;
+        debounceRun[channel] = 0;
+        return;
+    }
+    if (!(armedMask & bit))
+    {
+        armedMask |= bit;
+        onsetSample[channel] = sampleIndex;
+    }
+
+    if (!aboveUpper)
+    {
+        debounceRun[channel] = 0;
+        return;
+    }
+    if (++debounceRun[channel] < onsetDebounce)
+        return;
+
+    activeMask |= bit;
+    onsetMask |= bit;
+    debounceRun[channel] = 0;
+
+    uint32_t latency = sampleIndex - onsetSample[channel];
+    uint16_t latency16 = latency > 0xFFFF ? 0xFFFF : latency;
+    EMGOnsetStats &stats = onsetStats[channel];
+    if (stats.events == 0 || latency16 < stats.minLatency)
+        stats.minLatency = latency16;
+    if (latency16 > stats.maxLatency)
+        stats.maxLatency = latency16;
+    stats.lastLatency = latency16;
+    stats.totalLatency += latency16;
+    if (stats.events < 0xFFFF)
+        stats.events++;
+}
+
+/**
+ * @brief Započte vzorek obálky do sledování klidu, pokud je kanál v klidu
+ * @param channel Index kanálu
+ */
+void EMGSensorBank::trackBaseline(uint8_t channel)
+{
+    uint8_t bit = 1 << channel;
+
+    // Během aktivity a chvíli po ní obálka klid nepopisuje
+    if (activeMask & bit)
+    {
+        if (activeRun[channel] < activityLimit)
+        {
+            // Rozpracovaný klidový blok se do dlouhé aktivity nepřenáší
+            if (++activeRun[channel] == activityLimit)
+                resetRestBlock(channel);
+            restCountdown[channel] = restHoldoff;
+            return;
+        }
+        trackDrift(channel);
+        return;
+    }
+
+    if (activeRun[channel] >= activityLimit)
+    {
+        // Konec dlouhé aktivity, zmrazené sledování se obnoví po restHoldoff
+        resetRestBlock(channel);
+        restCountdown[channel] = restHoldoff;
+        baselineFaultMask &= ~bit;
+    }
+    activeRun[channel] = 0;
+    if (restCountdown[channel] > 0)
+    {
+        restCountdown[channel]--;
+        return;
+    }
+    if (envelope[channel] > thresholdUpper[channel])
+        return;
+
+#ifdef EMG_FLOAT_PIPELINE
+    const float rate = 1.0 / (1UL << baselineTrackingShift);
+    mean[channel] += (envelope[channel] - mean[channel]) * rate;
+    float deviation = envelope[channel] - mean[channel];
+    noiseVariance[channel] += (deviation * deviation - noiseVariance[channel]) * rate;
+#else
+    // Na vzorek jen celočíselné součty, odchylka se měří od poslední klidové úrovně
+    int32_t deviation = envelope[channel] - mean[channel];
+    if (deviation > trackedDeviationMax)
+        deviation = trackedDeviationMax;
+    else if (deviation < -trackedDeviationMax)
+        deviation = -trackedDeviationMax;
+
+    restSum[channel] += envelope[channel];
+    restSquareSum[channel] += (uint32_t)(deviation * deviation);
+    if (++restSamples[channel] < (1 << restBlockLog2))
+        return;
+
+    // Jednou za blok posun EMA, ve float by celočíselný posun o 2^14 ztrácel přesnost
+    const float rate = 1.0 / (1UL << (baselineTrackingShift - restBlockLog2));
+    const float blockScale = 1.0 / (1 << restBlockLog2);
+    trackedMean[channel] += (restSum[channel] * blockScale - trackedMean[channel]) * rate;
+    trackedVariance[channel] += (restSquareSum[channel] * blockScale - trackedVariance[channel]) * rate;
+    resetRestBlock(channel);
+#endif
+}
+
+/**
+ * @brief Zahodí rozpracovaný blok sledování klidu
+ * @param channel Index kanálu
+ */
+void EMGSensorBank::resetRestBlock(uint8_t channel)
+{
+#ifndef EMG_FLOAT_PIPELINE
+    restSum[channel] = 0;
+    restSquareSum[channel] = 0;
+    restSamples[channel] = 0;
+#endif
+}
+
+/**
+ * @brief Započte vzorek dlouhé aktivity, blok se do sledování přidá jen při ploché obálce
+ * @param channel Index kanálu
+ */
+void EMGSensorBank::trackDrift(uint8_t channel)
+{
+    uint8_t bit = 1 << channel;
+    if (baselineFaultMask & bit)
+        return;
+
+#ifdef EMG_FLOAT_PIPELINE
+    // Float výpočet plochost neměří, dlouhá aktivita se do klidu nezapočítá
+    baselineFaultMask |= bit;
+    baselineFaults++;
+#else
+    // Odchylky od prvního vzorku bloku, rozptyl bloku nezávisí na staré klidové úrovni
+    if (restSamples[channel] == 0)
+        driftReference[channel] = envelope[channel];
+    int32_t offset = envelope[channel] - driftReference[channel];
+    if (offset > trackedDeviationMax)
+        offset = trackedDeviationMax;
+    else if (offset < -trackedDeviationMax)
+        offset = -trackedDeviationMax;
+
+    restSum[channel] += envelope[channel];
+    restSquareSum[channel] += (uint32_t)(offset * offset);
+    if (++restSamples[channel] < (1 << restBlockLog2))
+        return;
+
+    const float blockScale = 1.0 / (1 << restBlockLog2);
+    float blockMean = restSum[channel] * blockScale;
+    float meanOffset = blockMean - driftReference[channel];
+    float blockVariance = restSquareSum[channel] * blockScale - meanOffset * meanOffset;
+    float restVariance = trackedVariance[channel] > flatVarianceFloor ? trackedVariance[channel] : flatVarianceFloor;
+    resetRestBlock(channel);
+
+    // Kolísající obálka je skutečná kontrakce, sledování se do konce aktivity zmrazí
+    if (blockVariance > restVariance * baselineFlatFactor)
+    {
+        baselineFaultMask |= bit;
+        baselineFaults++;
+        return;
+    }
+
+    // Plochá obálka je posun klidové úrovně (např. elektrody), sleduje se s rozptylem bloku
+    const float rate = 1.0 / (1UL << (baselineTrackingShift - restBlockLog2));
+    trackedMean[channel] += (blockMean - trackedMean[channel]) * rate;
+    trackedVariance[channel] += (blockVariance - trackedVariance[channel]) * rate;
+#endif
+}
+
+/**
+ * @brief Přepočítá prahy kanálu ze sledované klidové úrovně a rozptylu
+ * @param channel Index kanálu
+ */
+void EMGSensorBank::refreshThresholds(uint8_t channel)
+{
+#ifdef EMG_FLOAT_PIPELINE
+    float stdDev = sqrt(noiseVariance[channel]);
+    thresholdUpper[channel] = mean[channel] + 3.0 * stdDev;
+    thresholdLower[channel] = mean[channel] + stdDev;
+#else
+    mean[channel] = (int32_t)(trackedMean[channel] + 0.5);
+    thresholdUpper[channel] = mean[channel] + isqrtClamped(trackedVariance[channel] * 9);
+    thresholdLower[channel] = mean[channel] + isqrtClamped(trackedVariance[channel]);
+#endif
+}
+
+#ifdef EMG_HAS_WINDOW
+/**
+ * @brief Aktualizuje okenní obálky (MAV nebo RMS) všech kanálů
+ * @param conditioned Výstupy filtračních řetězců (Q3)
+ */
+void EMGSensorBank::updateWindowed(const int16_t *conditioned)
+{
+    uint8_t pos = windowPos;
+    uint8_t rmsPreShift = windowLog2 & 1;                          // Úprava lichého exponentu okna před odmocninou
+    uint8_t rmsPostShift = 8 - filterSampleShift - windowLog2 / 2; // Převod odmocniny součtu čtverců na Q8
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        int16_t sample = conditioned[i];
+        uint16_t x = sample < 0 ? 0 : sample > (int16_t)windowSampleMax ? windowSampleMax : sample;
+        uint16_t &slot = window[(i << windowLog2) + pos];
+        uint16_t oldest = slot;
+        slot = x;
+
+        if (mode == EMG_ENVELOPE_MAV)
+        {
+            // Průměr = součet / 2^log2, převod Q3 -> Q8 posunem doleva
+            windowSum[i] += x - oldest;
+            envelope[i] = (int32_t)((windowSum[i] << (8 - filterSampleShift)) >> windowLog2);
+        }
+        else
+        {
+            // sqrt(součet / 2^log2) = sqrt(součet) / 2^(log2 / 2), dělení se sloučí s převodem na Q8
+            windowSum[i] += (uint32_t)x * x - (uint32_t)oldest * oldest;
+            envelope[i] = (int32_t)isqrt32(windowSum[i] >> rmsPreShift) << rmsPostShift;
+        }
+    }
+
+    windowPos = (pos + 1) & ((1 << windowLog2) - 1);
+}
+#endif
+
+/**
+ * @brief Zpracuje jeden snímek všech kanálů (filtr, obálka, prahy)
+ * @param frame Snímek surových hodnot ADC
+ * @return Maska aktivních kanálů (bit i = kanál i)
+ */
+uint8_t EMGSensorBank::update(const EMGFrame &frame)
+{
+    onsetMask = 0;
+
+#ifdef EMG_FLOAT_PIPELINE
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        float voltage = frame.raw[i] * (5.0 / 1023);
+        float centered = voltage - (5.0 / 3.0);
+        float rectified = fabs(centered);
+        envelope[i] = alpha * rectified + (1 - alpha) * envelope[i];
+    }
+#else
+    // Řetězce začínají v ustáleném stavu (klidová úroveň z kalibrace, jinak první
+    // snímek), bez skoku na horní propusti
+    if (!filtersSeeded)
+    {
+        filters.reset(seedValid ? filterSeed : frame.raw, channelCount);
+        filtersSeeded = true;
+    }
+
+    // Odhad cyklů v EMGFilter.h je ruční, občas se proto změří skutečná doba
+    int16_t conditioned[maxSensors];
+    if (filterProbeCountdown-- == 0)
+    {
+        filterProbeCountdown = filterProbeFrames - 1;
+        unsigned long start = micros();
+        filters.process(frame.raw, conditioned, channelCount);
+        unsigned long elapsed = micros() - start;
+
+        filterProbe.lastUs = elapsed > 0xFFFF ? 0xFFFF : elapsed;
+        if (filterProbe.lastUs > filterProbe.maxUs)
+            filterProbe.maxUs = filterProbe.lastUs;
+        filterProbe.totalUs += filterProbe.lastUs;
+        filterProbe.samples++;
+    }
+    else
+        filters.process(frame.raw, conditioned, channelCount);
+
+    if (mode == EMG_ENVELOPE_EMA)
+    {
+        for (uint8_t i = 0; i < channelCount; i++)
+        {
+            int32_t rectified = (int32_t)conditioned[i] << (8 - filterSampleShift);
+
+            // envelope = alpha * rectified + (1 - alpha) * envelope, jedno násobení 32 bit
+            envelope[i] += ((rectified - envelope[i]) * alphaQ12) >> alphaShift;
+        }
+    }
+#ifdef EMG_HAS_WINDOW
+    else
+        updateWindowed(conditioned);
+#endif
+
+#endif
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        detect(i, envelope[i] > thresholdUpper[i], envelope[i] > thresholdLower[i]);
+        if (calibrated)
+            trackBaseline(i);
+    }
+
+    // Odmocniny jen pro jeden kanál za thresholdRefreshFrames snímků
+    if (calibrated && channelCount > 0 && ++refreshCountdown >= thresholdRefreshFrames)
+    {
+        refreshCountdown = 0;
+        refreshThresholds(refreshChannel);
+        if (++refreshChannel >= channelCount)
+            refreshChannel = 0;
+    }
+
+    sampleIndex++;
+    return activeMask;
+}
+
+/**
+ * @brief Vrací masku aktivních kanálů z posledního snímku
+ */
+uint8_t EMGSensorBank::getActiveMask() const
+{
+    return activeMask;
+}
+
+/**
+ * @brief Vrací masku kanálů, u kterých poslední snímek potvrdil nástup
+ */
+uint8_t EMGSensorBank::getOnsetMask() const
+{
+    return onsetMask;
+}
+
+/**
+ * @brief Vrací masku kanálů, u kterých dlouhá kolísající aktivita zmrazila sledování klidu
+ */
+uint8_t EMGSensorBank::getBaselineFaultMask() const
+{
+    return baselineFaultMask;
+}
+
+/**
+ * @brief Vrací počet zmrazení sledování klidu od begin()
+ */
+uint16_t EMGSensorBank::getBaselineFaultCount() const
+{
+    return baselineFaults;
+}
+
+/**
+ * @brief Zjistí, zda je kanál aktivní (potvrzený nástup, ještě bez konce)
+ * @param channel Index kanálu
+ * @return True pokud je aktivní
+ */
+bool EMGSensorBank::isActive(uint8_t channel) const
+{
+    return (activeMask >> channel) & 1;
+}
+
+/**
+ * @brief Vrací aktuální hodnotu obálky kanálu
+ * @param channel Index kanálu
+ * @return Hodnota obálky ve voltech
+ */
+float EMGSensorBank::getEnvelope(uint8_t channel) const
+{
+    if (channel >= maxSensors)
+        return 0.0;
+#ifdef EMG_FLOAT_PIPELINE
+    return envelope[channel];
+#else
+    return envelope[channel] * (5.0 / (1023.0 * 256.0));
+#endif
+}
+
+/**
+ * @brief Vrací obálku kanálu v jednotkách ADC ve formátu Q4 (binární telemetrie)
+ * @param channel Index kanálu
+ * @return Hodnota obálky, 1 LSB ADC = 16
+ */
+uint16_t EMGSensorBank::getEnvelopeCounts(uint8_t channel) const
+{
+    if (channel >= maxSensors)
+        return 0;
+#ifdef EMG_FLOAT_PIPELINE
+    float counts = envelope[channel] * (1023.0 * 16.0 / 5.0);
+    return counts >= 65535.0 ? 65535 : (counts > 0.0 ? (uint16_t)counts : 0);
+#else
+    int32_t counts = envelope[channel] >> 4;
+    return counts > 65535 ? 65535 : (counts > 0 ? (uint16_t)counts : 0);
+#endif
+}
+
+/**
+ * @brief Vrací horní práh kanálu (nástup aktivity)
+ * @param channel Index kanálu
+ * @return Práh ve voltech
+ */
+float EMGSensorBank::getThresholdUpper(uint8_t channel) const
+{
+    if (channel >= maxSensors)
+        return 0.0;
+#ifdef EMG_FLOAT_PIPELINE
+    return thresholdUpper[channel];
+#else
+    return thresholdUpper[channel] * (5.0 / (1023.0 * 256.0));
+#endif
+}
+
+/**
+ * @brief Vrací dolní práh kanálu (konec aktivity)
+ * @param channel Index kanálu
+ * @return Práh ve voltech
+ */
+float EMGSensorBank::getThresholdLower(uint8_t channel) const
+{
+    if (channel >= maxSensors)
+        return 0.0;
+#ifdef EMG_FLOAT_PIPELINE
+    return thresholdLower[channel];
+#else
+    return thresholdLower[channel] * (5.0 / (1023.0 * 256.0));
+#endif
+}
+
+/**
+ * @brief Vrací sledovanou klidovou úroveň obálky kanálu
+ * @param channel Index kanálu
+ * @return Klidová úroveň ve voltech
+ */
+float EMGSensorBank::getBaseline(uint8_t channel) const
+{
+    if (channel >= maxSensors)
+        return 0.0;
+#ifdef EMG_FLOAT_PIPELINE
+    return mean[channel];
+#else
+    return mean[channel] * (5.0 / (1023.0 * 256.0));
+#endif
+}
+
+/**
+ * @brief Zjistí, zda prahy pochází z dokončené kalibrace
+ */
+bool EMGSensorBank::isCalibrated() const
+{
+    return calibrated;
+}
+
+/**
+ * @brief Zahájí kalibraci všech kanálů (vynuluje průběžné statistiky)
+ */
+void EMGSensorBank::beginCalibration()
+{
+    calibrated = false;
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        calibrationStats[i].reset();
+#ifndef EMG_FLOAT_PIPELINE
+        seedSum[i] = 0;
+#endif
+    }
+
+#ifndef EMG_FLOAT_PIPELINE
+    seedValid = false;
+    filtersSeeded = false;
+#endif
+}
+
+/**
+ * @brief Započte aktuální obálky všech kanálů do kalibrace (volat po update)
+ * @param frame Snímek, ze kterého obálky vznikly (klidová úroveň ADC pro filtry)
+ */
+void EMGSensorBank::addCalibrationSample(const EMGFrame &frame)
+{
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+#ifdef EMG_FLOAT_PIPELINE
+        calibrationStats[i].add((int32_t)(envelope[i] * calibrationScale + 0.5));
+#else
+        calibrationStats[i].add(envelope[i]);
+#endif
+#ifndef EMG_FLOAT_PIPELINE
+        seedSum[i] += frame.raw[i];
+#endif
+    }
+}
+
+/**
+ * @brief Vrací počet snímků započtených do probíhající kalibrace
+ */
+uint32_t EMGSensorBank::getCalibrationSampleCount() const
+{
+    return channelCount > 0 ? calibrationStats[0].getCount() : 0;
+}
+
+/**
+ * @brief Vrací statistiku zpoždění detekce nástupu kanálu
+ * @param channel Index kanálu
+ */
+const EMGOnsetStats &EMGSensorBank::getOnsetStats(uint8_t channel) const
+{
+    return onsetStats[channel < maxSensors ? channel : 0];
+}
+
+/**
+ * @brief Vrací změřenou dobu filtračních řetězců jednoho snímku
+ */
+const EMGFilterProbe &EMGSensorBank::getFilterProbe() const
+{
+    return filterProbe;
+}
+
+/**
+ * @brief Vrací odhad doby filtračních řetězců jednoho snímku podle cyklů z EMGFilter.h
+ * @return Odhad v µs při F_CPU (0 s EMG_FLOAT_PIPELINE)
+ */
+uint16_t EMGSensorBank::getFilterEstimateUs() const
+{
+#ifdef EMG_FLOAT_PIPELINE
+    return 0;
+#else
+    return EMGChannelFilters::cyclesFor(channelCount) / (F_CPU / 1000000UL);
+#endif
+}
+
+/**
+ * @brief Vynuluje statistiky zpoždění všech kanálů
+ */
+void EMGSensorBank::resetOnsetStats()
+{
+    for (uint8_t i = 0; i < maxSensors; i++)
+        onsetStats[i] = EMGOnsetStats();
+}
+
+/**
+ * @brief Dokončí kalibraci, horní práh je průměr + 3σ, dolní průměr + σ
+ *
+ * Dolní práh leží nad klidovým průměrem, aby konec aktivity šlo vůbec
+ * potvrdit; pásmo mezi prahy tvoří hysterezi detektoru.
+ */
+void EMGSensorBank::finishCalibration()
+{
+    char msg[64];
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        if (calibrationStats[i].getCount() == 0)
+            continue;
+
+#ifdef EMG_FLOAT_PIPELINE
+        mean[i] = calibrationStats[i].getMean() / calibrationScale;
+        noiseVariance[i] = calibrationStats[i].getVariance() / (calibrationScale * calibrationScale);
+        float stdDev = sqrt(noiseVariance[i]);
+
+        thresholdUpper[i] = mean[i] + 3.0 * stdDev;
+        thresholdLower[i] = mean[i] + stdDev;
+
+        snprintf(msg, sizeof(msg), "Kalibrace kanálu %d:", i);
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Průměr: %.4f", mean[i]);
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Směrodatná odchylka: %.6f", stdDev);
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Nastaven prah upper: %.6f", thresholdUpper[i]);
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Nastaven prah lower: %.6f", thresholdLower[i]);
+        printIfPinLow(msg, debugPin);
+#else
+        // Statistika běží nad obálkou v Q8, rozptyl je tedy ve formátu Q16
+        mean[i] = (int32_t)(calibrationStats[i].getMean() + 0.5);
+
+        // 3σ = sqrt(9 * var), odmocnina až po vynásobení zachová přesnost prahu
+        float variance = calibrationStats[i].getVariance();
+        int32_t threeSigma = isqrtClamped(variance * 9);
+        int32_t stdDev = isqrtClamped(variance);
+
+        thresholdUpper[i] = mean[i] + threeSigma;
+        thresholdLower[i] = mean[i] + stdDev;
+
+        // Výchozí stav sledování klidu
+        trackedMean[i] = calibrationStats[i].getMean();
+        trackedVariance[i] = variance;
+        restSum[i] = 0;
+        restSquareSum[i] = 0;
+        restSamples[i] = 0;
+
+        uint32_t count = calibrationStats[i].getCount();
+        filterSeed[i] = (seedSum[i] + count / 2) / count;
+
+        snprintf(msg, sizeof(msg), "Kalibrace kanálu %d:", i);
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Průměr: %ld uV", q8ToMicrovolts(mean[i]));
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Směrodatná odchylka: %ld uV", q8ToMicrovolts(stdDev));
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Nastaven prah upper: %ld uV", q8ToMicrovolts(thresholdUpper[i]));
+        printIfPinLow(msg, debugPin);
+
+        snprintf(msg, sizeof(msg), "Nastaven prah lower: %ld uV", q8ToMicrovolts(thresholdLower[i]));
+        printIfPinLow(msg, debugPin);
+#endif
+        restCountdown[i] = 0;
+    }
+
+    calibrated = getCalibrationSampleCount() > 0;
+    refreshCountdown = 0;
+#ifndef EMG_FLOAT_PIPELINE
+    seedValid = calibrated;
+#endif
+}
+
+static_assert(offsetof(EMGCalibrationRecord, crc) ==
+                  offsetof(EMGCalibrationRecord, channels) + maxSensors * sizeof(EMGChannelCalibration),
+              "Porovnani ulozeneho zaznamu predpoklada kanaly bez vyplne pred CRC");
+
+/**
+ * @brief Vrací true, pokud se práh posunul o více než toleranci uložení
+ */
+template <class T>
+static bool thresholdMoved(T value, T stored)
+{
+    T diff = value > stored ? value - stored : stored - value;
+    T limit = (stored < 0 ? -stored : stored) / (1 << calibrationSaveShift);
+    return diff > limit;
+}
+
+/**
+ * @brief Připraví záznam kalibrace k uložení, pokud se prahy změnily oproti EEPROM
+ * @param addr Adresa uloženého záznamu v EEPROM
+ * @param record Výstupní záznam (zapisuje ho volající)
+ * @return False pokud kanály nejsou kalibrované nebo se prahy vešly do tolerance
+ */
+bool EMGSensorBank::prepareCalibration(int addr, EMGCalibrationRecord &record) const
+{
+    if (!calibrated)
+        return false;
+
+    // Nulování i výplně struktury, aby CRC nezáviselo na obsahu zásobníku
+    memset(&record, 0, sizeof(record));
+    record.magic = calibrationRecordMagic;
+    record.version = calibrationRecordVersion;
+    record.channelCount = channelCount;
+    record.envelopeMode = getEnvelopeMode();
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        EMGChannelCalibration &channel = record.channels[i];
+        channel.thresholdUpper = thresholdUpper[i];
+        channel.thresholdLower = thresholdLower[i];
+#ifdef EMG_FLOAT_PIPELINE
+        channel.mean = mean[i];
+        channel.variance = noiseVariance[i];
+        channel.filterSeed = 0;
+#else
+        channel.mean = trackedMean[i];
+        channel.variance = trackedVariance[i];
+        channel.filterSeed = seedValid ? filterSeed[i] : 0;
+#endif
+    }
+
+    record.crc = crc16((const uint8_t *)&record, offsetof(EMGCalibrationRecord, crc));
+
+    // Uložený záznam se čte po částech, aby se pro porovnání nedržela jeho druhá kopie
+    const size_t headerBytes = offsetof(EMGCalibrationRecord, channels);
+    uint8_t header[headerBytes];
+    EEPROMManager::readBlock(addr, header, headerBytes);
+    if (memcmp(header, &record, headerBytes) != 0)
+        return true;
+
+    bool moved = false;
+    uint16_t crc = crc16(header, headerBytes);
+    for (uint8_t i = 0; i < maxSensors; i++)
+    {
+        EMGChannelCalibration stored;
+        EEPROMManager::readBlock(addr + headerBytes + i * sizeof(stored), &stored, sizeof(stored));
+        crc = crc16((const uint8_t *)&stored, sizeof(stored), crc);
+        if (i < channelCount &&
+            (thresholdMoved(record.channels[i].thresholdUpper, stored.thresholdUpper) ||
+             thresholdMoved(record.channels[i].thresholdLower, stored.thresholdLower)))
+            moved = true;
+    }
+
+    // Poškozený (např. nedokončený) záznam se přepíše vždy
+    uint16_t storedCrc;
+    EEPROMManager::readBlock(addr + offsetof(EMGCalibrationRecord, crc), &storedCrc, sizeof(storedCrc));
+    return moved || storedCrc != crc;
+}
+
+/**
+ * @brief Načte kalibraci z EEPROM a pokračuje z ní ve sledování
+ * @param addr Adresa záznamu v EEPROM
+ * @return False pokud záznam chybí, je poškozený nebo neodpovídá konfiguraci
+ */
+bool EMGSensorBank::loadCalibration(int addr)
+{
+    EMGCalibrationRecord record;
+    EEPROMManager::readBlock(addr, &record, sizeof(record));
+
+    if (record.magic != calibrationRecordMagic || record.version != calibrationRecordVersion)
+        return false;
+    if (record.crc != crc16((const uint8_t *)&record, offsetof(EMGCalibrationRecord, crc)))
+        return false;
+    if (record.channelCount != channelCount || record.envelopeMode != getEnvelopeMode())
+        return false;
+
+#ifndef EMG_FLOAT_PIPELINE
+    seedValid = true;
+#endif
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        const EMGChannelCalibration &channel = record.channels[i];
+        thresholdUpper[i] = channel.thresholdUpper;
+        thresholdLower[i] = channel.thresholdLower;
+#ifdef EMG_FLOAT_PIPELINE
+        mean[i] = channel.mean;
+        noiseVariance[i] = channel.variance;
+#else
+        trackedMean[i] = channel.mean;
+        trackedVariance[i] = channel.variance;
+        mean[i] = (int32_t)(channel.mean + 0.5);
+        filterSeed[i] = channel.filterSeed;
+        if (channel.filterSeed == 0)
+            seedValid = false;
+        restSum[i] = 0;
+        restSquareSum[i] = 0;
+        restSamples[i] = 0;
+#endif
+        restCountdown[i] = 0;
+    }
+
+    calibrated = true;
+    refreshCountdown = 0;
+    resync();
+    return true;
+}
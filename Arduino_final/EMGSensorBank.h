@@ -0,0 +1,401 @@
+#ifndef EMG_SENSOR_BANK_H
+#define EMG_SENSOR_BANK_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "RunningStats.h"
+#include "EMGAcquisition.h"
+#include "EMGFilter.h"
+
+// Okenní obálky MAV a RMS jsou jen v pevné řádové čárce a jen s EMG_WINDOW_ENVELOPE
+#if defined(EMG_WINDOW_ENVELOPE) && !defined(EMG_FLOAT_PIPELINE)
+#define EMG_HAS_WINDOW
+#endif
+
+/**
+ * @struct EMGOnsetStats
+ * @brief Statistika zpoždění detekce nástupu aktivity jednoho kanálu (ve vzorcích)
+ *
+ * Zpoždění je počet vzorků od okamžiku, kdy obálka opustila klidové pásmo
+ * (překročila dolní práh), do potvrzení nástupu detektorem.
+ */
+struct EMGOnsetStats
+{
+    uint16_t events = 0;       // Počet potvrzených nástupů
+    uint16_t lastLatency = 0;  // Zpoždění posledního nástupu
+    uint16_t minLatency = 0;   // Nejkratší zpoždění
+    uint16_t maxLatency = 0;   // Nejdelší zpoždění
+    uint32_t totalLatency = 0; // Součet zpoždění (pro průměr)
+};
+
+/**
+ * @struct EMGFilterProbe
+ * @brief Změřená doba filtračních řetězců všech kanálů v jednom snímku
+ *
+ * Měří se jen každý filterProbeFrames-tý snímek, aby měření samo nezdržovalo.
+ * Slouží k porovnání s ručním odhadem cyklů stupňů v EMGFilter.h.
+ */
+struct EMGFilterProbe
+{
+    uint16_t samples = 0; // Počet měření
+    uint16_t lastUs = 0;  // Poslední měření
+    uint16_t maxUs = 0;   // Nejdelší měření
+    uint32_t totalUs = 0; // Součet měření (pro průměr)
+};
+
+/**
+ * @struct EMGChannelCalibration
+ * @brief Uložená kalibrace jednoho kanálu (formát podle zvolené výpočetní cesty)
+ */
+struct EMGChannelCalibration
+{
+#ifdef EMG_FLOAT_PIPELINE
+    float thresholdUpper;   // Horní práh (V)
+    float thresholdLower;   // Dolní práh (V)
+#else
+    int32_t thresholdUpper; // Horní práh (Q8)
+    int32_t thresholdLower; // Dolní práh (Q8)
+#endif
+    float mean;             // Klidová úroveň obálky
+    float variance;         // Rozptyl obálky v klidu (σ²)
+    uint16_t filterSeed;    // Klidová úroveň ADC pro nastavení filtrů
+};
+
+/**
+ * @struct EMGCalibrationRecord
+ * @brief Verzovaný záznam kalibrace všech kanálů chráněný CRC (ukládá se do EEPROM)
+ */
+struct EMGCalibrationRecord
+{
+    uint8_t magic;                              // Značka platného záznamu
+    uint8_t version;                            // Verze formátu (a výpočetní cesty)
+    uint8_t channelCount;                       // Počet kalibrovaných kanálů
+    uint8_t envelopeMode;                       // Způsob výpočtu obálky při kalibraci
+    EMGChannelCalibration channels[maxSensors]; // Kalibrace jednotlivých kanálů
+    uint16_t crc;                               // CRC-16 všech předchozích bajtů
+};
+
+/**
+ * @class EMGSensorBank
+ * @brief Sada EMG kanálů uložená jako struktura polí
+ *
+ * Obálky, prahy, stav filtrů a příznaky aktivity všech kanálů leží v
+ * souvislých polích a aktualizují se jedním průchodem za snímek, bez
+ * alokace na haldě a bez ukazatelů na jednotlivé senzory.
+ *
+ * Bez EMG_FLOAT_PIPELINE se obálka počítá v pevné řádové čárce: hodnoty jsou
+ * v jednotkách ADC ve formátu Q8 (1 LSB ADC = 256), koeficient vyhlazování
+ * ve formátu Q12 a vstupem je výstup filtračního řetězce kanálu (EMGFilter.h).
+ * Veřejné rozhraní vrací hodnoty ve voltech v obou režimech.
+ *
+ * Místo EMA lze obálku počítat jako MAV nebo RMS přes okno nejvýš
+ * envelopeWindowSamples vzorků. Okna používaných kanálů leží za sebou
+ * v jednom bufferu envelopeWindowPoolSamples vzorků, při víc kanálech se
+ * okno zkrátí na nejdelší mocninu dvou, která se vejde. Průběžné součty se
+ * jen upravují o vstupující a vystupující vzorek, takže cena na vzorek
+ * nezávisí na délce okna. RMS používá celočíselnou odmocninu isqrt32.
+ * Okenní režimy jsou jen v pevné řádové čárce a jen s EMG_WINDOW_ENVELOPE,
+ * jinak se okna nealokují a obálka je vždy EMA. EMG_FLOAT_PIPELINE je původní výpočet z doby před filtry:
+ * vždy EMA nad surovým signálem bez filtračního řetězce, takže jeho výsledky
+ * s pevnou řádovou čárkou srovnatelné nejsou.
+ *
+ * Aktivita se vyhodnocuje dvojím prahem s hysterezí: kanál se aktivuje až po
+ * onsetDebounceMs nad horním prahem a uvolní až po offsetDebounceMs pod
+ * dolním prahem, takže šum kolem prahu nezpůsobí opakované nástupy.
+ *
+ * Po kalibraci se v klidových úsecích (kanál neaktivní, obálka pod horním
+ * prahem a uplynulo restHoldoffMs od konce aktivity) průběžně sleduje klidová
+ * úroveň a rozptyl obálky pomalým EMA s časovou konstantou 2^baselineTrackingShift
+ * vzorků. V pevné řádové čárce se vzorky jen celočíselně sčítají a EMA se
+ * posune jednou za blok 64 vzorků. Prahy se přepočítávají vždy pro jeden
+ * kanál za thresholdRefreshFrames snímků, takže drift impedance elektrod
+ * nevyžaduje novou kalibraci. Aktivita delší než activityLimitMs může být
+ * posun klidové úrovně: blok 64 vzorků se do sledování započte, jen když je
+ * obálka plochá (rozptyl bloku nejvýše baselineFlatFactor násobků klidového).
+ * Kolísající obálka je skutečná dlouhá kontrakce, sledování se zmrazí a kanál
+ * hlásí chybu klidové úrovně (getBaselineFaultMask) až do konce aktivity.
+ * Float výpočet plochost neměří a při dlouhé aktivitě sledování vždy zmrazí.
+ *
+ * Výsledek kalibrace včetně sledovaných hodnot lze uložit do EEPROM a po
+ * startu z něj navázat bez nové kalibrace (prepareCalibration/loadCalibration).
+ */
+class EMGSensorBank
+{
+private:
+    uint8_t channelCount = 0;                           // Počet používaných kanálů
+    uint8_t activeMask = 0;                             // Bit i = kanál i je aktivní (potvrzený nástup)
+    uint8_t onsetMask = 0;                              // Kanály s potvrzeným nástupem v posledním snímku
+    uint8_t armedMask = 0;                              // Kanály, jejichž obálka opustila klidové pásmo
+    uint8_t onsetDebounce = 1;                          // Potřebný počet vzorků nad horním prahem
+    uint8_t offsetDebounce = 1;                         // Potřebný počet vzorků pod dolním prahem
+    uint8_t debounceRun[maxSensors];                    // Délka aktuálního běhu za prahem
+    uint32_t sampleIndex = 0;                           // Počet zpracovaných snímků
+    uint32_t onsetSample[maxSensors];                   // Snímek, kdy obálka opustila klidové pásmo
+    EMGOnsetStats onsetStats[maxSensors];               // Statistika zpoždění detekce
+    RunningStats calibrationStats[maxSensors];          // Průběžná statistika obálek během kalibrace
+    EMGEnvelopeMode mode;                               // Způsob výpočtu obálky
+    bool calibrated = false;                            // Prahy pochází z kalibrace a průběžně se sledují
+    uint16_t restHoldoff = 1;                           // Počet vzorků po konci aktivity bez sledování klidu
+    uint16_t restCountdown[maxSensors];                 // Zbývající vzorky do obnovení sledování klidu
+    uint16_t activityLimit = 1;                         // Počet vzorků, po kterém se aktivita považuje za posun klidu
+    uint16_t activeRun[maxSensors];                     // Délka současné aktivity ve vzorcích
+    uint8_t baselineFaultMask = 0;                      // Kanály se zmrazeným sledováním během dlouhé aktivity
+    uint16_t baselineFaults = 0;                        // Počet zmrazení sledování od začátku
+    uint8_t refreshCountdown = 0;                       // Snímky do dalšího přepočtu prahů
+    uint8_t refreshChannel = 0;                         // Kanál, jehož prahy se přepočítají příště
+    static const uint8_t thresholdRefreshFrames = 32;   // Perioda přepočtu prahů jednoho kanálu ve snímcích
+    EMGFilterProbe filterProbe;                         // Změřená doba filtrů (jen pevná řádová čárka)
+    uint8_t filterProbeCountdown = 0;                   // Snímky do dalšího měření filtrů
+    static const uint16_t filterProbeFrames = 256;      // Měří se jeden snímek z filterProbeFrames
+
+#ifdef EMG_FLOAT_PIPELINE
+    float alpha = 0.6;                                  // Koeficient pro exponenciální vyhlazování
+    float envelope[maxSensors];                         // Aktuální hodnoty obálek
+    float thresholdUpper[maxSensors];                   // Horní prahy pro detekci aktivity
+    float thresholdLower[maxSensors];                   // Dolní prahy pro konec aktivity
+    float mean[maxSensors];                             // Průměrné hodnoty obálek v klidu
+    float noiseVariance[maxSensors];                    // Rozptyl obálek v klidu
+#else
+    static const uint8_t alphaShift = 12;               // Počet desetinných bitů koeficientu alpha
+    static const int32_t alphaQ12 = 2458;               // Koeficient vyhlazování 0.6 ve formátu Q12
+    int32_t envelope[maxSensors];                       // Aktuální hodnoty obálek (ADC jednotky Q8)
+    int32_t thresholdUpper[maxSensors];                 // Horní prahy pro detekci aktivity (Q8)
+    int32_t thresholdLower[maxSensors];                 // Dolní prahy pro konec aktivity (Q8)
+    int32_t mean[maxSensors];                           // Průměrné hodnoty obálek v klidu (Q8)
+    static const uint8_t restBlockLog2 = 6;             // Klidové vzorky se sčítají po blocích 2^6 vzorků
+    uint32_t restSum[maxSensors];                       // Součet obálek v rozpracovaném bloku (Q8)
+    uint32_t restSquareSum[maxSensors];                 // Součet čtverců odchylek od klidové úrovně (Q16)
+    uint8_t restSamples[maxSensors];                    // Počet vzorků v rozpracovaném bloku
+    int32_t driftReference[maxSensors];                 // První vzorek bloku při dlouhé aktivitě (Q8)
+    float trackedMean[maxSensors];                      // Sledovaná klidová úroveň (Q8)
+    float trackedVariance[maxSensors];                  // Sledovaný rozptyl v klidu (Q16)
+    EMGChannelFilters filters;                          // Filtrační řetězce všech kanálů
+#ifdef EMG_HAS_WINDOW
+    uint16_t window[envelopeWindowPoolSamples];         // Okna kanálů za sebou, posledních N usměrněných vzorků (Q3)
+    uint32_t windowSum[maxSensors];                     // Součet vzorků (MAV) nebo jejich čtverců (RMS)
+    uint8_t windowPos = 0;                              // Pozice nejstaršího vzorku v okně
+    uint8_t windowLog2 = envelopeWindowLog2;            // Délka okna jako mocnina dvou podle počtu kanálů
+#endif
+    bool filtersSeeded = false;                         // Řetězce už jsou nastaveny do ustáleného stavu
+    bool seedValid = false;                             // filterSeed pochází z kalibrace
+    uint16_t filterSeed[maxSensors];                    // Klidová úroveň ADC pro nastavení filtrů
+    uint32_t seedSum[maxSensors];                       // Součet surových hodnot během kalibrace
+#endif
+
+    /**
+     * @brief Posune detektor kanálu o jeden vzorek
+     * @param channel Index kanálu
+     * @param aboveUpper Obálka je nad horním prahem
+     * @param aboveLower Obálka je nad dolním prahem
+     */
+    void detect(uint8_t channel, bool aboveUpper, bool aboveLower);
+
+#ifdef EMG_HAS_WINDOW
+    /**
+     * @brief Aktualizuje okenní obálky (MAV nebo RMS) všech kanálů
+     * @param conditioned Výstupy filtračních řetězců (Q3)
+     */
+    void updateWindowed(const int16_t *conditioned);
+#endif
+
+    /**
+     * @brief Vynuluje obálky a okna všech kanálů
+     */
+    void resetEnvelopes();
+
+    /**
+     * @brief Zahodí rozpracovaný blok sledování klidu
+     * @param channel Index kanálu
+     */
+    void resetRestBlock(uint8_t channel);
+
+    /**
+     * @brief Započte vzorek dlouhé aktivity, blok se do sledování přidá jen při ploché obálce
+     * @param channel Index kanálu
+     */
+    void trackDrift(uint8_t channel);
+
+    /**
+     * @brief Započte vzorek obálky do sledování klidu, pokud je kanál v klidu
+     * @param channel Index kanálu
+     */
+    void trackBaseline(uint8_t channel);
+
+    /**
+     * @brief Přepočítá prahy kanálu ze sledované klidové úrovně a rozptylu
+     * @param channel Index kanálu
+     */
+    void refreshThresholds(uint8_t channel);
+
+public:
+    /**
+     * @brief Konstruktor sady kanálů
+     */
+    EMGSensorBank();
+
+    /**
+     * @brief Nastaví počet kanálů a vynuluje jejich stav i prahy
+     * @param channels Počet kanálů (nejvýše maxSensors)
+     */
+    void begin(uint8_t channels);
+
+    /**
+     * @brief Vrací počet používaných kanálů
+     */
+    uint8_t getChannelCount() const;
+
+    /**
+     * @brief Nastaví způsob výpočtu obálky (prahy je poté nutné znovu kalibrovat)
+     * @param newMode EMA, MAV nebo RMS
+     * @return False pokud okenní režimy nejsou přeloženy (EMG_WINDOW_ENVELOPE)
+     */
+    bool setEnvelopeMode(EMGEnvelopeMode newMode);
+
+    /**
+     * @brief Vrací používaný způsob výpočtu obálky
+     */
+    EMGEnvelopeMode getEnvelopeMode() const;
+
+    /**
+     * @brief Zpracuje jeden snímek všech kanálů (filtr, obálka, prahy)
+     * @param frame Snímek surových hodnot ADC
+     * @return Maska aktivních kanálů (bit i = kanál i)
+     */
+    uint8_t update(const EMGFrame &frame);
+
+    /**
+     * @brief Vrací masku aktivních kanálů z posledního snímku
+     */
+    uint8_t getActiveMask() const;
+
+    /**
+     * @brief Vrací masku kanálů, u kterých poslední snímek potvrdil nástup
+     */
+    uint8_t getOnsetMask() const;
+
+    /**
+     * @brief Vrací masku kanálů, u kterých dlouhá kolísající aktivita zmrazila sledování klidu
+     */
+    uint8_t getBaselineFaultMask() const;
+
+    /**
+     * @brief Vrací počet zmrazení sledování klidu od begin()
+     */
+    uint16_t getBaselineFaultCount() const;
+
+    /**
+     * @brief Zjistí, zda je kanál aktivní (potvrzený nástup, ještě bez konce)
+     * @param channel Index kanálu
+     * @return True pokud je aktivní
+     */
+    bool isActive(uint8_t channel) const;
+
+    /**
+     * @brief Vrací aktuální hodnotu obálky kanálu
+     * @param channel Index kanálu
+     * @return Hodnota obálky ve voltech
+     */
+    float getEnvelope(uint8_t channel) const;
+
+    /**
+     * @brief Vrací obálku kanálu v jednotkách ADC ve formátu Q4 (binární telemetrie)
+     * @param channel Index kanálu
+     * @return Hodnota obálky, 1 LSB ADC = 16
+     */
+    uint16_t getEnvelopeCounts(uint8_t channel) const;
+
+    /**
+     * @brief Vrací horní práh kanálu (nástup aktivity)
+     * @param channel Index kanálu
+     * @return Práh ve voltech
+     */
+    float getThresholdUpper(uint8_t channel) const;
+
+    /**
+     * @brief Vrací dolní práh kanálu (konec aktivity)
+     * @param channel Index kanálu
+     * @return Práh ve voltech
+     */
+    float getThresholdLower(uint8_t channel) const;
+
+    /**
+     * @brief Vrací sledovanou klidovou úroveň obálky kanálu
+     * @param channel Index kanálu
+     * @return Klidová úroveň ve voltech
+     */
+    float getBaseline(uint8_t channel) const;
+
+    /**
+     * @brief Zjistí, zda prahy pochází z dokončené kalibrace
+     */
+    bool isCalibrated() const;
+
+    /**
+     * @brief Navaže zpracování po přerušení toku snímků, prahy a sledování zůstanou
+     */
+    void resync();
+
+    /**
+     * @brief Zahájí kalibraci všech kanálů (vynuluje průběžné statistiky)
+     */
+    void beginCalibration();
+
+    /**
+     * @brief Započte aktuální obálky všech kanálů do kalibrace (volat po update)
+     * @param frame Snímek, ze kterého obálky vznikly (klidová úroveň ADC pro filtry)
+     */
+    void addCalibrationSample(const EMGFrame &frame);
+
+    /**
+     * @brief Vrací statistiku zpoždění detekce nástupu kanálu
+     * @param channel Index kanálu
+     */
+    const EMGOnsetStats &getOnsetStats(uint8_t channel) const;
+
+    /**
+     * @brief Vrací změřenou dobu filtračních řetězců jednoho snímku
+     */
+    const EMGFilterProbe &getFilterProbe() const;
+
+    /**
+     * @brief Vrací odhad doby filtračních řetězců jednoho snímku podle cyklů z EMGFilter.h
+     * @return Odhad v µs při F_CPU (0 s EMG_FLOAT_PIPELINE)
+     */
+    uint16_t getFilterEstimateUs() const;
+
+    /**
+     * @brief Vynuluje statistiky zpoždění všech kanálů
+     */
+    void resetOnsetStats();
+
+    /**
+     * @brief Dokončí kalibraci, horní práh je průměr + 3σ, dolní průměr + σ
+     */
+    void finishCalibration();
+
+    /**
+     * @brief Vrací počet snímků započtených do probíhající kalibrace
+     */
+    uint32_t getCalibrationSampleCount() const;
+
+    /**
+     * @brief Připraví záznam kalibrace k uložení, pokud se prahy změnily oproti EEPROM
+     * @param addr Adresa uloženého záznamu v EEPROM
+     * @param record Výstupní záznam (zapisuje ho volající)
+     * @return False pokud kanály nejsou kalibrované nebo se prahy vešly do tolerance
+     */
+    bool prepareCalibration(int addr, EMGCalibrationRecord &record) const;
+
+    /**
+     * @brief Načte kalibraci z EEPROM a pokračuje z ní ve sledování
+     * @param addr Adresa záznamu v EEPROM
+     * @return False pokud záznam chybí, je poškozený nebo neodpovídá konfiguraci
+     */
+    bool loadCalibration(int addr);
+};
+
+static_assert(baselineTrackingShift > 6, "Sledovani klidu musi byt pomalejsi nez blok 64 vzorku");
+static_assert(envelopeWindowLog2 <= 6, "Soucet ctvercu okna RMS by pretekl uint32");
+static_assert(envelopeWindowPoolSamples / maxSensors >= 16, "Okno MAV/RMS pri vsech kanalech by bylo kratsi nez 16 vzorku");
+
+#endif // EMG_SENSOR_BANK_H
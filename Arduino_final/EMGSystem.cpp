@@ -2,252 +2,1194 @@
 #include "Config.h"
 #include "Utils.h"
 #include "CommandTable.h"
+#include "EEPROMManager.h"
 
 /**
  * @brief Konstruktor EMGSystemu
  * @param port TCP port serveru
  */
-EMGSystem::EMGSystem(int port) : server(port), lcdDisplay(nullptr) {}
+EMGSystem::EMGSystem(int port) : server(port), lcdDisplay(nullptr)
+{
+    channelCount = emgChannelCount > maxSensors ? maxSensors : emgChannelCount;
+}
 
 /**
- * @brief Spustí TCP server pro EMG systém
+ * @brief Spustí vzorkování a bez uložené kalibrace i kalibraci (souběžně se startem sítě)
+ */
+void EMGSystem::begin()
+{
+    timers.begin(millis());
+    timers.schedule(EMG_TIMER_ALIVE, aliveIntervalMs);
+
+    // Uložená kalibrace umožní první příkaz hned po připojení klienta
+    sensors.begin(channelCount);
+    emgAcquisition.begin(channelCount, refreshRateHz);
+    sampling = true;
+    if (sensors.loadCalibration(EEPROM_ADDR_CALIB))
+    {
+        printIfPinLow(F("Kalibrace načtena z EEPROM"), debugPin);
+        return;
+    }
+
+    // Bez uložené kalibrace se kalibruje hned, první klient pak nečeká celé okno
+    printIfPinLow(F("Kalibrace běží souběžně s připojováním k WiFi"), debugPin);
+    calibrateSensors();
+}
+
+/**
+ * @brief Spustí TCP server pro EMG systém (po připojení k WiFi)
  */
 void EMGSystem::beginServer()
 {
+    // Po výpadku sítě modul naslouchající socket zahodil, begin() ho vytvoří znovu
     server.begin();
+    serverStarted = true;
+    noClientPrinted = false;
     printIfPinLow(F("EMG TCP server spuštěn"), debugPin);
 }
 
 /**
- * @brief Zpracuje zprávy od klienta
+ * @brief Odpojí všechny klienty a zastaví TCP server (výpadek WiFi), kalibrace i příkaz zůstanou
+ */
+void EMGSystem::endServer()
+{
+    // Spojení výpadek nepřežijí; prahy zůstanou v paměti a první nový klient pokračuje stejným příkazem
+    if (clientCount > 0 && cycledValue > 0)
+        resumeCommand = cycledValue;
+    dropClients();
+    serverStarted = false;
+    printIfPinLow(F("EMG TCP server zastaven"), debugPin);
+}
+
+/**
+ * @brief Zastaví vzorkování i kalibraci (v režimu AP se EMG nepoužívá)
+ */
+void EMGSystem::end()
+{
+    emgAcquisition.end();
+    sampling = false;
+    cleanupSensors();
+}
+
+/**
+ * @brief Obsluhy časovačů podle EMGTimerId (cooldowny jen běží, nic nespouští)
+ */
+const EMGSystem::TimerHandler EMGSystem::timerHandlers[EMG_TIMER_COUNT] = {
+    &EMGSystem::sendAutoStop,       // EMG_TIMER_AUTO_STOP
+    nullptr,                        // EMG_TIMER_SELECT_COOLDOWN
+    nullptr,                        // EMG_TIMER_SEND_COOLDOWN
+    &EMGSystem::sendAlive,          // EMG_TIMER_ALIVE
+    &EMGSystem::sendRttPing,        // EMG_TIMER_RTT_PING
+    &EMGSystem::handleRttTimeout,   // EMG_TIMER_RTT_TIMEOUT
+    &EMGSystem::advanceCalibration, // EMG_TIMER_CALIBRATION
+};
+
+/**
+ * @brief Tabulka textových příkazů klienta
+ */
+const EMGSystem::ClientCommand EMGSystem::clientCommands[] = {
+    {"DISCONNECT", &EMGSystem::handleDisconnectCommand, false},
+    {"PING", &EMGSystem::handlePingCommand, false},
+    {"PONG", &EMGSystem::handlePongCommand, false},
+    {"ALIVE", &EMGSystem::handleAliveCommand, false},
+    {"STREAM", &EMGSystem::handleStreamCommand, false},
+    {"ROLE", &EMGSystem::handleRoleCommand, false},
+    {"RECAL", &EMGSystem::handleRecalCommand, true},
+    {"SET", &EMGSystem::handleSetCommand, true},
+    {"UDP", &EMGSystem::handleUdpCommand, true},
+    {"RTT", &EMGSystem::handleRttCommand, false},
+    {"TIMERS", &EMGSystem::handleTimersCommand, false},
+};
+
+/**
+ * @brief Zpracuje zprávy od všech klientů (neblokující, omezeno clientRxBudgetBytes/Us)
+ */
+void EMGSystem::handleClientMessages()
+{
+    // Řídicí klient je na řadě první, monitory nesmí zdržet příkazy robota
+    unsigned long start = micros();
+    if (controlSlot != noClient)
+        readClient(controlSlot, start);
+
+    for (uint8_t i = 0; i < maxClients; i++)
+    {
+        if (i != controlSlot && clients[i].client)
+            readClient(i, start);
+    }
+}
+
+/**
+ * @brief Přečte a zpracuje dostupná data jednoho klienta
+ * @param slot Index klienta
+ * @param start Čas začátku zpracování průchodu (micros)
+ */
+void EMGSystem::readClient(uint8_t slot, unsigned long start)
+{
+    EMGClientSlot &c = clients[slot];
+
+    // Čte se jen to, co už v modulu čeká; nedokončený řádek počká na další průchod
+    int available = c.client.available();
+    if (available <= 0)
+        return;
+    if (available > clientRxBudgetBytes)
+        available = clientRxBudgetBytes;
+
+    uint8_t chunk[clientRxChunkBytes];
+    while (available > 0 && micros() - start < clientRxBudgetUs)
+    {
+        int count = c.client.read(chunk, available < (int)sizeof(chunk) ? available : sizeof(chunk));
+        if (count <= 0)
+        {
+            c.lastStatusMs = millis() - clientStatusIntervalMs; // Chyba čtení, stav socketu se ověří hned
+            return;
+        }
+        available -= count;
+        c.lastRxMs = millis();
+
+        for (int i = 0; i < count; i++)
+        {
+            if (!c.parser.feed(chunk[i]))
+                continue;
+            dispatchCommand(slot, c.parser.getLine());
+
+            // DISCONNECT spojení zavřel, zbytek dat už nepatří nikomu
+            if (!c.client)
+                return;
+        }
+    }
+}
+
+/**
+ * @brief Vyhledá příkaz v tabulce a zavolá jeho obsluhu
+ * @param slot Index odesílatele
+ * @param line Kompletní řádek (velkými písmeny)
+ */
+void EMGSystem::dispatchCommand(uint8_t slot, char *line)
+{
+    if (clients[slot].rolePending)
+        assignRole(slot, line);
+
+    char *args = strchr(line, ' ');
+    if (args)
+        *args++ = '\0';
+    else
+        args = line + strlen(line);
+
+    for (uint8_t i = 0; i < sizeof(clientCommands) / sizeof(clientCommands[0]); i++)
+    {
+        if (strcmp(line, clientCommands[i].name) == 0)
+        {
+            if (clientCommands[i].controlOnly && slot != controlSlot)
+            {
+                clients[slot].tx.print(F("DENIED\n"));
+                return;
+            }
+            (this->*clientCommands[i].handler)(slot, args);
+            return;
+        }
+    }
+
+    // Neznámé zprávy (např. prázdný řádek, kterým se klient ohlásí) se ignorují
+    if (line[0])
+        printIfPinLow(line, debugPin);
+}
+
+/**
+ * @brief Příkaz DISCONNECT - ukončí spojení odesílatele
+ * @param slot Index odesílatele
+ * @param args Parametry (nepoužito)
+ */
+void EMGSystem::handleDisconnectCommand(uint8_t slot, char *args)
+{
+    printIfPinLow(F("DISCONNECT příkaz přijat. Ukončuji spojení..."), debugPin);
+    closeClient(slot);
+}
+
+/**
+ * @brief Příkaz PING [token] - odpoví PONG <token> <micros zařízení>
+ * @param slot Index odesílatele
+ * @param args Volitelný token, který se vrátí beze změny
+ */
+void EMGSystem::handlePingCommand(uint8_t slot, char *args)
+{
+    char reply[48];
+    snprintf(reply, sizeof(reply), "PONG %s %lu\n", args[0] ? args : "0", (unsigned long)micros());
+    clients[slot].tx.print(reply);
+    clients[slot].tx.flush(true); // Měří se doba odezvy, odpověď nečeká na konec průchodu
+}
+
+/**
+ * @brief Příkaz PONG <token> - odpověď řídicího klienta na PING zařízení
+ * @param slot Index odesílatele
+ * @param args Token z PINGu
+ */
+void EMGSystem::handlePongCommand(uint8_t slot, char *args)
+{
+    // Čas se bere při zpracování řádku, odezva tedy zahrnuje i zdržení smyčky
+    unsigned long now = micros();
+    if (slot != controlSlot || !timers.isActive(EMG_TIMER_RTT_TIMEOUT) || (uint16_t)atol(args) != rttToken)
+        return;
+
+    rtt.add(now - rttSentUs);
+    timers.cancel(EMG_TIMER_RTT_TIMEOUT);
+}
+
+/**
+ * @brief Příkaz ALIVE - heartbeat klienta, od prvního se hlídá clientTimeoutMs
+ * @param slot Index odesílatele
+ * @param args Parametry (nepoužito)
+ */
+void EMGSystem::handleAliveCommand(uint8_t slot, char *args)
+{
+    // Klienti bez heartbeatu (starší roboti) se dál poznají jen podle stavu socketu
+    clients[slot].heartbeat = true;
+}
+
+/**
+ * @brief Příkaz RTT [ON|OFF|RESET] - měření odezvy, bez parametru vypíše histogram
+ * @param slot Index odesílatele
+ * @param args Parametry za slovem RTT (velkými písmeny)
+ */
+void EMGSystem::handleRttCommand(uint8_t slot, char *args)
+{
+    EMGClientSlot &c = clients[slot];
+
+    if (args[0])
+    {
+        // PINGy jdou řídicímu klientovi, zapnout je smí jen on sám
+        if (slot != controlSlot)
+        {
+            c.tx.print(F("DENIED\n"));
+            return;
+        }
+        if (strcmp(args, "ON") == 0)
+        {
+            if (!rttEnabled)
+                timers.schedule(EMG_TIMER_RTT_PING, rttPingIntervalMs);
+            rttEnabled = true;
+        }
+        else if (strcmp(args, "OFF") == 0)
+            stopRtt();
+        else if (strcmp(args, "RESET") == 0)
+            rtt.reset();
+        else
+        {
+            c.tx.print(F("RTT ERR\n"));
+            return;
+        }
+        c.tx.print(rttEnabled ? F("RTT ON\n") : F("RTT OFF\n"));
+        return;
+    }
+
+    // RTT odezvy ztracené min p50 p99 max (µs) RSSI přetečení, pak počty v koších
+    // (horní mez koše i je 2^(rttHistogramMinLog2 + i) µs, poslední koš je otevřený)
+    char reply[96];
+    snprintf(reply, sizeof(reply), "RTT %lu %lu %lu %lu %lu %lu %ld %lu", (unsigned long)rtt.getSamples(),
+             (unsigned long)rtt.getLost(), (unsigned long)rtt.getMinUs(), (unsigned long)rtt.getPercentileUs(50),
+             (unsigned long)rtt.getPercentileUs(99), (unsigned long)rtt.getMaxUs(), (long)WiFi.RSSI(),
+             (unsigned long)emgAcquisition.getOverrunCount());
+    c.tx.print(reply);
+    for (uint8_t i = 0; i < rttHistogramBuckets; i++)
+    {
+        c.tx.print(' ');
+        c.tx.print(rtt.getCount(i));
+    }
+    c.tx.print('\n');
+}
+
+/**
+ * @brief Příkaz TIMERS - čítače časového kola (spuštěné, opožděné, max. zpoždění)
+ * @param slot Index odesílatele
+ * @param args Parametry (nepoužito)
+ */
+void EMGSystem::handleTimersCommand(uint8_t slot, char *args)
+{
+    // Spuštěné, opožděné o tik a víc, max. zpoždění v ms, max. časovačů odložených na další průchod
+    const TimerStats &stats = timers.getStats();
+    char reply[64];
+    snprintf(reply, sizeof(reply), "TIMERS %lu %lu %u %u\n", (unsigned long)stats.fired, (unsigned long)stats.late,
+             stats.maxLateMs, stats.maxCatchUp);
+    clients[slot].tx.print(reply);
+}
+
+/**
+ * @brief Spustí obsluhy nejvýš timerHandlersPerPass vypršelých časovačů
+ *
+ * Zbylé vypršelé časovače zůstanou v kole na další průchod smyčky, takže
+ * nahromaděné časovače nezdrží jeden průchod (čtení vzorků a klientů).
+ */
+void EMGSystem::runTimers()
+{
+    unsigned long now = millis();
+    for (uint8_t run = 0; run < timerHandlersPerPass; run++)
+    {
+        uint8_t id = timers.poll(now);
+        if (id == timerNone)
+            break;
+        if (timerHandlers[id])
+            (this->*timerHandlers[id])();
+    }
+    timers.endPass();
+}
+
+/**
+ * @brief Časovač EMG_TIMER_RTT_PING - odešle řídicímu klientovi PING
+ */
+void EMGSystem::sendRttPing()
+{
+    if (!rttEnabled || controlSlot == noClient)
+        return;
+    timers.schedule(EMG_TIMER_RTT_PING, rttPingIntervalMs);
+
+    // Vždy jen jeden PING bez odpovědi, jinak by se odezvy nedaly přiřadit
+    if (timers.isActive(EMG_TIMER_RTT_TIMEOUT))
+        return;
+
+    char msg[16];
+    snprintf(msg, sizeof(msg), "PING %u\n", ++rttToken);
+    EMGClientSlot &c = clients[controlSlot];
+    c.tx.print(msg);
+    rttSentUs = micros();
+    c.tx.flush(true); // Měří se doba odezvy, PING nečeká na konec průchodu
+    timers.schedule(EMG_TIMER_RTT_TIMEOUT, rttPingTimeoutMs);
+}
+
+/**
+ * @brief Časovač EMG_TIMER_RTT_TIMEOUT - PING zůstal bez odpovědi
+ */
+void EMGSystem::handleRttTimeout()
+{
+    rtt.addLost();
+}
+
+/**
+ * @brief Vypne měření odezvy (řídicí klient se změnil nebo odešel)
+ */
+void EMGSystem::stopRtt()
+{
+    rttEnabled = false;
+    timers.cancel(EMG_TIMER_RTT_PING);
+    timers.cancel(EMG_TIMER_RTT_TIMEOUT);
+}
+
+/**
+ * @brief Časovač EMG_TIMER_AUTO_STOP - pošle robotovi "0"
+ */
+void EMGSystem::sendAutoStop()
+{
+    printIfPinLow(F("Automatické zastavení robota"), debugPin);
+    sendRobotCommand(0);
+}
+
+/**
+ * @brief Příkaz RECAL - nová kalibrace všech kanálů
+ * @param slot Index odesílatele
+ * @param args Parametry (nepoužito)
+ */
+void EMGSystem::handleRecalCommand(uint8_t slot, char *args)
+{
+    printIfPinLow(F("RECAL příkaz přijat. Spouštím kalibraci..."), debugPin);
+    recalibrate();
+}
+
+/**
+ * @brief Příkaz SET CHANNELS <n> | SET MODE <EMA|MAV|RMS>
+ * @param slot Index odesílatele
+ * @param args Název a hodnota parametru
+ */
+void EMGSystem::handleSetCommand(uint8_t slot, char *args)
+{
+    char *value = strchr(args, ' ');
+    bool ok = false;
+
+    if (value)
+    {
+        *value++ = '\0';
+        if (strcmp(args, "CHANNELS") == 0)
+        {
+            ok = setChannelCount(atoi(value));
+        }
+        else if (strcmp(args, "MODE") == 0)
+        {
+            if (strcmp(value, "EMA") == 0)
+                ok = setEnvelopeMode(EMG_ENVELOPE_EMA);
+            else if (strcmp(value, "MAV") == 0)
+                ok = setEnvelopeMode(EMG_ENVELOPE_MAV);
+            else if (strcmp(value, "RMS") == 0)
+                ok = setEnvelopeMode(EMG_ENVELOPE_RMS);
+        }
+    }
+
+    clients[slot].tx.print(ok ? F("SET OK\n") : F("SET ERR\n"));
+}
+
+/**
+ * @brief Příkaz UDP <port> [kopie] | UDP OFF | UDP STATS - příkazy i přes UDP na adresu odesílatele
+ * @param slot Index odesílatele
+ * @param args Parametry za slovem UDP (velkými písmeny)
+ */
+void EMGSystem::handleUdpCommand(uint8_t slot, char *args)
+{
+    EMGClientSlot &c = clients[slot];
+    char reply[64];
+
+    char *token = strtok(args, " ");
+    if (token && strcmp(token, "OFF") == 0)
+    {
+        commandLink.stop();
+        c.tx.print(F("UDP OFF\n"));
+        return;
+    }
+    if (token && strcmp(token, "STATS") == 0)
+    {
+        // Příkazy, odeslané datagramy (včetně kopií), datagramy odmítnuté modulem
+        snprintf(reply, sizeof(reply), "UDP STATS %lu %lu %lu\n", (unsigned long)commandLink.getCommandsSent(),
+                 (unsigned long)commandLink.getDatagramsSent(), (unsigned long)commandLink.getSendFailures());
+        c.tx.print(reply);
+        return;
+    }
+
+    // Datagramy jdou na adresu TCP spojení, robot jen zvolí port
+    long port = token ? atol(token) : 0;
+    char *copies = strtok(nullptr, " ");
+    uint8_t repeats = copies ? constrain(atoi(copies), 0, 255) : udpCommandRepeats;
+    if (port <= 0 || port > 65535 || !commandLink.start(c.client.remoteIP(), port, repeats))
+    {
+        c.tx.print(F("UDP ERR\n"));
+        return;
+    }
+
+    snprintf(reply, sizeof(reply), "UDP ON %ld %u\n", port, repeats);
+    c.tx.print(reply);
+    printIfPinLow(reply, debugPin);
+}
+
+/**
+ * @brief Zpracuje příkaz STREAM [OFF|STATS|RAW|počet vzorků na rámec]
+ * @param slot Index odesílatele
+ * @param args Parametry za slovem STREAM (velkými písmeny)
+ */
+void EMGSystem::handleStreamCommand(uint8_t slot, char *args)
+{
+    EMGClientSlot &c = clients[slot];
+    char reply[96];
+    uint8_t frameSamples = telemetrySamplesPerFrame;
+    bool raw = false;
+
+    for (char *token = strtok(args, " "); token; token = strtok(nullptr, " "))
+    {
+        if (strcmp(token, "OFF") == 0)
+        {
+            c.streaming = false;
+            updateTelemetrySubscribers();
+            c.tx.print(F("STREAM OFF\n"));
+            printIfPinLow(F("Proud telemetrie vypnut"), debugPin);
+            return;
+        }
+        if (strcmp(token, "STATS") == 0)
+        {
+            // Rámce odeslané/zahozené, bajty, B/s, přetečení vzorků, zápisy a vyprázdnění bufferu za s
+            const TxStats &txStats = c.tx.getStats();
+            snprintf(reply, sizeof(reply), "STREAM STATS %lu %lu %lu %lu %lu %u %u\n",
+                     (unsigned long)telemetry.getFramesSent(), (unsigned long)telemetry.getFramesDropped(),
+                     (unsigned long)telemetry.getBytesSent(), (unsigned long)telemetry.getBytesPerSecond(),
+                     (unsigned long)emgAcquisition.getOverrunCount(), txStats.writeCallsPerSecond,
+                     txStats.flushesPerSecond);
+            c.tx.print(reply);
+            return;
+        }
+        if (strcmp(token, "RAW") == 0)
+            raw = true;
+        else
+            frameSamples = constrain(atoi(token), 0, 255);
+    }
+
+    // Rámec je společný pro všechny odběratele; nové parametry platí pro všechny
+    // (hlavička rámce je popisuje, klient se nemusí řídit jen potvrzením)
+    bool sameFormat = telemetry.isEnabled() && telemetry.getSamplesPerFrame() == frameSamples &&
+                      telemetry.includesRaw() == raw;
+    if (!sameFormat && !telemetry.start(channelCount, frameSamples, raw))
+    {
+        c.tx.print(F("STREAM ERR\n"));
+        return;
+    }
+    c.streaming = true;
+
+    // Potvrzení jde před první rámec a uvádí skutečný počet vzorků, klient podle něj nastaví parser
+    snprintf(reply, sizeof(reply), "STREAM ON %u %u %u\n", telemetry.getSamplesPerFrame(), channelCount, raw ? 1 : 0);
+    c.tx.print(reply);
+    printIfPinLow(reply, debugPin);
+}
+
+/**
+ * @brief Příkaz ROLE [CONTROL|OBSERVE] - vypíše nebo změní roli odesílatele
+ * @param slot Index odesílatele
+ * @param args Požadovaná role, bez parametru jen odpoví aktuální
+ */
+void EMGSystem::handleRoleCommand(uint8_t slot, char *args)
+{
+    EMGClientSlot &c = clients[slot];
+
+    if (strcmp(args, "CONTROL") == 0)
+        takeControl(slot, true);
+    else if (strcmp(args, "OBSERVE") == 0 && controlSlot == slot)
+    {
+        commandLink.stop();
+        stopRtt();
+        c.role = EMG_ROLE_OBSERVE;
+        controlSlot = noClient;
+        controlDeclared = false;
+    }
+    else if (args[0] && strcmp(args, "CONTROL") != 0 && strcmp(args, "OBSERVE") != 0)
+    {
+        c.tx.print(F("ROLE ERR\n"));
+        return;
+    }
+
+    c.tx.print(c.role == EMG_ROLE_CONTROL ? F("ROLE CONTROL\n") : F("ROLE OBSERVE\n"));
+}
+
+/**
+ * @brief Určí roli klienta podle jeho prvního řádku
+ * @param slot Index odesílatele
+ * @param line Celý první řádek (velkými písmeny)
+ */
+void EMGSystem::assignRole(uint8_t slot, const char *line)
+{
+    clients[slot].rolePending = false;
+
+    // Monitor se ohlásí ROLE OBSERVE, ROLE CONTROL vyřídí handleRoleCommand
+    if (strcmp(line, "ROLE OBSERVE") == 0 || strcmp(line, "ROLE CONTROL") == 0)
+        return;
+
+    // Klient bez ROLE je starý robot; řízení získané jen dřívějším připojením mu ustoupí
+    if (controlSlot == noClient || !controlDeclared)
+        takeControl(slot, false);
+}
+
+/**
+ * @brief Předá řízení klientovi, dosavadní řídicí klient přejde na sledování
+ * @param slot Index nového řídicího klienta
+ * @param declared Klient si řízení vyžádal příkazem ROLE CONTROL
+ */
+void EMGSystem::takeControl(uint8_t slot, bool declared)
+{
+    controlDeclared = declared;
+    if (controlSlot == slot)
+        return;
+
+    // Robot se po výpadku připojí znovu dřív, než zmizí jeho staré spojení
+    if (controlSlot != noClient)
+    {
+        commandLink.stop(); // Datagramy i PINGy patřily starému spojení
+        stopRtt();
+        clients[controlSlot].role = EMG_ROLE_OBSERVE;
+        clients[controlSlot].tx.print(F("ROLE OBSERVE\n"));
+    }
+    clients[slot].role = EMG_ROLE_CONTROL;
+    controlSlot = slot;
+    printIfPinLow(F("Klient převzal řízení"), debugPin);
+}
+
+/**
+ * @brief Časovač EMG_TIMER_ALIVE - odešle ALIVE všem klientům a naplánuje další
+ */
+void EMGSystem::sendAlive()
+{
+    timers.schedule(EMG_TIMER_ALIVE, aliveIntervalMs);
+    if (clientCount == 0)
+        return;
+
+    for (uint8_t i = 0; i < maxClients; i++)
+    {
+        if (clients[i].client)
+            clients[i].tx.print(F("ALIVE\n"));
+    }
+    printIfPinLow(F("Odesláno: ALIVE"), debugPin);
+}
+
+/**
+ * @brief Hlavní logika zpracování EMG signálů a komunikace
+ * @param frame Snímek surových hodnot ze všech kanálů
+ */
+void EMGSystem::handleLogic(const EMGFrame &frame)
+{
+    sensors.update(frame);
+    uint8_t onsetMask = sensors.getOnsetMask();
+    if (onsetMask)
+        reportOnsets(onsetMask);
+
+    // EMG1 (kanál 0) volí příkaz, EMG2 (kanál 1) ho odesílá
+    bool emg1Rising = onsetMask & 0x01;
+    bool emg2Rising = onsetMask & 0x02;
+
+    // Cooldown běží jako časovač, dokud je naplánovaný, další akce se ignoruje
+    if (emg1Rising && !timers.isActive(EMG_TIMER_SELECT_COOLDOWN))
+    {
+        cycledValue++;
+        if (cycledValue >= sizeof(commandTable) / sizeof(CommandEntry))
+        {
+            // cycledValue = 1;
+            cycledValue = 0;
+        }
+
+        timers.schedule(EMG_TIMER_SELECT_COOLDOWN, commandCooldownMs);
+
+        // printIfPinLow(F("Command selected"), debugPin);
+        printIfPinLow(F("Aktuální příkaz:"), debugPin);
+        char msg[32];
+        snprintf(msg, sizeof(msg), "%d - %s", cycledValue, getCommandLabel(cycledValue));
+        printIfPinLow(msg, debugPin);
+        const char *commandLabel = getCommandLabel(cycledValue);
+
+        // Update LCD with selected command
+        showCurrentCommand();
+    }
+
+    if (emg2Rising && !timers.isActive(EMG_TIMER_SEND_COOLDOWN))
+    {
+        /*
+        if (cycledValue == 0)
+        {
+            printIfPinLow(F("Žádný příkaz nenavolen."), debugPin);
+            return;
+        }
+        */
+        // "0" po autoStopDelayMs naplánuje sendRobotCommand
+        sendRobotCommand(cycledValue);
+        timers.schedule(EMG_TIMER_SEND_COOLDOWN, commandCooldownMs);
+        cycledValue = 0; // po odeslání příkazu chceme mít možnost hned zastavit chod robota
+    }
+}
+
+/**
+ * @brief Vypíše zpoždění detekce potvrzených nástupů (debug)
+ * @param onsetMask Maska kanálů s nástupem v aktuálním snímku
+ */
+void EMGSystem::reportOnsets(uint8_t onsetMask)
+{
+    if (digitalRead(debugPin) != LOW)
+        return;
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        if (!(onsetMask & (1 << i)))
+            continue;
+
+        const EMGOnsetStats &stats = sensors.getOnsetStats(i);
+        char msg[64];
+        snprintf(msg, sizeof(msg), "EMG%d nástup, zpoždění %u ms (průměr %lu ms)", i + 1,
+                 (unsigned)((uint32_t)stats.lastLatency * 1000 / refreshRateHz),
+                 (unsigned long)(stats.totalLatency * 1000 / refreshRateHz / stats.events));
+        printIfPinLow(msg, debugPin);
+    }
+}
+
+/**
+ * @brief Zpracuje dávku snímků čekajících v EMGAcquisition
+ */
+void EMGSystem::processSamples()
+{
+    EMGFrame frame;
+    uint8_t processed = 0;
+
+    // Jedna dávka je nejvýše kapacita bufferu, aby loop nikdy neuvízl ve zpracování
+    while (processed < acquisitionBufferFrames && emgAcquisition.read(frame))
+    {
+        if (calibrating)
+        {
+            sensors.update(frame);
+            sensors.addCalibrationSample(frame);
+        }
+        else
+        {
+            handleLogic(frame);
+        }
+
+        if (telemetry.add(sensors, frame, emgAcquisition))
+            sendTelemetry();
+        processed++;
+    }
+
+    if (processed > 0 && digitalRead(serialPrintPin) == LOW)
+    {
+        // Obálky všech kanálů oddělené čárkou (formát pro Serial Plotter)
+        char serialMsg[8 * maxSensors];
+        int len = 0;
+        for (uint8_t i = 0; i < channelCount; i++)
+            len += snprintf(serialMsg + len, sizeof(serialMsg) - len, i ? ",%.4f" : "%.4f", sensors.getEnvelope(i));
+        printIfPinLow(serialMsg, serialPrintPin);
+    }
+
+    reportOverruns();
+    reportBaselineFaults();
+}
+
+/**
+ * @brief Vypíše nová přetečení vzorkovacího bufferu (debug)
+ */
+void EMGSystem::reportOverruns()
+{
+    uint32_t overruns = emgAcquisition.getOverrunCount();
+    if (overruns == reportedOverruns)
+        return;
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Přetečení bufferu vzorků: %lu", (unsigned long)overruns);
+    printIfPinLow(msg, debugPin);
+    reportedOverruns = overruns;
+}
+
+/**
+ * @brief Vypíše kanály, u kterých dlouhá aktivita zmrazila sledování klidu (debug)
+ */
+void EMGSystem::reportBaselineFaults()
+{
+    uint8_t faults = sensors.getBaselineFaultMask();
+    uint8_t added = faults & ~reportedBaselineFaults;
+    reportedBaselineFaults = faults;
+
+    for (uint8_t i = 0; i < channelCount; i++)
+    {
+        if (!(added & (1 << i)))
+            continue;
+        char msg[64];
+        snprintf(msg, sizeof(msg), "EMG%d: dlouhá kontrakce, sledování klidu zmrazeno", i + 1);
+        printIfPinLow(msg, debugPin);
+    }
+}
+
+/**
+ * @brief Zahájí kalibraci všech senzorů na pozadí
+ */
+void EMGSystem::calibrateSensors()
+{
+    sensors.beginCalibration();
+
+    // Kalibrace začíná čerstvými vzorky, starší snímky se zahodí
+    emgAcquisition.discard();
+    calibrationProgress = 0;
+    calibrating = true;
+    initialized = false;
+
+    // Okno se dělí na 10 kroků, LCD se přepíše jen po 10 % (zápis přes I2C není zadarmo)
+    timers.schedule(EMG_TIMER_CALIBRATION, calibrationWindowMs / 10);
+}
+
+/**
+ * @brief Časovač EMG_TIMER_CALIBRATION - zobrazí průběh kalibrace a po uplynutí okna ji dokončí
+ */
+void EMGSystem::advanceCalibration()
+{
+    if (!calibrating)
+        return;
+
+    calibrationProgress += 10;
+    if (calibrationProgress >= 100)
+    {
+        finishCalibration();
+        return;
+    }
+    timers.schedule(EMG_TIMER_CALIBRATION, calibrationWindowMs / 10);
+
+    if (lcdDisplay && lcdDisplay->isReady())
+    {
+        char progressStr[17];
+        snprintf(progressStr, sizeof(progressStr), "Kalibrace %3d%%", calibrationProgress);
+        lcdDisplay->printAt(0, 1, progressStr);
+    }
+}
+
+/**
+ * @brief Dokončí kalibraci všech senzorů a povolí vyhodnocování
+ */
+void EMGSystem::finishCalibration()
+{
+    sensors.finishCalibration();
+
+    calibrating = false;
+    calibrationProgress = 100;
+    initialized = true;
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Kalibrace dokončena (%lu vzorků)", (unsigned long)sensors.getCalibrationSampleCount());
+    printIfPinLow(msg, debugPin);
+
+    // Zápis po bajtech obstará update(), smyčka na EEPROM nečeká
+    if (sensors.prepareCalibration(EEPROM_ADDR_CALIB, calibrationRecord))
+    {
+        EEPROMManager::beginBlockWrite(EEPROM_ADDR_CALIB, &calibrationRecord, sizeof(calibrationRecord));
+        printIfPinLow(F("Kalibrace se ukládá do EEPROM"), debugPin);
+    }
+    else
+        printIfPinLow(F("Kalibrace beze změny, EEPROM se nepřepisuje"), debugPin);
+
+    // After calibration, show initial command
+    if (clientCount > 0)
+        showCurrentCommand();
+    else if (serverStarted)
+        showWaitingForClient();
+}
+
+/**
+ * @brief Zobrazí aktuálně zvolený příkaz na LCD
+ */
+void EMGSystem::showCurrentCommand()
+{
+    if (!lcdDisplay || !lcdDisplay->isReady())
+        return;
+
+    lcdDisplay->clear();
+    char commandStr[32];
+    snprintf(commandStr, sizeof(commandStr), "Prikaz %d", cycledValue);
+    lcdDisplay->printAt(0, 0, commandStr);
+
+    // Show first 16 characters of command label
+    char commandLabel[17];
+    const char *fullLabel = getCommandLabel(cycledValue);
+    strncpy(commandLabel, fullLabel, 16);
+    commandLabel[16] = '\0';
+    lcdDisplay->printAt(0, 1, commandLabel);
+}
+
+/**
+ * @brief Zobrazí na LCD výzvu k připojení klienta s IP adresou
+ */
+void EMGSystem::showWaitingForClient()
+{
+    if (!lcdDisplay || !lcdDisplay->isReady())
+        return;
+
+    lcdDisplay->clear();
+    lcdDisplay->printAt(0, 0, F("Cekam na klienta"));
+    IPAddress ip = WiFi.localIP();
+    char ipStr[17];
+    snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+    lcdDisplay->printAt(0, 1, ipStr);
+}
+
+/**
+ * @brief Inicializuje senzory (kalibruje, pokud nejsou k dispozici sledované prahy)
+ */
+void EMGSystem::initSensors()
+{
+    cleanupSensors();
+    cycledValue = 1;
+
+    if (sensors.isCalibrated() && sensors.getChannelCount() == channelCount)
+    {
+        // Prahy se v klidu průběžně sledují, nové připojení kalibraci nepotřebuje
+        sensors.resync();
+        emgAcquisition.discard();
+        initialized = true;
+        printIfPinLow(F("Kalibrace přeskočena, použity sledované prahy."), debugPin);
+        showCurrentCommand();
+    }
+    else
+    {
+        sensors.begin(channelCount);
+        calibrateSensors();
+    }
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Systém inicializován pro %d EMG senzory.", channelCount);
+    printIfPinLow(msg, debugPin);
+}
+
+/**
+ * @brief Přijme nového klienta do volného slotu (první připojený inicializuje senzory)
+ */
+void EMGSystem::acceptClient()
+{
+    // Dotaz prochází všechny sockety modulu, nový klient počká nejvýše clientStatusIntervalMs
+    unsigned long now = millis();
+    if (now - lastAcceptTime < clientStatusIntervalMs)
+        return;
+    lastAcceptTime = now;
+
+    // server.available() vrací i už známé klienty, kteří mají data ke čtení
+    WiFiClient incoming = server.available();
+    if (!incoming)
+        return;
+
+    uint8_t slot = noClient;
+    for (uint8_t i = 0; i < maxClients; i++)
+    {
+        if (clients[i].client && clients[i].client == incoming)
+            return;
+        if (!clients[i].client && slot == noClient)
+            slot = i;
+    }
+
+    if (slot == noClient)
+    {
+        incoming.print(F("BUSY\n"));
+        incoming.stop();
+        printIfPinLow(F("Klient odmítnut, všechny sloty jsou obsazené."), debugPin);
+        return;
+    }
+
+    // Role se určí až podle prvního řádku: monitory se ohlásí ROLE OBSERVE, ostatní dostanou řízení
+    EMGClientSlot &c = clients[slot];
+    c.client = incoming;
+    c.tx.clear();
+    c.parser.reset();
+    c.streaming = false;
+    c.heartbeat = false;
+    c.lastRxMs = c.lastStatusMs = now;
+    c.seenDroppedBytes = c.tx.getStats().droppedBytes;
+    c.role = EMG_ROLE_OBSERVE;
+    c.rolePending = true;
+    clientCount++;
+
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Klient %d připojen", slot);
+    printIfPinLow(msg, debugPin);
+
+    // Senzory běží, dokud je připojen kdokoli; další klient kalibraci nespouští
+    if (wasClientConnected)
+        return;
+    printIfPinLow(F("Klient připojen - inicializuji senzory"), debugPin);
+
+    // Update LCD with client connected
+    if (lcdDisplay && lcdDisplay->isReady())
+    {
+        lcdDisplay->clear();
+        lcdDisplay->printAt(0, 0, F("Klient pripojen"));
+        lcdDisplay->printAt(0, 1, F("Kalibrace..."));
+    }
+
+    // Kalibrace běží na pozadí, příkaz se zobrazí po jejím dokončení; kalibrace ze startu se nepřerušuje
+    if (calibrating)
+        cycledValue = 1;
+    else
+        initSensors();
+    wasClientConnected = true;
+
+    // Po výpadku sítě se pokračuje naposledy zvoleným příkazem
+    if (resumeCommand > 0)
+    {
+        cycledValue = resumeCommand;
+        resumeCommand = 0;
+        if (initialized)
+            showCurrentCommand();
+    }
+}
+
+/**
+ * @brief Uzavře sloty klientů, kteří ztratili spojení nebo přestali posílat heartbeat
+ */
+void EMGSystem::checkClients()
+{
+    unsigned long now = millis();
+
+    for (uint8_t i = 0; i < maxClients; i++)
+    {
+        EMGClientSlot &c = clients[i];
+        if (!c.client)
+            continue;
+
+        char msg[40];
+        if (c.heartbeat && now - c.lastRxMs > clientTimeoutMs)
+        {
+            snprintf(msg, sizeof(msg), "Klient %d neodpovídá.", i);
+            printIfPinLow(msg, debugPin);
+            closeClient(i);
+            continue;
+        }
+
+        // Nepřijatý zápis napovídá zavřenému spojení, jinak stačí občasný dotaz
+        uint32_t dropped = c.tx.getStats().droppedBytes;
+        if (dropped == c.seenDroppedBytes && now - c.lastStatusMs < clientStatusIntervalMs)
+            continue;
+        c.seenDroppedBytes = dropped;
+        c.lastStatusMs = now;
+
+        if (c.client.connected())
+            continue;
+        snprintf(msg, sizeof(msg), "Klient %d ztratil spojení.", i);
+        printIfPinLow(msg, debugPin);
+        closeClient(i);
+    }
+}
+
+/**
+ * @brief Odešle zprávu řídicímu klientovi hned, bez čekání na konec průchodu
+ * @param msg Zpráva včetně '\n'
+ * @return False pokud řídicí klient není připojen
+ */
+bool EMGSystem::sendToControl(const char *msg)
+{
+    if (controlSlot == noClient)
+        return false;
+
+    clients[controlSlot].tx.print(msg);
+    clients[controlSlot].tx.flush(true); // Příkaz pro robota nečeká na konec průchodu smyčkou
+    return true;
+}
+
+/**
+ * @brief Odešle příkaz robotovi (UDP, je-li zapnuté, a TCP)
+ * @param command Kód příkazu
+ * @return False pokud řídicí klient není připojen
  */
-void EMGSystem::handleClientMessages()
+bool EMGSystem::sendRobotCommand(int command)
 {
-    if (client.available())
-    {
-        char message[64];
-        int msgLen = client.readBytesUntil('\n', message, sizeof(message) - 1);
-        if (msgLen > 0)
-        {
-            message[msgLen] = '\0';
+    if (controlSlot == noClient)
+        return false;
 
-            // Trim whitespace and convert to uppercase
-            while (msgLen > 0 && (message[msgLen - 1] == ' ' || message[msgLen - 1] == '\r'))
-            {
-                message[--msgLen] = '\0';
-            }
+    // Datagram jde první, jeho časová značka platí i pro řádek přes TCP
+    commandLink.send(command);
 
-            // Simple uppercase conversion for ASCII
-            for (int i = 0; i < msgLen; i++)
-            {
-                if (message[i] >= 'a' && message[i] <= 'z')
-                    message[i] = message[i] - 'a' + 'A';
-            }
+    char msg[8];
+    snprintf(msg, sizeof(msg), "%d\n", command);
+    sendToControl(msg);
+    printIfPinLow(msg, debugPin);
 
-            if (strcmp(message, "DISCONNECT") == 0)
-            {
-                printIfPinLow(F("DISCONNECT příkaz přijat. Ukončuji spojení..."), debugPin);
-                cleanupClient();
-            }
-        }
-    }
+    // Nový příkaz posune automatické zastavení, "0" ho ruší
+    if (command != 0 && autoStopDelayMs > 0)
+        timers.schedule(EMG_TIMER_AUTO_STOP, autoStopDelayMs);
+    else
+        timers.cancel(EMG_TIMER_AUTO_STOP);
+    return true;
 }
 
 /**
- * @brief Odesílá ALIVE zprávu v nastaveném intervalu
+ * @brief Zapíše plný rámec telemetrie všem odběratelům
  */
-void EMGSystem::sendAliveIfNeeded()
+void EMGSystem::sendTelemetry()
 {
-    unsigned long now = millis();
-    if (now - lastAliveTime >= aliveIntervalMs)
+    // Rámec je zakódovaný jednou, každý odběratel dostane kopii do svého bufferu
+    for (uint8_t i = 0; i < maxClients; i++)
     {
-        client.print(F("ALIVE\n"));
-        printIfPinLow(F("Odesláno: ALIVE"), debugPin);
-        lastAliveTime = now;
+        if (clients[i].client && clients[i].streaming)
+            telemetry.send(clients[i].tx);
     }
+    telemetry.finish();
 }
 
 /**
- * @brief Hlavní logika zpracování EMG signálů a komunikace
+ * @brief Vypne telemetrii, pokud ji už nikdo neodebírá
  */
-void EMGSystem::handleLogic()
+void EMGSystem::updateTelemetrySubscribers()
 {
-    static unsigned long zeroSendTime = 0;
-    static bool sendZeroPending = false;
-    static const unsigned int sendZeroDelay = 500; // 0.5 sekund pro odeslání "0"
-
-    sensors[0]->updateEnvelope();
-    sensors[1]->updateEnvelope();
-
-    bool emg1Active = sensors[0]->isActive();
-    bool emg2Active = sensors[1]->isActive();
-    unsigned long now = millis();
-
-    // Check if we need to send "0" (non-blocking, checked every loop iteration)
-    /*
-    if (sendZeroPending && now >= zeroSendTime)
+    for (uint8_t i = 0; i < maxClients; i++)
     {
-        client.print(F("0\n"));
-        printIfPinLow(F("0"), debugPin);
-        sendZeroPending = false;
+        if (clients[i].client && clients[i].streaming)
+            return;
     }
-    */
-
-    if (emg1Active && !emg1LastActive && (now - lastCycleTime >= cooldown))
-    {
-        cycledValue++;
-        if (cycledValue >= sizeof(commandTable) / sizeof(CommandEntry))
-        {
-            // cycledValue = 1;
-            cycledValue = 0;
-        }
-
-        lastCycleTime = now;
+    telemetry.stop();
+}
 
-        // printIfPinLow(F("Command selected"), debugPin);
-        printIfPinLow(F("Aktuální příkaz:"), debugPin);
-        char msg[32];
-        snprintf(msg, sizeof(msg), "%d - %s", cycledValue, getCommandLabel(cycledValue));
-        printIfPinLow(msg, debugPin);
-        const char *commandLabel = getCommandLabel(cycledValue);
+/**
+ * @brief Vyprázdní výstupní buffery všech klientů (řídicí klient první) a zavře ty, kterým data neodešla
+ */
+void EMGSystem::flushClients()
+{
+    if (controlSlot != noClient)
+        clients[controlSlot].tx.endTick();
 
-        // Update LCD with selected command
-        if (lcdDisplay && lcdDisplay->isReady() && client && client.connected())
-        {
-            lcdDisplay->clear();
-            char commandStr[32];
-            snprintf(commandStr, sizeof(commandStr), "Prikaz %d", cycledValue);
-            lcdDisplay->printAt(0, 0, commandStr);
-
-            // Show first 16 characters of command label
-            char commandLabel[17];
-            const char *fullLabel = getCommandLabel(cycledValue);
-            strncpy(commandLabel, fullLabel, 16);
-            commandLabel[16] = '\0';
-            lcdDisplay->printAt(0, 1, commandLabel);
-        }
+    for (uint8_t i = 0; i < maxClients; i++)
+    {
+        if (i != controlSlot && clients[i].client)
+            clients[i].tx.endTick();
     }
 
-    if (emg2Active && !emg2LastActive && (now - lastSendTime >= cooldown))
+    // Po nedoručených datech by klient četl useknuté zprávy, spojení se proto zavře
+    for (uint8_t i = 0; i < maxClients; i++)
     {
-        /*
-        if (cycledValue == 0)
+        if (clients[i].client && clients[i].tx.hasFailed())
         {
-            printIfPinLow(F("Žádný příkaz nenavolen."), debugPin);
-            return;
+            char msg[48];
+            snprintf(msg, sizeof(msg), "Klient %d nepřijal data, odpojen", i);
+            printIfPinLow(msg, debugPin);
+            closeClient(i);
         }
-        */
-        char msg[8];
-        snprintf(msg, sizeof(msg), "%d\n", cycledValue);
-        client.print(msg);
-        printIfPinLow(msg, debugPin);
-        lastSendTime = now;
-        cycledValue = 0; // po odeslání příkazu chceme mít možnost hned zastavit chod robota
-
-        // Schedule "0" to be sent after 0.5 seconds
-        /*
-        zeroSendTime = now + sendZeroDelay;
-        sendZeroPending = true;
-        */
-    }
-
-    emg1LastActive = emg1Active;
-    emg2LastActive = emg2Active;
-
-    if (digitalRead(serialPrintPin) == LOW)
-    {
-        char serialMsg[24];
-        snprintf(serialMsg, sizeof(serialMsg), "%.4f,%.4f", sensors[0]->getEnvelope(), sensors[1]->getEnvelope());
-        printIfPinLow(serialMsg, serialPrintPin);
     }
 }
 
 /**
- * @brief Kalibruje oba senzory
- */
-void EMGSystem::calibrateSensors()
-{
-    for (int i = 0; i < 2; i++)
-        sensors[i]->calibrate();
-    initialized = true;
-}
-
-/**
- * @brief Inicializuje senzory
+ * @brief Zneplatní stav senzorů (nová inicializace vyžaduje kalibraci)
  */
-void EMGSystem::initSensors()
+void EMGSystem::cleanupSensors()
 {
-    cleanupSensors();
-    for (int i = 0; i < 2; i++)
-        sensors[i] = new EMGSensor(emgPins[i]);
-    calibrateSensors();
-    cycledValue = 1;
-    printIfPinLow(F("Systém inicializován pro 2 EMG senzory."), debugPin);
+    initialized = false;
+    calibrating = false;
+    timers.cancel(EMG_TIMER_CALIBRATION);
 }
 
 /**
- * @brief Zpracuje nového klienta
+ * @brief Odpojí jednoho klienta, po posledním resetuje systém
+ * @param slot Index klienta
  */
-void EMGSystem::handleNewClient()
+void EMGSystem::closeClient(uint8_t slot)
 {
-    client = server.available();
-    if (!client)
+    EMGClientSlot &c = clients[slot];
+    if (!c.client)
         return;
-    printIfPinLow(F("Klient připojen - inicializuji senzory"), debugPin);
-
-    // Update LCD with client connected
-    if (lcdDisplay && lcdDisplay->isReady())
-    {
-        lcdDisplay->clear();
-        lcdDisplay->printAt(0, 0, F("Klient pripojen"));
-        lcdDisplay->printAt(0, 1, F("Kalibrace..."));
-    }
 
-    initSensors();
-    wasClientConnected = true;
+    c.tx.flush(false);
+    c.tx.clear();
+    c.parser.reset();
+    c.streaming = false;
+    c.client.stop();
+    clientCount--;
+    updateTelemetrySubscribers();
 
-    // After calibration, show initial command
-    if (lcdDisplay && lcdDisplay->isReady())
+    // Odchod robota neruší monitory, řízení převezme další ROLE CONTROL nebo nový klient bez ROLE
+    if (slot == controlSlot)
     {
-        lcdDisplay->clear();
-        char commandStr[32];
-        snprintf(commandStr, sizeof(commandStr), "Prikaz %d", cycledValue);
-        lcdDisplay->printAt(0, 0, commandStr);
-
-        // Show first 16 characters of command label
-        char commandLabel[17];
-        const char *fullLabel = getCommandLabel(cycledValue);
-        strncpy(commandLabel, fullLabel, 16);
-        commandLabel[16] = '\0';
-        lcdDisplay->printAt(0, 1, commandLabel);
+        controlSlot = noClient;
+        controlDeclared = false;
+        commandLink.stop();
+        stopRtt();
     }
+
+    if (clientCount == 0)
+        cleanupClient();
 }
 
 /**
- * @brief Uvolní paměť senzorů
+ * @brief Zahodí všechna spojení bez odesílání a bez úklidu po posledním klientovi (výpadek sítě)
  */
-void EMGSystem::cleanupSensors()
+void EMGSystem::dropClients()
 {
-    for (int i = 0; i < 2; i++)
+    // Socket už neexistuje: nic se neodesílá, prahy se neukládají a LCD ukazuje stav WiFi
+    for (uint8_t i = 0; i < maxClients; i++)
     {
-        if (sensors[i] != nullptr)
-        {
-            delete sensors[i];
-            sensors[i] = nullptr;
-        }
+        EMGClientSlot &c = clients[i];
+        c.tx.clear();
+        c.parser.reset();
+        c.streaming = false;
+        if (c.client)
+            c.client.stop();
     }
-    initialized = false;
+    clientCount = 0;
+    telemetry.stop();
+
+    if (controlSlot != noClient)
+    {
+        controlSlot = noClient;
+        controlDeclared = false;
+        commandLink.stop();
+        stopRtt();
+    }
+
+    // Senzory zůstanou nakalibrované, první nový klient je jen znovu synchronizuje
+    wasClientConnected = false;
 }
 
 /**
- * @brief Odpojí klienta a resetuje systém
+ * @brief Resetuje systém po odchodu posledního klienta
  */
 void EMGSystem::cleanupClient()
 {
-    client.stop();
     cleanupSensors();
     printIfPinLow(F("Klient odpojen a systém resetován."), debugPin);
     wasClientConnected = false;
+
+    // Update LCD when client disconnects
+    showWaitingForClient();
 }
 
 /**
@@ -255,53 +1197,41 @@ void EMGSystem::cleanupClient()
  */
 void EMGSystem::update()
 {
-    static bool noClientPrinted = false;
     static bool notInitializedPrinted = false;
 
-    if (!client || !client.connected())
+    emgAcquisition.poll();
+    runTimers();
+    EEPROMManager::serviceBlockWrite();
+    if (serverStarted)
     {
-        if (wasClientConnected)
-        {
-            printIfPinLow(F("Klient ztratil spojení."), debugPin);
-            cleanupClient();
+        checkClients();
+        acceptClient();
+    }
 
-            // Update LCD when client disconnects
-            if (lcdDisplay && lcdDisplay->isReady())
-            {
-                lcdDisplay->clear();
-                lcdDisplay->printAt(0, 0, F("Cekam na klienta"));
-                IPAddress ip = WiFi.localIP();
-                char ipStr[17];
-                snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-                lcdDisplay->printAt(0, 1, ipStr);
-            }
-        }
+    if (clientCount == 0)
+    {
+        // Kalibrace ze startu běží i bez klienta, jinak se vzorky zahazují
+        if (calibrating)
+            processSamples();
+        else
+            emgAcquisition.discard();
 
-        if (!noClientPrinted)
+        if (serverStarted && !noClientPrinted)
         {
             printIfPinLow(F("Žádný klient není připojen."), debugPin);
             noClientPrinted = true;
 
             // Show server IP when waiting for client
-            if (lcdDisplay && lcdDisplay->isReady())
-            {
-                lcdDisplay->clear();
-                lcdDisplay->printAt(0, 0, F("Cekam na klienta"));
-                IPAddress ip = WiFi.localIP();
-                char ipStr[17];
-                snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-                lcdDisplay->printAt(0, 1, ipStr);
-            }
+            showWaitingForClient();
         }
-
-        handleNewClient();
         return;
     }
     else
         noClientPrinted = false;
 
-    if (!initialized)
+    if (!initialized && !calibrating)
     {
+        emgAcquisition.discard();
         if (!notInitializedPrinted)
         {
             printIfPinLow(F("Senzory nejsou inicializovány."), debugPin);
@@ -312,9 +1242,12 @@ void EMGSystem::update()
     else
         notInitializedPrinted = false;
 
-    handleLogic();
+    processSamples();
     handleClientMessages();
-    // sendAliveIfNeeded();
+    commandLink.poll();
+
+    // Vše, co průchod vyprodukoval, odejde jedním zápisem na klienta
+    flushClients();
 }
 
 /**
@@ -325,6 +1258,22 @@ bool EMGSystem::isInitialized() const
     return initialized;
 }
 
+/**
+ * @brief Vrací příznak probíhající kalibrace
+ */
+bool EMGSystem::isCalibrating() const
+{
+    return calibrating;
+}
+
+/**
+ * @brief Vrací průběh kalibrace v procentech
+ */
+uint8_t EMGSystem::getCalibrationProgress() const
+{
+    return calibrationProgress;
+}
+
 /**
  * @brief Nastaví pointer na LCD displej
  * @param lcd Pointer na LCD displej
@@ -349,29 +1298,260 @@ int EMGSystem::getCurrentCommand() const
  */
 bool EMGSystem::sendCurrentCommand()
 {
-    if (!initialized || !client || !client.connected() || cycledValue == 0)
+    return sendCommand(cycledValue);
+}
+
+/**
+ * @brief Odešle robotovi zadaný příkaz (POST /send-command), platí cooldown jako pro EMG2
+ * @param code Kód příkazu z commandTable (1 až 8)
+ * @return True pokud byl příkaz odeslán úspěšně
+ */
+bool EMGSystem::sendCommand(uint8_t code)
+{
+    if (!initialized || controlSlot == noClient || code == 0 || strcmp(getCommandLabel(code), "UNKNOWN") == 0)
     {
         return false;
     }
 
-    unsigned long now = millis();
-    if (now - lastSendTime < cooldown)
+    if (timers.isActive(EMG_TIMER_SEND_COOLDOWN))
     {
         return false; // Still in cooldown period
     }
 
-    // Send the command
-    char msg[8];
-    snprintf(msg, sizeof(msg), "%d\n", cycledValue);
-    client.print(msg);
+    // Send the command ("0" after autoStopDelayMs is scheduled the same way as for EMG2)
     printIfPinLow(F("API: Command sent to TCP client"), debugPin);
+    sendRobotCommand(code);
+    timers.schedule(EMG_TIMER_SEND_COOLDOWN, commandCooldownMs);
+
+    return true;
+}
+
+/**
+ * @brief Vrací počet snímků nasnímaných od spuštění vzorkování
+ */
+uint32_t EMGSystem::getSampleCount() const
+{
+    return emgAcquisition.getFrameCount();
+}
+
+/**
+ * @brief Vrací počet snímků čekajících na zpracování
+ */
+uint8_t EMGSystem::getPendingFrames() const
+{
+    return emgAcquisition.available();
+}
+
+/**
+ * @brief Vrací počet snímků zahozených kvůli přetečení bufferu
+ */
+uint32_t EMGSystem::getOverrunCount() const
+{
+    return emgAcquisition.getOverrunCount();
+}
+
+/**
+ * @brief Zahodí uloženou i sledovanou kalibraci a spustí novou (příkaz RECAL)
+ */
+void EMGSystem::recalibrate()
+{
+    if (!wasClientConnected)
+        return;
+
+    sensors.begin(channelCount);
+    calibrateSensors();
+
+    if (lcdDisplay && lcdDisplay->isReady())
+    {
+        lcdDisplay->clear();
+        lcdDisplay->printAt(0, 0, F("Rekalibrace"));
+        lcdDisplay->printAt(0, 1, F("Kalibrace..."));
+    }
+}
+
+/**
+ * @brief Vrací čítače výstupního bufferu klienta (bajty, vyprázdnění, volání client.write)
+ * @param slot Index klienta (0 až maxClients - 1)
+ */
+const TxStats &EMGSystem::getTxStats(uint8_t slot) const
+{
+    return clients[slot < maxClients ? slot : 0].tx.getStats();
+}
+
+/**
+ * @brief Vrací počet připojených klientů
+ */
+uint8_t EMGSystem::getClientCount() const
+{
+    return clientCount;
+}
+
+/**
+ * @brief Vrací příznak připojeného řídicího klienta (robota)
+ */
+bool EMGSystem::hasControlClient() const
+{
+    return controlSlot != noClient;
+}
+
+/**
+ * @brief Vrací stav binárního proudu telemetrie (čítače rámců a bajtů)
+ */
+const EMGTelemetry &EMGSystem::getTelemetry() const
+{
+    return telemetry;
+}
+
+/**
+ * @brief Vrací histogram odezvy řídicího klienta na PING zařízení
+ */
+const RttHistogram &EMGSystem::getRttHistogram() const
+{
+    return rtt;
+}
+
+/**
+ * @brief Vrací čítače časového kola (spuštěné a opožděné časovače)
+ */
+const TimerStats &EMGSystem::getTimerStats() const
+{
+    return timers.getStats();
+}
+
+/**
+ * @brief Nastaví počet používaných EMG kanálů
+ * @param count Počet kanálů (1 až maxSensors)
+ * @return False pokud je počet mimo rozsah
+ */
+bool EMGSystem::setChannelCount(uint8_t count)
+{
+    if (count == 0 || count > maxSensors)
+        return false;
+    if (count == channelCount)
+        return true;
+
+    channelCount = count;
+    if (sampling)
+        emgAcquisition.begin(channelCount, refreshRateHz);
+
+    // Rámce mají pevný počet kanálů, běžící proud pokračuje s novým počtem
+    if (telemetry.isEnabled())
+        telemetry.start(channelCount, telemetry.getSamplesPerFrame(), telemetry.includesRaw());
+
+    // Prahy ostatních kanálů nejsou nakalibrované, připojený klient projde kalibrací znovu
+    sensors.begin(channelCount);
+    if (wasClientConnected)
+        initSensors();
+
+    char msg[40];
+    snprintf(msg, sizeof(msg), "Počet EMG kanálů: %d", channelCount);
     printIfPinLow(msg, debugPin);
-    lastSendTime = now;
+    return true;
+}
+
+/**
+ * @brief Vrací počet používaných EMG kanálů
+ */
+uint8_t EMGSystem::getChannelCount() const
+{
+    return channelCount;
+}
+
+/**
+ * @brief Vrací statistiku zpoždění detekce nástupu kanálu
+ * @param channel Index kanálu
+ */
+const EMGOnsetStats &EMGSystem::getOnsetStats(uint8_t channel) const
+{
+    return sensors.getOnsetStats(channel);
+}
+
+/**
+ * @brief Vrací změřenou dobu filtračních řetězců jednoho snímku
+ */
+const EMGFilterProbe &EMGSystem::getFilterProbe() const
+{
+    return sensors.getFilterProbe();
+}
+
+/**
+ * @brief Vrací odhad doby filtračních řetězců jednoho snímku podle cyklů z EMGFilter.h (µs)
+ */
+uint16_t EMGSystem::getFilterEstimateUs() const
+{
+    return sensors.getFilterEstimateUs();
+}
 
-    // Schedule "0" to be sent after 0.5 seconds (same as EMG2 behavior)
-    static unsigned long zeroSendTime = now + 500;
-    // Note: The zero sending logic is handled in handleLogic(),
-    // but we need to ensure it gets triggered
+/**
+ * @brief Nastaví způsob výpočtu obálky všech kanálů
+ * @param mode EMA, MAV nebo RMS
+ * @return False pokud okenní režimy nejsou přeloženy (EMG_WINDOW_ENVELOPE)
+ */
+bool EMGSystem::setEnvelopeMode(EMGEnvelopeMode mode)
+{
+    if (mode == sensors.getEnvelopeMode())
+        return true;
 
+    if (!sensors.setEnvelopeMode(mode))
+        return false;
+    if (wasClientConnected)
+        initSensors();
     return true;
 }
+
+/**
+ * @brief Vrací používaný způsob výpočtu obálky
+ */
+EMGEnvelopeMode EMGSystem::getEnvelopeMode() const
+{
+    return sensors.getEnvelopeMode();
+}
+
+/**
+ * @brief Vrací horní práh kanálu (nástup aktivity)
+ * @param channel Index kanálu
+ * @return Práh ve voltech
+ */
+float EMGSystem::getThresholdUpper(uint8_t channel) const
+{
+    return channel < channelCount ? sensors.getThresholdUpper(channel) : 0.0;
+}
+
+/**
+ * @brief Vrací dolní práh kanálu (konec aktivity)
+ * @param channel Index kanálu
+ * @return Práh ve voltech
+ */
+float EMGSystem::getThresholdLower(uint8_t channel) const
+{
+    return channel < channelCount ? sensors.getThresholdLower(channel) : 0.0;
+}
+
+/**
+ * @brief Vrací sledovanou klidovou úroveň obálky kanálu
+ * @param channel Index kanálu
+ * @return Klidová úroveň ve voltech
+ */
+float EMGSystem::getBaseline(uint8_t channel) const
+{
+    return channel < channelCount ? sensors.getBaseline(channel) : 0.0;
+}
+
+/**
+ * @brief Zjistí, zda dlouhá kolísající aktivita zmrazila sledování klidu kanálu
+ * @param channel Index kanálu
+ */
+bool EMGSystem::hasBaselineFault(uint8_t channel) const
+{
+    return channel < channelCount && (sensors.getBaselineFaultMask() & (1 << channel));
+}
+
+/**
+ * @brief Vrací aktuální hodnotu obálky kanálu
+ * @param channel Index kanálu
+ * @return Hodnota obálky ve voltech
+ */
+float EMGSystem::getEnvelope(uint8_t channel) const
+{
+    return channel < channelCount ? sensors.getEnvelope(channel) : 0.0;
+}
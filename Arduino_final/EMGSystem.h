@@ -3,9 +3,70 @@
 
 #include <Arduino.h>
 #include <WiFiNINA.h>
-#include "EMGSensor.h"
+#include "EMGSensorBank.h"
+#include "EMGAcquisition.h"
+#include "EMGFilter.h"
+#include "EMGTelemetry.h"
+#include "EMGCommandLink.h"
+#include "TxBuffer.h"
+#include "LineParser.h"
+#include "RttHistogram.h"
+#include "TimerWheel.h"
 #include "LCDDisplay.h"
 
+/**
+ * @brief Role klienta TCP serveru EMG
+ */
+enum EMGClientRole : uint8_t
+{
+    EMG_ROLE_CONTROL, // Robot - dostává příkazy, smí měnit nastavení
+    EMG_ROLE_OBSERVE  // Monitor - jen sleduje (STREAM, PING)
+};
+
+/**
+ * @struct EMGClientSlot
+ * @brief Spojení jednoho klienta s vlastním výstupním bufferem a parserem řádků
+ */
+struct EMGClientSlot
+{
+    WiFiClient client;             // Spojení (neplatné = volný slot)
+    uint8_t txData[clientTxBytes]; // Paměť výstupního bufferu
+    TxBuffer tx;                   // Zprávy pro klienta, odeslané jedním zápisem za průchod smyčkou
+    LineParser parser;             // Rozpracovaný řádek příkazu
+    EMGClientRole role;            // Řízení nebo sledování
+    bool rolePending;              // Role se určí podle prvního řádku
+    bool streaming;                // Odebírá binární proud telemetrie
+    bool heartbeat;                // Klient posílá ALIVE, hlídá se clientTimeoutMs
+    unsigned long lastRxMs;        // Čas posledních přijatých dat (millis)
+    unsigned long lastStatusMs;    // Čas posledního dotazu na stav socketu (millis)
+    uint32_t seenDroppedBytes;     // Čítač nepřijatých bajtů při poslední kontrole
+
+    EMGClientSlot()
+        : tx(client, txData, sizeof(txData)), role(EMG_ROLE_OBSERVE), rolePending(false), streaming(false),
+          heartbeat(false), lastRxMs(0), lastStatusMs(0), seenDroppedBytes(0)
+    {
+    }
+    EMGClientSlot(const EMGClientSlot &) = delete; // tx drží referenci na vlastní client a txData
+    EMGClientSlot &operator=(const EMGClientSlot &) = delete;
+};
+
+/**
+ * @brief Časovače odložených akcí EMGSystemu (identifikátory v TimerWheel)
+ */
+enum EMGTimerId : uint8_t
+{
+    EMG_TIMER_AUTO_STOP,       // Odeslání "0" po příkazu robotovi
+    EMG_TIMER_SELECT_COOLDOWN, // Cooldown volby příkazu (EMG1)
+    EMG_TIMER_SEND_COOLDOWN,   // Cooldown odeslání příkazu (EMG2)
+    EMG_TIMER_ALIVE,           // Heartbeat ALIVE všem klientům
+    EMG_TIMER_RTT_PING,        // PING řídicímu klientovi
+    EMG_TIMER_RTT_TIMEOUT,     // Čekání na PONG
+    EMG_TIMER_CALIBRATION,     // Krok průběhu kalibrace (po 10 %)
+    EMG_TIMER_COUNT
+};
+
+static_assert(EMG_TIMER_COUNT <= timerWheelCapacity, "Casovace EMGSystemu se nevejdou do casoveho kola");
+
 /**
  * @class EMGSystem
  * @brief Třída pro správu EMG systému a komunikace
@@ -13,57 +74,309 @@
 class EMGSystem
 {
 private:
-    EMGSensor *sensors[2];               // Pole dvou EMG senzorů
-    WiFiServer server;                   // TCP server
-    WiFiClient client;                   // TCP klient
-    bool initialized = false;            // Příznak inicializace systému
-    long lastAliveTime = 0;              // Čas poslední ALIVE zprávy
-    int cycledValue = 0;                 // Aktuálně zvolená hodnota příkazu
-    bool emg1LastActive = false;         // Stav aktivity EMG1 v předchozím cyklu
-    bool emg2LastActive = false;         // Stav aktivity EMG2 v předchozím cyklu
-    unsigned long lastCycleTime = 0;     // Čas posledního cyklu volby
-    unsigned long lastSendTime = 0;      // Čas posledního odeslání
-    const unsigned long cooldown = 1000; // Cooldown mezi akcemi v ms
-    bool wasClientConnected = false;     // Příznak předchozího připojení klienta
-    LCDDisplay *lcdDisplay;              // Pointer na LCD displej
-
-    /**
-     * @brief Zpracuje zprávy od klienta
+    /**
+     * @struct ClientCommand
+     * @brief Položka tabulky textových příkazů klienta
+     */
+    struct ClientCommand
+    {
+        const char *name;                                     // Název příkazu (velkými písmeny)
+        void (EMGSystem::*handler)(uint8_t slot, char *args); // Obsluha, dostane odesílatele a parametry za názvem
+        bool controlOnly;                                     // Smí jen řídicí klient (robot)
+    };
+
+    typedef void (EMGSystem::*TimerHandler)(); // Obsluha vypršelého časovače
+
+    static const TimerHandler timerHandlers[EMG_TIMER_COUNT]; // Obsluhy podle EMGTimerId (nullptr = jen cooldown)
+    static const ClientCommand clientCommands[]; // Tabulka příkazů (DISCONNECT, PING, PONG, ALIVE, STREAM, ROLE, RECAL, SET, UDP, RTT, TIMERS)
+    static const uint8_t noClient = 0xFF;        // Index slotu, když klient chybí
+
+    EMGSensorBank sensors;                            // Stav všech EMG kanálů (struktura polí)
+    EMGCalibrationRecord calibrationRecord;           // Záznam kalibrace, který update() postupně zapisuje do EEPROM
+    uint8_t channelCount;                             // Počet používaných EMG kanálů
+    WiFiServer server;                                // TCP server
+    EMGClientSlot clients[maxClients];                // Připojení klienti (robot a monitory)
+    uint8_t clientCount = 0;                          // Počet obsazených slotů
+    uint8_t controlSlot = noClient;                   // Slot řídicího klienta, kterému jdou příkazy
+    bool controlDeclared = false;                     // Řídicí klient si řízení vyžádal (ROLE CONTROL)
+    bool initialized = false;                         // Příznak inicializace systému
+    unsigned long lastAcceptTime = 0;                 // Čas posledního dotazu na nová spojení
+    int cycledValue = 0;                              // Aktuálně zvolená hodnota příkazu
+    bool wasClientConnected = false;                  // Příznak, že je připojen aspoň jeden klient
+    bool serverStarted = false;                       // Příznak spuštěného TCP serveru
+    bool sampling = false;                            // Příznak spuštěného vzorkování
+    bool noClientPrinted = false;                     // Výzva k připojení klienta už je vypsaná
+    int resumeCommand = 0;                            // Příkaz zvolený před výpadkem sítě (0 = žádný)
+    LCDDisplay *lcdDisplay;                           // Pointer na LCD displej
+    uint32_t reportedOverruns = 0;                    // Počet přetečení bufferu při posledním výpisu
+    uint8_t reportedBaselineFaults = 0;               // Maska chyb klidové úrovně při posledním výpisu
+    bool calibrating = false;                         // Probíhá kalibrace na pozadí
+    uint8_t calibrationProgress = 0;                  // Průběh kalibrace v procentech
+    EMGTelemetry telemetry;                           // Binární proud obálek, jeden rámec pro všechny odběratele (STREAM)
+    EMGCommandLink commandLink;                       // Kopie příkazů pro robota přes UDP (příkaz UDP)
+    RttHistogram rtt;                                 // Odezva řídicího klienta na PING zařízení (příkaz RTT)
+    bool rttEnabled = false;                          // Řídicí klient odpovídá na PING zařízení
+    uint16_t rttToken = 0;                            // Token posledního PINGu
+    unsigned long rttSentUs = 0;                      // Čas odeslání posledního PINGu (micros)
+    TimerWheel timers;                                // Odložené akce (EMGTimerId)
+
+    /**
+     * @brief Zpracuje zprávy od všech klientů (neblokující, omezeno clientRxBudgetBytes/Us)
      */
     void handleClientMessages();
 
     /**
-     * @brief Odesílá ALIVE zprávu v nastaveném intervalu
+     * @brief Přečte a zpracuje dostupná data jednoho klienta
+     * @param slot Index klienta
+     * @param start Čas začátku zpracování průchodu (micros)
      */
-    void sendAliveIfNeeded();
+    void readClient(uint8_t slot, unsigned long start);
+
+    /**
+     * @brief Vyhledá příkaz v tabulce a zavolá jeho obsluhu
+     * @param slot Index odesílatele
+     * @param line Kompletní řádek (velkými písmeny)
+     */
+    void dispatchCommand(uint8_t slot, char *line);
+
+    /**
+     * @brief Příkaz DISCONNECT - ukončí spojení odesílatele
+     * @param slot Index odesílatele
+     * @param args Parametry (nepoužito)
+     */
+    void handleDisconnectCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz PING [token] - odpoví PONG <token> <micros zařízení>
+     * @param slot Index odesílatele
+     * @param args Volitelný token, který se vrátí beze změny
+     */
+    void handlePingCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz PONG <token> - odpověď řídicího klienta na PING zařízení
+     * @param slot Index odesílatele
+     * @param args Token z PINGu
+     */
+    void handlePongCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz ALIVE - heartbeat klienta, od prvního se hlídá clientTimeoutMs
+     * @param slot Index odesílatele
+     * @param args Parametry (nepoužito)
+     */
+    void handleAliveCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz RTT [ON|OFF|RESET] - měření odezvy, bez parametru vypíše histogram
+     * @param slot Index odesílatele
+     * @param args Parametry za slovem RTT (velkými písmeny)
+     */
+    void handleRttCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz TIMERS - čítače časového kola (spuštěné, opožděné, max. zpoždění)
+     * @param slot Index odesílatele
+     * @param args Parametry (nepoužito)
+     */
+    void handleTimersCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Spustí obsluhy nejvýš timerHandlersPerPass vypršelých časovačů (zbytek počká)
+     */
+    void runTimers();
+
+    /**
+     * @brief Časovač EMG_TIMER_RTT_PING - odešle řídicímu klientovi PING
+     */
+    void sendRttPing();
+
+    /**
+     * @brief Časovač EMG_TIMER_RTT_TIMEOUT - PING zůstal bez odpovědi
+     */
+    void handleRttTimeout();
+
+    /**
+     * @brief Vypne měření odezvy (řídicí klient se změnil nebo odešel)
+     */
+    void stopRtt();
+
+    /**
+     * @brief Časovač EMG_TIMER_AUTO_STOP - pošle robotovi "0"
+     */
+    void sendAutoStop();
+
+    /**
+     * @brief Zpracuje příkaz STREAM [OFF|STATS|RAW|počet vzorků na rámec]
+     * @param slot Index odesílatele
+     * @param args Parametry za slovem STREAM (velkými písmeny)
+     */
+    void handleStreamCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz ROLE [CONTROL|OBSERVE] - vypíše nebo změní roli odesílatele
+     * @param slot Index odesílatele
+     * @param args Požadovaná role, bez parametru jen odpoví aktuální
+     */
+    void handleRoleCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Určí roli klienta podle jeho prvního řádku
+     * @param slot Index odesílatele
+     * @param line Celý první řádek (velkými písmeny)
+     */
+    void assignRole(uint8_t slot, const char *line);
+
+    /**
+     * @brief Předá řízení klientovi, dosavadní řídicí klient přejde na sledování
+     * @param slot Index nového řídicího klienta
+     * @param declared Klient si řízení vyžádal příkazem ROLE CONTROL
+     */
+    void takeControl(uint8_t slot, bool declared);
+
+    /**
+     * @brief Příkaz RECAL - nová kalibrace všech kanálů
+     * @param slot Index odesílatele
+     * @param args Parametry (nepoužito)
+     */
+    void handleRecalCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz SET CHANNELS <n> | SET MODE <EMA|MAV|RMS>
+     * @param slot Index odesílatele
+     * @param args Název a hodnota parametru
+     */
+    void handleSetCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Příkaz UDP <port> [kopie] | UDP OFF | UDP STATS - příkazy i přes UDP na adresu odesílatele
+     * @param slot Index odesílatele
+     * @param args Parametry za slovem UDP (velkými písmeny)
+     */
+    void handleUdpCommand(uint8_t slot, char *args);
+
+    /**
+     * @brief Časovač EMG_TIMER_ALIVE - odešle ALIVE všem klientům a naplánuje další
+     */
+    void sendAlive();
 
     /**
      * @brief Hlavní logika zpracování EMG signálů a komunikace
+     * @param frame Snímek surových hodnot ze všech kanálů
+     */
+    void handleLogic(const EMGFrame &frame);
+
+    /**
+     * @brief Vypíše zpoždění detekce potvrzených nástupů (debug)
+     * @param onsetMask Maska kanálů s nástupem v aktuálním snímku
+     */
+    void reportOnsets(uint8_t onsetMask);
+
+    /**
+     * @brief Zpracuje dávku snímků čekajících v EMGAcquisition
+     */
+    void processSamples();
+
+    /**
+     * @brief Vypíše nová přetečení vzorkovacího bufferu (debug)
+     */
+    void reportOverruns();
+
+    /**
+     * @brief Vypíše kanály, u kterých dlouhá aktivita zmrazila sledování klidu (debug)
      */
-    void handleLogic();
+    void reportBaselineFaults();
 
     /**
-     * @brief Kalibruje oba senzory
+     * @brief Zahájí kalibraci všech senzorů na pozadí
      */
     void calibrateSensors();
 
     /**
-     * @brief Inicializuje senzory
+     * @brief Časovač EMG_TIMER_CALIBRATION - zobrazí průběh kalibrace a po uplynutí okna ji dokončí
+     */
+    void advanceCalibration();
+
+    /**
+     * @brief Dokončí kalibraci všech senzorů a povolí vyhodnocování
+     */
+    void finishCalibration();
+
+    /**
+     * @brief Zobrazí aktuálně zvolený příkaz na LCD
+     */
+    void showCurrentCommand();
+
+    /**
+     * @brief Zobrazí na LCD výzvu k připojení klienta s IP adresou
+     */
+    void showWaitingForClient();
+
+    /**
+     * @brief Inicializuje senzory (kalibruje, pokud nejsou k dispozici sledované prahy)
      */
     void initSensors();
 
     /**
-     * @brief Zpracuje nového klienta
+     * @brief Přijme nového klienta do volného slotu (první připojený inicializuje senzory)
      */
-    void handleNewClient();
+    void acceptClient();
 
     /**
-     * @brief Uvolní paměť senzorů
+     * @brief Uzavře sloty klientů, kteří ztratili spojení nebo přestali posílat heartbeat
+     *
+     * Stav socketu (connected) se zjišťuje přenosem po SPI, proto jen jednou
+     * za clientStatusIntervalMs nebo hned po nepřijatém zápisu.
+     */
+    void checkClients();
+
+    /**
+     * @brief Odešle zprávu řídicímu klientovi hned, bez čekání na konec průchodu
+     * @param msg Zpráva včetně '\n'
+     * @return False pokud řídicí klient není připojen
+     */
+    bool sendToControl(const char *msg);
+
+    /**
+     * @brief Odešle příkaz robotovi (UDP, je-li zapnuté, a TCP)
+     * @param command Kód příkazu
+     * @return False pokud řídicí klient není připojen
+     */
+    bool sendRobotCommand(int command);
+
+    /**
+     * @brief Zapíše plný rámec telemetrie všem odběratelům
+     */
+    void sendTelemetry();
+
+    /**
+     * @brief Vypne telemetrii, pokud ji už nikdo neodebírá
+     */
+    void updateTelemetrySubscribers();
+
+    /**
+     * @brief Vyprázdní výstupní buffery všech klientů (řídicí klient první) a zavře ty, kterým data neodešla
+     */
+    void flushClients();
+
+    /**
+     * @brief Zneplatní stav senzorů (nová inicializace vyžaduje kalibraci)
      */
     void cleanupSensors();
 
     /**
-     * @brief Odpojí klienta a resetuje systém
+     * @brief Odpojí jednoho klienta, po posledním resetuje systém
+     * @param slot Index klienta
+     */
+    void closeClient(uint8_t slot);
+
+    /**
+     * @brief Zahodí všechna spojení bez odesílání a bez úklidu po posledním klientovi (výpadek sítě)
+     */
+    void dropClients();
+
+    /**
+     * @brief Resetuje systém po odchodu posledního klienta
      */
     void cleanupClient();
 
@@ -75,10 +388,25 @@ public:
     EMGSystem(int port);
 
     /**
-     * @brief Spustí TCP server pro EMG systém
+     * @brief Spustí vzorkování a bez uložené kalibrace i kalibraci (souběžně se startem sítě)
+     */
+    void begin();
+
+    /**
+     * @brief Spustí TCP server pro EMG systém (po připojení k WiFi)
      */
     void beginServer();
 
+    /**
+     * @brief Odpojí všechny klienty a zastaví TCP server (výpadek WiFi), kalibrace i příkaz zůstanou
+     */
+    void endServer();
+
+    /**
+     * @brief Zastaví vzorkování i kalibraci (v režimu AP se EMG nepoužívá)
+     */
+    void end();
+
     /**
      * @brief Hlavní aktualizační metoda systému (volat v loop)
      */
@@ -89,6 +417,16 @@ public:
      */
     bool isInitialized() const;
 
+    /**
+     * @brief Vrací příznak probíhající kalibrace
+     */
+    bool isCalibrating() const;
+
+    /**
+     * @brief Vrací průběh kalibrace v procentech
+     */
+    uint8_t getCalibrationProgress() const;
+
     /**
      * @brief Nastaví pointer na LCD displej
      * @param lcd Pointer na LCD displej
@@ -106,6 +444,143 @@ public:
      * @return True pokud byl příkaz odeslán úspěšně
      */
     bool sendCurrentCommand();
+
+    /**
+     * @brief Odešle robotovi zadaný příkaz (POST /send-command), platí cooldown jako pro EMG2
+     * @param code Kód příkazu z commandTable (1 až 8)
+     * @return True pokud byl příkaz odeslán úspěšně
+     */
+    bool sendCommand(uint8_t code);
+
+    /**
+     * @brief Vrací počet snímků nasnímaných od spuštění vzorkování
+     */
+    uint32_t getSampleCount() const;
+
+    /**
+     * @brief Vrací počet snímků čekajících na zpracování
+     */
+    uint8_t getPendingFrames() const;
+
+    /**
+     * @brief Vrací počet snímků zahozených kvůli přetečení bufferu
+     */
+    uint32_t getOverrunCount() const;
+
+    /**
+     * @brief Zahodí uloženou i sledovanou kalibraci a spustí novou (příkaz RECAL)
+     */
+    void recalibrate();
+
+    /**
+     * @brief Vrací čítače výstupního bufferu klienta (bajty, vyprázdnění, volání client.write)
+     * @param slot Index klienta (0 až maxClients - 1)
+     */
+    const TxStats &getTxStats(uint8_t slot) const;
+
+    /**
+     * @brief Vrací počet připojených klientů
+     */
+    uint8_t getClientCount() const;
+
+    /**
+     * @brief Vrací příznak připojeného řídicího klienta (robota)
+     */
+    bool hasControlClient() const;
+
+    /**
+     * @brief Vrací stav binárního proudu telemetrie (čítače rámců a bajtů)
+     */
+    const EMGTelemetry &getTelemetry() const;
+
+    /**
+     * @brief Vrací histogram odezvy řídicího klienta na PING zařízení
+     */
+    const RttHistogram &getRttHistogram() const;
+
+    /**
+     * @brief Vrací čítače časového kola (spuštěné a opožděné časovače)
+     */
+    const TimerStats &getTimerStats() const;
+
+    /**
+     * @brief Nastaví počet používaných EMG kanálů
+     *
+     * Při běžícím serveru restartuje vzorkování, u připojeného klienta
+     * navíc spustí novou kalibraci všech kanálů.
+     * @param count Počet kanálů (1 až maxSensors)
+     * @return False pokud je počet mimo rozsah
+     */
+    bool setChannelCount(uint8_t count);
+
+    /**
+     * @brief Vrací počet používaných EMG kanálů
+     */
+    uint8_t getChannelCount() const;
+
+    /**
+     * @brief Vrací statistiku zpoždění detekce nástupu kanálu
+     * @param channel Index kanálu
+     */
+    const EMGOnsetStats &getOnsetStats(uint8_t channel) const;
+
+    /**
+     * @brief Vrací změřenou dobu filtračních řetězců jednoho snímku
+     */
+    const EMGFilterProbe &getFilterProbe() const;
+
+    /**
+     * @brief Vrací odhad doby filtračních řetězců jednoho snímku podle cyklů z EMGFilter.h (µs)
+     */
+    uint16_t getFilterEstimateUs() const;
+
+    /**
+     * @brief Nastaví způsob výpočtu obálky všech kanálů
+     *
+     * Prahy závisí na typu obálky, připojený klient proto projde novou kalibrací.
+     * @param mode EMA, MAV nebo RMS
+     * @return False pokud okenní režimy nejsou přeloženy (EMG_WINDOW_ENVELOPE)
+     */
+    bool setEnvelopeMode(EMGEnvelopeMode mode);
+
+    /**
+     * @brief Vrací používaný způsob výpočtu obálky
+     */
+    EMGEnvelopeMode getEnvelopeMode() const;
+
+    /**
+     * @brief Vrací horní práh kanálu (nástup aktivity)
+     * @param channel Index kanálu
+     * @return Práh ve voltech
+     */
+    float getThresholdUpper(uint8_t channel) const;
+
+    /**
+     * @brief Vrací dolní práh kanálu (konec aktivity)
+     * @param channel Index kanálu
+     * @return Práh ve voltech
+     */
+    float getThresholdLower(uint8_t channel) const;
+
+    /**
+     * @brief Vrací sledovanou klidovou úroveň obálky kanálu
+     * @param channel Index kanálu
+     * @return Klidová úroveň ve voltech
+     */
+    float getBaseline(uint8_t channel) const;
+
+    /**
+     * @brief Zjistí, zda dlouhá kolísající aktivita zmrazila sledování klidu kanálu
+     * @param channel Index kanálu
+     */
+    bool hasBaselineFault(uint8_t channel) const;
+
+    /**
+     * @brief Vrací aktuální hodnotu obálky kanálu
+     * @param channel Index kanálu
+     * @return Hodnota obálky ve voltech
+     */
+    float getEnvelope(uint8_t channel) const;
 };
 
 #endif // EMG_SYSTEM_H
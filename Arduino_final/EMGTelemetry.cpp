@@ -0,0 +1,192 @@
+#include "EMGTelemetry.h"
+
+/**
+ * @brief Zapne proud rámců a vynuluje čítače
+ * @param channelCount Počet kanálů v rámci
+ * @param frameSamples Počet vzorků na rámec (1 až telemetryMaxSamplesPerFrame, zkrátí se na kapacitu rámce)
+ * @param raw True pro přidání surových hodnot ADC
+ * @return False pokud jsou parametry mimo rozsah
+ */
+bool EMGTelemetry::start(uint8_t channelCount, uint8_t frameSamples, bool raw)
+{
+    if (channelCount == 0 || channelCount > maxSensors)
+        return false;
+    if (frameSamples == 0 || frameSamples > telemetryMaxSamplesPerFrame)
+        return false;
+
+    uint8_t sampleBytes = channelCount * (raw ? 2 : 1) * sizeof(uint16_t);
+    if (frameSamples > telemetryPayloadBytes / sampleBytes)
+        frameSamples = telemetryPayloadBytes / sampleBytes;
+
+    channels = channelCount;
+    samplesPerFrame = frameSamples;
+    includeRaw = raw;
+    length = 0;
+    samples = 0;
+    sequence = 0;
+    framesSent = 0;
+    framesDropped = 0;
+    bytesSent = 0;
+    rateWindowStart = millis();
+    rateWindowBytes = 0;
+    bytesPerSecond = 0;
+    enabled = true;
+    return true;
+}
+
+/**
+ * @brief Vypne proud rámců (rozpracovaný rámec se zahodí)
+ */
+void EMGTelemetry::stop()
+{
+    enabled = false;
+    length = 0;
+    samples = 0;
+}
+
+/**
+ * @brief Vrací příznak zapnutého proudu
+ */
+bool EMGTelemetry::isEnabled() const
+{
+    return enabled;
+}
+
+/**
+ * @brief Připíše 16bitovou hodnotu do rámce
+ */
+void EMGTelemetry::put16(uint16_t value)
+{
+    frame[length++] = value & 0xFF;
+    frame[length++] = value >> 8;
+}
+
+/**
+ * @brief Přidá jeden zpracovaný snímek do rámce (volat po EMGSensorBank::update)
+ * @param sensors Sada kanálů s aktuálními obálkami
+ * @param input Surové hodnoty snímku
+ * @param acquisition Vzorkování, ze kterého snímek pochází (čas pořízení)
+ * @return True pokud je rámec plný a má se odeslat
+ */
+bool EMGTelemetry::add(const EMGSensorBank &sensors, const EMGFrame &input, const EMGAcquisition &acquisition)
+{
+    if (!enabled)
+        return false;
+
+    if (samples == 0)
+    {
+        // Hlavička se vyplní při prvním vzorku; snímek mohl ve frontě čekat, nese se čas pořízení
+        uint32_t timestamp = acquisition.getReadFrameTime();
+        uint16_t dropped = framesDropped;
+        frame[0] = telemetrySync;
+        frame[1] = includeRaw ? telemetryFlagRaw : 0;
+        frame[2] = channels;
+        frame[3] = samplesPerFrame;
+        length = 4;
+        put16(sequence);
+        put16(timestamp & 0xFFFF);
+        put16(timestamp >> 16);
+        put16(dropped);
+    }
+
+    for (uint8_t i = 0; i < channels; i++)
+        put16(sensors.getEnvelopeCounts(i));
+    if (includeRaw)
+        for (uint8_t i = 0; i < channels; i++)
+            put16(input.raw[i]);
+
+    return ++samples >= samplesPerFrame;
+}
+
+/**
+ * @brief Připíše plný rámec do výstupního bufferu odběratele (celý, nebo vůbec)
+ * @param out Výstupní buffer klienta
+ * @return True pokud buffer rámec přijal
+ */
+bool EMGTelemetry::send(TxBuffer &out)
+{
+    if (!enabled || samples < samplesPerFrame)
+        return false;
+
+    // Rámec nepřesáhne kapacitu bufferu, ten ho tedy zkopíruje celý, nebo odmítne
+    if (out.write(frame, length) != length)
+    {
+        framesDropped++;
+        return false;
+    }
+
+    framesSent++;
+    bytesSent += length;
+    rateWindowBytes += length;
+    return true;
+}
+
+/**
+ * @brief Uzavře odeslaný rámec a začne plnit další se zvýšeným pořadovým číslem
+ */
+void EMGTelemetry::finish()
+{
+    if (samples < samplesPerFrame)
+        return;
+
+    // Rámec se kóduje jednou, pořadí roste bez ohledu na počet odběratelů
+    sequence++;
+    samples = 0;
+    length = 0;
+
+    unsigned long now = millis();
+    if (now - rateWindowStart >= 1000)
+    {
+        bytesPerSecond = rateWindowBytes * 1000UL / (now - rateWindowStart);
+        rateWindowBytes = 0;
+        rateWindowStart = now;
+    }
+}
+
+/**
+ * @brief Vrací počet vzorků na rámec
+ */
+uint8_t EMGTelemetry::getSamplesPerFrame() const
+{
+    return samplesPerFrame;
+}
+
+/**
+ * @brief Vrací příznak přidávání surových hodnot ADC
+ */
+bool EMGTelemetry::includesRaw() const
+{
+    return includeRaw;
+}
+
+/**
+ * @brief Vrací počet odeslaných rámců
+ */
+uint32_t EMGTelemetry::getFramesSent() const
+{
+    return framesSent;
+}
+
+/**
+ * @brief Vrací počet zahozených rámců
+ */
+uint32_t EMGTelemetry::getFramesDropped() const
+{
+    return framesDropped;
+}
+
+/**
+ * @brief Vrací počet odeslaných bajtů
+ */
+uint32_t EMGTelemetry::getBytesSent() const
+{
+    return bytesSent;
+}
+
+/**
+ * @brief Vrací rychlost odesílání za poslední celou sekundu v B/s
+ */
+uint32_t EMGTelemetry::getBytesPerSecond() const
+{
+    return bytesPerSecond;
+}
@@ -0,0 +1,138 @@
+#ifndef EMG_TELEMETRY_H
+#define EMG_TELEMETRY_H
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include "Config.h"
+#include "EMGAcquisition.h"
+#include "EMGSensorBank.h"
+#include "TxBuffer.h"
+
+/**
+ * @brief Formát binárního rámce telemetrie (little-endian)
+ *
+ *  0  uint8   synchronizační bajt 0xA5 (ASCII zprávy ho nikdy neobsahují)
+ *  1  uint8   příznaky (bit 0 = rámec obsahuje i surové hodnoty ADC)
+ *  2  uint8   počet kanálů C
+ *  3  uint8   počet vzorků N
+ *  4  uint16  pořadové číslo rámce
+ *  6  uint32  čas pořízení prvního vzorku v µs (micros zařízení, ne čas zpracování)
+ * 10  uint16  počet zahozených rámců od zapnutí proudu
+ * 12  N x (C x uint16 obálka v ADC Q4 [, C x uint16 surová hodnota ADC])
+ */
+const uint8_t telemetrySync = 0xA5;       // Synchronizační bajt rámce
+const uint8_t telemetryFlagRaw = 0x01;    // Rámec obsahuje surové hodnoty ADC
+const uint8_t telemetryHeaderBytes = 12;  // Délka hlavičky rámce
+const uint16_t telemetryMaxFrameBytes = telemetryHeaderBytes + telemetryPayloadBytes;
+
+static_assert(telemetryMaxFrameBytes <= clientTxBytes, "Ramec telemetrie se musi vejit do bufferu klienta, jinak by odesel jen zcasti");
+
+/**
+ * @class EMGTelemetry
+ * @brief Dávkování obálek (a volitelně surových vzorků) do binárních rámců
+ *
+ * Vzorky se skládají přímo do bufferu rámce a celý rámec se odešle jedním
+ * client.write, místo zápisu po jednotlivých vzorcích. Rámce se prokládají
+ * s textovými zprávami na stejném TCP spojení, klient je rozliší podle
+ * synchronizačního bajtu. Rámec se vejde do výstupního bufferu klienta, do
+ * proudu se tedy zapíše celý, nebo vůbec: po nedoručených datech ho buffer
+ * odmítne, rámec se počítá jako zahozený a klient se odpojí (TxBuffer).
+ * Buffer rámce je dimenzován na výchozí počet kanálů; při více kanálech nebo
+ * s RAW se počet vzorků v rámci zkrátí tak, aby se vešel.
+ */
+class EMGTelemetry
+{
+private:
+    uint8_t frame[telemetryMaxFrameBytes]; // Rozpracovaný rámec
+    uint16_t length = 0;                   // Počet bajtů v rámci
+    uint8_t samples = 0;                   // Počet vzorků v rámci
+    uint8_t samplesPerFrame = 0;           // Vzorků na rámec
+    uint8_t channels = 0;                  // Počet kanálů v rámci
+    bool includeRaw = false;               // Přidávat surové hodnoty ADC
+    bool enabled = false;                  // Proud je zapnutý
+    uint16_t sequence = 0;                 // Pořadové číslo dalšího rámce
+    uint32_t framesSent = 0;               // Počet odeslaných rámců (součet přes odběratele)
+    uint32_t framesDropped = 0;            // Počet zahozených rámců
+    uint32_t bytesSent = 0;                // Počet odeslaných bajtů
+    unsigned long rateWindowStart = 0;     // Začátek okna měření rychlosti
+    uint32_t rateWindowBytes = 0;          // Bajty odeslané v aktuálním okně
+    uint32_t bytesPerSecond = 0;           // Naměřená rychlost za poslední uzavřené okno
+
+    /**
+     * @brief Připíše 16bitovou hodnotu do rámce
+     */
+    void put16(uint16_t value);
+
+public:
+    /**
+     * @brief Zapne proud rámců a vynuluje čítače
+     * @param channelCount Počet kanálů v rámci
+     * @param frameSamples Počet vzorků na rámec (1 až telemetryMaxSamplesPerFrame, zkrátí se na kapacitu rámce)
+     * @param raw True pro přidání surových hodnot ADC
+     * @return False pokud jsou parametry mimo rozsah
+     */
+    bool start(uint8_t channelCount, uint8_t frameSamples, bool raw);
+
+    /**
+     * @brief Vypne proud rámců (rozpracovaný rámec se zahodí)
+     */
+    void stop();
+
+    /**
+     * @brief Vrací příznak zapnutého proudu
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Přidá jeden zpracovaný snímek do rámce (volat po EMGSensorBank::update)
+     * @param sensors Sada kanálů s aktuálními obálkami
+     * @param input Surové hodnoty snímku
+     * @param acquisition Vzorkování, ze kterého snímek pochází (čas pořízení)
+     * @return True pokud je rámec plný a má se odeslat
+     */
+    bool add(const EMGSensorBank &sensors, const EMGFrame &input, const EMGAcquisition &acquisition);
+
+    /**
+     * @brief Připíše plný rámec do výstupního bufferu odběratele (celý, nebo vůbec)
+     * @param out Výstupní buffer klienta
+     * @return True pokud buffer rámec přijal
+     */
+    bool send(TxBuffer &out);
+
+    /**
+     * @brief Uzavře odeslaný rámec a začne plnit další se zvýšeným pořadovým číslem
+     */
+    void finish();
+
+    /**
+     * @brief Vrací počet vzorků na rámec
+     */
+    uint8_t getSamplesPerFrame() const;
+
+    /**
+     * @brief Vrací příznak přidávání surových hodnot ADC
+     */
+    bool includesRaw() const;
+
+    /**
+     * @brief Vrací počet odeslaných rámců
+     */
+    uint32_t getFramesSent() const;
+
+    /**
+     * @brief Vrací počet zahozených rámců
+     */
+    uint32_t getFramesDropped() const;
+
+    /**
+     * @brief Vrací počet odeslaných bajtů
+     */
+    uint32_t getBytesSent() const;
+
+    /**
+     * @brief Vrací rychlost odesílání za poslední celou sekundu v B/s
+     */
+    uint32_t getBytesPerSecond() const;
+};
+
+#endif // EMG_TELEMETRY_H
@@ -0,0 +1,101 @@
+#include "FormParser.h"
+#include "Utils.h"
+
+/**
+ * @brief Rozloží dotaz nebo tělo formuláře (buffer se přepíše)
+ * @param form Dotaz za '?' nebo tělo application/x-www-form-urlencoded (C-string)
+ * @return Počet nalezených parametrů
+ */
+uint8_t FormParser::parse(char *form)
+{
+    count = 0;
+    if (!form)
+        return 0;
+
+    // Rozdělení i dekódování v jednom průchodu: zápis nikdy nepředběhne čtení
+    const char *read = form;
+    char *write = form;
+    while (*read && count < httpMaxFormParams)
+    {
+        char *key = write;
+        char *value = nullptr;
+        while (*read && *read != '&')
+        {
+            char c = *read++;
+            if (c == '=' && !value)
+            {
+                *write++ = '\0';
+                value = write;
+                continue;
+            }
+            if (c == '+')
+            {
+                c = ' ';
+            }
+            else if (c == '%')
+            {
+                uint8_t high = hexDigitValue(read[0]);
+                uint8_t low = high != 0xFF ? hexDigitValue(read[1]) : 0xFF;
+                if (((high | low) & 0xF0) == 0)
+                {
+                    c = (char)(high << 4 | low);
+                    read += 2;
+                }
+            }
+            *write++ = c;
+        }
+        if (*read)
+            read++;
+
+        // Prázdná dvojice ("a=1&&b=2") se přeskočí
+        if (write == key)
+            continue;
+        *write++ = '\0';
+
+        keys[count] = key;
+        values[count] = value ? value : write - 1;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Vrací hodnotu parametru
+ * @param key Dekódovaný název parametru (např. "input1")
+ * @return Dekódovaná hodnota nebo nullptr, pokud parametr chybí
+ */
+const char *FormParser::get(const char *key) const
+{
+    for (uint8_t i = 0; i < count; i++)
+    {
+        if (strcmp(keys[i], key) == 0)
+            return values[i];
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Vrací počet nalezených parametrů
+ */
+uint8_t FormParser::getCount() const
+{
+    return count;
+}
+
+/**
+ * @brief Vrací klíč parametru podle pořadí
+ * @param index Index parametru (0 až getCount() - 1)
+ */
+const char *FormParser::getKey(uint8_t index) const
+{
+    return index < count ? keys[index] : nullptr;
+}
+
+/**
+ * @brief Vrací hodnotu parametru podle pořadí
+ * @param index Index parametru (0 až getCount() - 1)
+ */
+const char *FormParser::getValue(uint8_t index) const
+{
+    return index < count ? values[index] : nullptr;
+}
@@ -0,0 +1,58 @@
+#ifndef FORM_PARSER_H
+#define FORM_PARSER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class FormParser
+ * @brief Rozklad dotazu nebo formuláře (klíč=hodnota&...) přímo ve vstupním bufferu
+ *
+ * Oddělovače '&' a '=' se přepíšou na '\0' a klíče i hodnoty se v témže
+ * průchodu dekódují na místě (stejně jako urlDecode), nic se nekopíruje.
+ * Parser drží jen ukazatele do rozloženého bufferu, ten proto musí zůstat
+ * platný po celou dobu používání. Parametry mohou být v libovolném pořadí,
+ * parametr bez '=' má prázdnou hodnotu a nad httpMaxFormParams se další
+ * parametry ignorují.
+ */
+class FormParser
+{
+private:
+    const char *keys[httpMaxFormParams];   // Dekódované klíče (ukazují do bufferu)
+    const char *values[httpMaxFormParams]; // Dekódované hodnoty (ukazují do bufferu)
+    uint8_t count = 0;                     // Počet nalezených parametrů
+
+public:
+    /**
+     * @brief Rozloží dotaz nebo tělo formuláře (buffer se přepíše)
+     * @param form Dotaz za '?' nebo tělo application/x-www-form-urlencoded (C-string)
+     * @return Počet nalezených parametrů
+     */
+    uint8_t parse(char *form);
+
+    /**
+     * @brief Vrací hodnotu parametru
+     * @param key Dekódovaný název parametru (např. "input1")
+     * @return Dekódovaná hodnota nebo nullptr, pokud parametr chybí
+     */
+    const char *get(const char *key) const;
+
+    /**
+     * @brief Vrací počet nalezených parametrů
+     */
+    uint8_t getCount() const;
+
+    /**
+     * @brief Vrací klíč parametru podle pořadí
+     * @param index Index parametru (0 až getCount() - 1)
+     */
+    const char *getKey(uint8_t index) const;
+
+    /**
+     * @brief Vrací hodnotu parametru podle pořadí
+     * @param index Index parametru (0 až getCount() - 1)
+     */
+    const char *getValue(uint8_t index) const;
+};
+
+#endif // FORM_PARSER_H
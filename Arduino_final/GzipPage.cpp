@@ -0,0 +1,202 @@
+#include "GzipPage.h"
+
+static const uint32_t crcPoly = 0xEDB88320UL; // Obrácený polynom CRC-32
+
+// CRC-32 po čtveřicích bitů (16 položek místo 256 v tabulce po bajtech)
+static const uint32_t crcNibbleTable[16] PROGMEM = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL,
+};
+
+static const uint8_t gzipHeader[] PROGMEM = {0x1F, 0x8B, 0x08, 0, 0, 0, 0, 0, 0, 0x03}; // Bez jména a času, OS Unix
+static const uint8_t gzipFinalBlock[] PROGMEM = {0x01, 0x00, 0x00, 0xFF, 0xFF};           // Prázdný závěrečný uložený blok
+
+/**
+ * @brief Zapíše blok z flash do výstupu
+ * @param out Výstup
+ * @param data Data v PROGMEM
+ * @param length Délka dat
+ */
+static void writeProgmem(Print &out, const uint8_t *data, uint16_t length)
+{
+    uint8_t chunk[httpPageChunkBytes];
+    while (length > 0)
+    {
+        uint8_t n = length > sizeof(chunk) ? sizeof(chunk) : length;
+        memcpy_P(chunk, data, n);
+        out.write(chunk, n);
+        data += n;
+        length -= n;
+    }
+}
+
+/**
+ * @brief Zapíše 32bitové číslo v pořadí little-endian (patička gzip)
+ */
+static void writeLe32(Print &out, uint32_t value)
+{
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    out.write(bytes, sizeof(bytes));
+}
+
+/**
+ * @brief Započte jeden bajt
+ */
+size_t ByteCounter::write(uint8_t)
+{
+    count++;
+    return 1;
+}
+
+/**
+ * @brief Započte blok bajtů
+ */
+size_t ByteCounter::write(const uint8_t *, size_t size)
+{
+    count += size;
+    return size;
+}
+
+/**
+ * @brief Vrací počet zapsaných bajtů
+ */
+uint16_t ByteCounter::getCount() const
+{
+    return count;
+}
+
+/**
+ * @brief Konstruktor pro daný výstup
+ * @param target Výstup odpovědi
+ */
+GzipPageWriter::GzipPageWriter(Print &target) : out(target)
+{
+}
+
+/**
+ * @brief Zapíše hlavičku gzip
+ */
+void GzipPageWriter::begin()
+{
+    crc = 0;
+    size = 0;
+    fieldLeft = 0;
+    writeProgmem(out, gzipHeader, sizeof(gzipHeader));
+}
+
+/**
+ * @brief Zapíše statickou část z flash po blocích httpPageChunkBytes
+ * @param segment Popis části (už zkopírovaný z PROGMEM)
+ */
+void GzipPageWriter::writeSegment(const GzipSegment &segment)
+{
+    closeField();
+    if (segment.length > 0)
+        writeProgmem(out, segment.data, segment.length);
+    crc = combineCrc(crc, segment.crc, segment.shift);
+    size += segment.plainLength;
+}
+
+/**
+ * @brief Otevře uložený blok pro hodnotu pole
+ * @param length Přesná délka hodnoty (0 = pole se vynechá)
+ */
+void GzipPageWriter::beginField(uint16_t length)
+{
+    closeField();
+    if (length == 0)
+        return;
+
+    // Uložený blok: BFINAL=0, BTYPE=00, zarovnáno na bajt, LEN a NLEN
+    uint8_t header[fieldOverhead] = {0x00, (uint8_t)length, (uint8_t)(length >> 8),
+                                     (uint8_t)~length, (uint8_t)(~length >> 8)};
+    out.write(header, sizeof(header));
+    fieldLeft = length;
+}
+
+/**
+ * @brief Doplní nedopsanou hodnotu pole mezerami na ohlášenou délku
+ */
+void GzipPageWriter::closeField()
+{
+    while (fieldLeft > 0)
+        write(' ');
+}
+
+/**
+ * @brief Zapíše bajt hodnoty pole
+ */
+size_t GzipPageWriter::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+/**
+ * @brief Zapíše část hodnoty pole
+ */
+size_t GzipPageWriter::write(const uint8_t *buffer, size_t length)
+{
+    if (length > fieldLeft)
+        length = fieldLeft;
+    if (length == 0)
+        return 0;
+
+    out.write(buffer, length);
+    crc = updateCrc(crc, buffer, length);
+    size += length;
+    fieldLeft -= length;
+    return length;
+}
+
+/**
+ * @brief Zapíše závěrečný blok a patičku gzip (CRC-32 a délku textu)
+ */
+void GzipPageWriter::end()
+{
+    closeField();
+    writeProgmem(out, gzipFinalBlock, sizeof(gzipFinalBlock));
+    writeLe32(out, crc);
+    writeLe32(out, size);
+}
+
+/**
+ * @brief Přepočte CRC-32 o další blok dat (stejně jako crc32 v zlib)
+ * @param crc CRC-32 dosavadních dat
+ * @param data Další data
+ * @param length Délka dalších dat
+ */
+uint32_t GzipPageWriter::updateCrc(uint32_t crc, const uint8_t *data, size_t length)
+{
+    crc = ~crc;
+    while (length--)
+    {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ pgm_read_dword(&crcNibbleTable[crc & 0x0F]);
+        crc = (crc >> 4) ^ pgm_read_dword(&crcNibbleTable[crc & 0x0F]);
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Spojí CRC-32 dvou po sobě jdoucích bloků (crc32_combine v zlib)
+ * @param crc1 CRC-32 prvního bloku
+ * @param crc2 CRC-32 druhého bloku
+ * @param shift x^(8·délka druhého bloku) mod P
+ */
+uint32_t GzipPageWriter::combineCrc(uint32_t crc1, uint32_t crc2, uint32_t shift)
+{
+    // Součin shift·crc1 mod P v GF(2), bity od nejvyššího stupně (multmodp v zlib)
+    uint32_t product = 0;
+    for (uint32_t mask = 0x80000000UL; mask != 0 && shift != 0; mask >>= 1)
+    {
+        if (shift & mask)
+        {
+            product ^= crc1;
+            shift &= ~mask;
+        }
+        crc1 = (crc1 & 1) ? (crc1 >> 1) ^ crcPoly : crc1 >> 1;
+    }
+    return product ^ crc2;
+}
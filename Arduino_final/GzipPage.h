@@ -0,0 +1,148 @@
+#ifndef GZIP_PAGE_H
+#define GZIP_PAGE_H
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+#include "Config.h"
+
+/**
+ * @struct GzipSegment
+ * @brief Statická část stránky předkomprimovaná při sestavení (PROGMEM)
+ *
+ * Deflate bloky končí synchronizačním blokem, takže část končí na hranici
+ * bajtu a lze za ni připojit další část nebo uložený blok s hodnotou pole.
+ */
+struct GzipSegment
+{
+    const uint8_t *data;  // Deflate bloky (PROGMEM), nullptr pro prázdnou část
+    uint16_t length;      // Délka komprimovaných dat
+    uint16_t plainLength; // Délka nekomprimovaného textu
+    uint32_t crc;         // CRC-32 nekomprimovaného textu
+    uint32_t shift;       // x^(8·plainLength) mod P pro spojení CRC
+};
+
+/**
+ * @struct GzipPage
+ * @brief Stránka ze šablony ve web/: statické části proložené dynamickými poli
+ */
+struct GzipPage
+{
+    const GzipSegment *segments; // Statické části (PROGMEM), o jednu víc než polí
+    const uint8_t *fields;       // Pole mezi částmi (PROGMEM, hodnoty WebPageField)
+    uint8_t fieldCount;          // Počet polí
+    uint16_t staticBytes;        // Délka gzip odpovědi bez polí (hlavička, části, závěr)
+};
+
+/**
+ * @class ByteCounter
+ * @brief Výstup, který jen počítá bajty (délka pole před odesláním hlavičky)
+ */
+class ByteCounter : public Print
+{
+private:
+    uint16_t count = 0; // Počet zapsaných bajtů
+
+public:
+    /**
+     * @brief Započte jeden bajt
+     */
+    size_t write(uint8_t c) override;
+
+    /**
+     * @brief Započte blok bajtů
+     */
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Vrací počet zapsaných bajtů
+     */
+    uint16_t getCount() const;
+};
+
+/**
+ * @class GzipPageWriter
+ * @brief Skládá gzip odpověď z předkomprimovaných částí a hodnot polí
+ *
+ * Hodnoty polí se zapisují přes Print jako nekomprimované (uložené) bloky
+ * deflate, jejich délku je proto nutné znát předem (ByteCounter). CRC-32
+ * celé stránky se skládá z předpočítaných CRC statických částí a CRC polí
+ * počítaného za běhu, takže se statický text nikdy nedekomprimuje.
+ */
+class GzipPageWriter : public Print
+{
+private:
+    Print &out;             // Cílový výstup (TxBuffer)
+    uint32_t crc = 0;       // CRC-32 dosud zapsaného textu
+    uint32_t size = 0;      // Délka dosud zapsaného textu
+    uint16_t fieldLeft = 0; // Bajty, které zbývají do konce uloženého bloku pole
+
+    /**
+     * @brief Doplní nedopsanou hodnotu pole mezerami na ohlášenou délku
+     */
+    void closeField();
+
+public:
+    static const uint8_t fieldOverhead = 5; // Hlavička uloženého bloku (typ, LEN, NLEN)
+
+    /**
+     * @brief Konstruktor pro daný výstup
+     * @param target Výstup odpovědi
+     */
+    explicit GzipPageWriter(Print &target);
+
+    /**
+     * @brief Zapíše hlavičku gzip
+     */
+    void begin();
+
+    /**
+     * @brief Zapíše statickou část z flash po blocích httpPageChunkBytes
+     * @param segment Popis části (už zkopírovaný z PROGMEM)
+     */
+    void writeSegment(const GzipSegment &segment);
+
+    /**
+     * @brief Otevře uložený blok pro hodnotu pole
+     * @param length Přesná délka hodnoty (0 = pole se vynechá)
+     */
+    void beginField(uint16_t length);
+
+    /**
+     * @brief Zapíše bajt hodnoty pole
+     */
+    size_t write(uint8_t c) override;
+
+    /**
+     * @brief Zapíše část hodnoty pole
+     *
+     * Bajty nad délku z beginField se zahodí a kratší hodnota se doplní
+     * mezerami, proud zůstane platný i při změně hodnoty mezi průchody
+     * (např. RSSI).
+     */
+    size_t write(const uint8_t *buffer, size_t length) override;
+    using Print::write;
+
+    /**
+     * @brief Zapíše závěrečný blok a patičku gzip (CRC-32 a délku textu)
+     */
+    void end();
+
+    /**
+     * @brief Přepočte CRC-32 o další blok dat (stejně jako crc32 v zlib)
+     * @param crc CRC-32 dosavadních dat
+     * @param data Další data
+     * @param length Délka dalších dat
+     */
+    static uint32_t updateCrc(uint32_t crc, const uint8_t *data, size_t length);
+
+    /**
+     * @brief Spojí CRC-32 dvou po sobě jdoucích bloků (crc32_combine v zlib)
+     * @param crc1 CRC-32 prvního bloku
+     * @param crc2 CRC-32 druhého bloku
+     * @param shift x^(8·délka druhého bloku) mod P
+     */
+    static uint32_t combineCrc(uint32_t crc1, uint32_t crc2, uint32_t shift);
+};
+
+#endif // GZIP_PAGE_H
@@ -0,0 +1,221 @@
+#include "HttpRequestParser.h"
+
+/**
+ * @brief Připraví parser na nový požadavek
+ */
+void HttpRequestParser::reset()
+{
+    phase = PHASE_METHOD;
+    method = HTTP_OTHER;
+    length = 0;
+    headerLength = 0;
+    contentLength = 0;
+    hasContentLength = false;
+    error = 0;
+    target[0] = '\0';
+    query = target;
+    body = target;
+}
+
+/**
+ * @brief Ukončí požadavek chybou
+ * @param code Stavový kód HTTP
+ */
+HttpParseResult HttpRequestParser::fail(uint16_t code)
+{
+    error = code;
+    phase = PHASE_DONE;
+    return HTTP_PARSE_ERROR;
+}
+
+/**
+ * @brief Dokončí řádek hlavičky (prázdný řádek ukončí hlavičky)
+ */
+HttpParseResult HttpRequestParser::endHeaderLine()
+{
+    if (headerLength > 0)
+    {
+        headerLength = 0;
+        return HTTP_PARSE_PENDING;
+    }
+
+    // Prázdný řádek - konec hlaviček, tělo musí se zakončením vejít za cíl
+    if (contentLength >= sizeof(target) - (body - target))
+        return fail(413);
+    length = 0;
+    if (contentLength == 0)
+    {
+        phase = PHASE_DONE;
+        return HTTP_PARSE_DONE;
+    }
+    phase = PHASE_BODY;
+    return HTTP_PARSE_PENDING;
+}
+
+/**
+ * @brief Zpracuje jeden přijatý bajt
+ * @param c Přijatý znak
+ * @return Stav požadavku po tomto bajtu
+ */
+HttpParseResult HttpRequestParser::feed(char c)
+{
+    switch (phase)
+    {
+    case PHASE_METHOD:
+        if (c == ' ')
+        {
+            target[length] = '\0';
+            if (strcmp(target, "GET") == 0)
+                method = HTTP_GET;
+            else if (strcmp(target, "POST") == 0)
+                method = HTTP_POST;
+            length = 0;
+            phase = PHASE_TARGET;
+        }
+        else if (c == '\r' || c == '\n' || length >= 7)
+            return fail(400);
+        else
+            target[length++] = c;
+        return HTTP_PARSE_PENDING;
+
+    case PHASE_TARGET:
+        if (c == ' ')
+        {
+            target[length] = '\0';
+            char *mark = strchr(target, '?');
+            if (mark)
+                *mark++ = '\0';
+            query = mark ? mark : target + length;
+            body = target + length + 1;
+            body[0] = '\0';
+            phase = PHASE_VERSION;
+        }
+        else if (c == '\r' || c == '\n')
+            return fail(400);
+        else if (length >= httpTargetBytes - 1)
+            return fail(414);
+        else
+            target[length++] = c;
+        return HTTP_PARSE_PENDING;
+
+    case PHASE_VERSION:
+        if (c == '\n')
+            phase = PHASE_HEADER;
+        return HTTP_PARSE_PENDING;
+
+    case PHASE_HEADER:
+        if (c == '\r')
+            return HTTP_PARSE_PENDING;
+        if (c == '\n')
+            return endHeaderLine();
+
+        // Číslo za "content-length:" se skládá rovnou, zbytek hlavičky se jen počítá
+        if (headerLength == headerKeepBytes - 1 && strncmp(header, "content-length:", 15) == 0)
+        {
+            if (c >= '0' && c <= '9')
+            {
+                // Délka, která se do bufferu nevejde, končí hned (hodnota nestihne přetéct)
+                contentLength = contentLength * 10 + (c - '0');
+                if (contentLength >= httpRequestBytes)
+                    return fail(413);
+            }
+            else if (c != ' ' && c != '\t')
+                return fail(400);
+            return HTTP_PARSE_PENDING;
+        }
+        if (headerLength < headerKeepBytes - 1)
+        {
+            if (c >= 'A' && c <= 'Z')
+                c = c - 'A' + 'a';
+            header[headerLength] = c;
+            header[headerLength + 1] = '\0';
+        }
+        if (headerLength < 255)
+            headerLength++;
+
+        // Druhá hlavička Content-Length by číslice připojila k první hodnotě
+        if (headerLength == headerKeepBytes - 1 && strncmp(header, "content-length:", 15) == 0)
+        {
+            if (hasContentLength)
+                return fail(400);
+            hasContentLength = true;
+        }
+        return HTTP_PARSE_PENDING;
+
+    case PHASE_BODY:
+        body[length++] = c;
+        if (length < contentLength)
+            return HTTP_PARSE_PENDING;
+        body[length] = '\0';
+        phase = PHASE_DONE;
+        return HTTP_PARSE_DONE;
+
+    case PHASE_DONE:
+    default:
+        return error ? HTTP_PARSE_ERROR : HTTP_PARSE_DONE;
+    }
+}
+
+/**
+ * @brief Zjistí, zda je požadavek dokončen nebo chybný (další bajty se ignorují)
+ */
+bool HttpRequestParser::isComplete() const
+{
+    return phase == PHASE_DONE;
+}
+
+/**
+ * @brief Vrací metodu požadavku
+ */
+HttpMethod HttpRequestParser::getMethod() const
+{
+    return method;
+}
+
+/**
+ * @brief Vrací cestu bez dotazu (např. "/status")
+ */
+const char *HttpRequestParser::getPath() const
+{
+    return target;
+}
+
+/**
+ * @brief Vrací dotaz za '?' bez otazníku (prázdný řetězec, pokud chybí)
+ */
+const char *HttpRequestParser::getQuery() const
+{
+    return query;
+}
+
+/**
+ * @brief Vrací dotaz k rozložení na místě (FormParser), buffer se tím přepíše
+ */
+char *HttpRequestParser::getQuery()
+{
+    return query;
+}
+
+/**
+ * @brief Vrací tělo požadavku (prázdný řetězec, pokud chybí)
+ */
+const char *HttpRequestParser::getBody() const
+{
+    return body;
+}
+
+/**
+ * @brief Vrací tělo k rozložení na místě (FormParser), buffer se tím přepíše
+ */
+char *HttpRequestParser::getBody()
+{
+    return body;
+}
+
+/**
+ * @brief Vrací stavový kód chyby (400, 413, 414) nebo 0
+ */
+uint16_t HttpRequestParser::getError() const
+{
+    return error;
+}
@@ -0,0 +1,134 @@
+#ifndef HTTP_REQUEST_PARSER_H
+#define HTTP_REQUEST_PARSER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @brief Metoda HTTP požadavku
+ */
+enum HttpMethod : uint8_t
+{
+    HTTP_GET,
+    HTTP_POST,
+    HTTP_OTHER // Ostatní metody server nepodporuje (405)
+};
+
+/**
+ * @brief Výsledek zpracování bajtu požadavku
+ */
+enum HttpParseResult : uint8_t
+{
+    HTTP_PARSE_PENDING, // Požadavek ještě není celý
+    HTTP_PARSE_DONE,    // Požadavek je celý (getPath, getQuery, getBody)
+    HTTP_PARSE_ERROR    // Chybný nebo příliš velký požadavek (getError)
+};
+
+/**
+ * @class HttpRequestParser
+ * @brief Neblokující skládání HTTP požadavku po jednotlivých bajtech
+ *
+ * Požadavek se skládá v pevném bufferu napříč průchody smyčkou, stejně
+ * jako řádky příkazů v LineParser. Z hlaviček se čte jen Content-Length,
+ * ostatní se přeskakují bez ukládání. Cíl a tělo sdílí jeden buffer: tělo
+ * začíná hned za cílem, protože dlouhý dotaz (GET) a dlouhé tělo (POST
+ * formuláře) v jednom požadavku nepřichází. Cíl delší než httpTargetBytes
+ * skončí chybou 414, tělo, které se za cíl nevejde, chybou 413 (už při čtení
+ * Content-Length). Opakovaná nebo nečíselná Content-Length skončí chybou 400.
+ */
+class HttpRequestParser
+{
+private:
+    enum Phase : uint8_t
+    {
+        PHASE_METHOD,  // Název metody do první mezery
+        PHASE_TARGET,  // Cesta a dotaz do druhé mezery
+        PHASE_VERSION, // Zbytek řádku požadavku (verze se nekontroluje)
+        PHASE_HEADER,  // Řádky hlaviček do prázdného řádku
+        PHASE_BODY,    // Tělo podle Content-Length
+        PHASE_DONE     // Požadavek dokončen nebo chybný
+    };
+
+    static const uint8_t headerKeepBytes = 16; // Z řádku hlavičky stačí "content-length:"
+
+    char target[httpRequestBytes];   // Cesta a dotaz (po dokončení rozdělené na '?'), za nimi tělo
+    char *body = target;             // Tělo požadavku (C-string, ukazuje do target)
+    char header[headerKeepBytes];    // Začátek aktuální hlavičky (malými písmeny)
+    char *query = target;            // Dotaz za '?' (ukazuje do target)
+    Phase phase = PHASE_METHOD;      // Rozpracovaná část požadavku
+    HttpMethod method = HTTP_OTHER;  // Metoda požadavku
+    uint8_t length = 0;              // Počet znaků v aktuální části
+    uint8_t headerLength = 0;        // Počet znaků aktuálního řádku hlavičky
+    uint16_t contentLength = 0;      // Hodnota Content-Length
+    bool hasContentLength = false;   // Hlavička Content-Length už přišla
+    uint16_t error = 0;              // Stavový kód HTTP chyby (0 = bez chyby)
+
+    /**
+     * @brief Ukončí požadavek chybou
+     * @param code Stavový kód HTTP
+     */
+    HttpParseResult fail(uint16_t code);
+
+    /**
+     * @brief Dokončí řádek hlavičky (prázdný řádek ukončí hlavičky)
+     */
+    HttpParseResult endHeaderLine();
+
+public:
+    /**
+     * @brief Připraví parser na nový požadavek
+     */
+    void reset();
+
+    /**
+     * @brief Zpracuje jeden přijatý bajt
+     * @param c Přijatý znak
+     * @return Stav požadavku po tomto bajtu
+     */
+    HttpParseResult feed(char c);
+
+    /**
+     * @brief Zjistí, zda je požadavek dokončen nebo chybný (další bajty se ignorují)
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Vrací metodu požadavku
+     */
+    HttpMethod getMethod() const;
+
+    /**
+     * @brief Vrací cestu bez dotazu (např. "/status")
+     */
+    const char *getPath() const;
+
+    /**
+     * @brief Vrací dotaz za '?' bez otazníku (prázdný řetězec, pokud chybí)
+     */
+    const char *getQuery() const;
+
+    /**
+     * @brief Vrací dotaz k rozložení na místě (FormParser), buffer se tím přepíše
+     */
+    char *getQuery();
+
+    /**
+     * @brief Vrací tělo požadavku (prázdný řetězec, pokud chybí)
+     */
+    const char *getBody() const;
+
+    /**
+     * @brief Vrací tělo k rozložení na místě (FormParser), buffer se tím přepíše
+     */
+    char *getBody();
+
+    /**
+     * @brief Vrací stavový kód chyby (400, 413, 414) nebo 0
+     */
+    uint16_t getError() const;
+};
+
+static_assert(httpRequestBytes >= httpBodyBytes + 2, "Telo formulare se musi vejit za cestu \"/\"");
+static_assert(httpRequestBytes >= httpTargetBytes, "Cil se musi vejit do bufferu pozadavku");
+
+#endif // HTTP_REQUEST_PARSER_H
@@ -0,0 +1,65 @@
+#include "LineParser.h"
+
+/**
+ * @brief Zahodí rozpracovaný řádek (nový klient)
+ */
+void LineParser::reset()
+{
+    length = 0;
+    overflow = false;
+    line[0] = '\0';
+}
+
+/**
+ * @brief Zpracuje jeden přijatý bajt
+ * @param c Přijatý znak
+ * @return True pokud je řádek kompletní (getLine platí do dalšího volání feed)
+ */
+bool LineParser::feed(char c)
+{
+    if (c == '\n')
+    {
+        if (overflow)
+        {
+            overflowCount++;
+            reset();
+            return false;
+        }
+
+        while (length > 0 && line[length - 1] == ' ')
+            length--;
+        line[length] = '\0';
+        length = 0;
+        return true;
+    }
+
+    if (c == '\r' || overflow)
+        return false;
+
+    if (length >= sizeof(line) - 1)
+    {
+        overflow = true;
+        return false;
+    }
+
+    if (c >= 'a' && c <= 'z')
+        c = c - 'a' + 'A';
+    line[length++] = c;
+    return false;
+}
+
+/**
+ * @brief Vrací poslední kompletní řádek (bez '\n', velkými písmeny)
+ */
+char *LineParser::getLine()
+{
+    return line;
+}
+
+/**
+ * @brief Vrací počet zahozených příliš dlouhých řádků
+ */
+uint16_t LineParser::getOverflowCount() const
+{
+    return overflowCount;
+}
@@ -0,0 +1,48 @@
+#ifndef LINE_PARSER_H
+#define LINE_PARSER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class LineParser
+ * @brief Neblokující skládání řádků příkazů po jednotlivých bajtech
+ *
+ * Bajty se předávají tak, jak přišly, nedokončený řádek zůstává v pevném
+ * bufferu do dalšího průchodu smyčkou. Znaky se převádí na velká písmena,
+ * '\r' a koncové mezery se zahazují. Řádek delší než buffer se zahodí celý
+ * až po nejbližší '\n', takže z jeho zbytku nevznikne nesmyslný příkaz.
+ */
+class LineParser
+{
+private:
+    char line[clientLineBytes]; // Rozpracovaný řádek (C-string po dokončení)
+    uint8_t length = 0;         // Počet znaků v řádku
+    bool overflow = false;      // Řádek přetekl, zahazuje se do '\n'
+    uint16_t overflowCount = 0; // Počet zahozených příliš dlouhých řádků
+
+public:
+    /**
+     * @brief Zahodí rozpracovaný řádek (nový klient)
+     */
+    void reset();
+
+    /**
+     * @brief Zpracuje jeden přijatý bajt
+     * @param c Přijatý znak
+     * @return True pokud je řádek kompletní (getLine platí do dalšího volání feed)
+     */
+    bool feed(char c);
+
+    /**
+     * @brief Vrací poslední kompletní řádek (bez '\n', velkými písmeny)
+     */
+    char *getLine();
+
+    /**
+     * @brief Vrací počet zahozených příliš dlouhých řádků
+     */
+    uint16_t getOverflowCount() const;
+};
+
+#endif // LINE_PARSER_H
@@ -0,0 +1,91 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <Arduino.h>
+
+/**
+ * @class RingBuffer
+ * @brief Kruhový buffer pro jednoho producenta a jednoho konzumenta bez zámků
+ *
+ * Producent (typicky přerušení) zapisuje pouze index head, konzument (loop)
+ * pouze index tail. Indexy jsou jednobajtové, takže jejich čtení i zápis jsou
+ * na AVR atomické a není nutné zakazovat přerušení.
+ *
+ * @tparam T Typ ukládaných prvků
+ * @tparam Capacity Kapacita bufferu (mocnina dvou, nejvýše 128)
+ */
+template <typename T, uint8_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Kapacita musi byt mocnina dvou");
+    static_assert(Capacity <= 128, "Kapacita musi byt nejvyse 128");
+
+private:
+    static const uint8_t mask = Capacity - 1;
+
+    T items[Capacity];      // Úložiště prvků
+    volatile uint8_t head;  // Index pro další zápis (mění jen producent)
+    volatile uint8_t tail;  // Index pro další čtení (mění jen konzument)
+
+    /**
+     * @brief Zabrání překladači přeskládat přístupy do paměti přes tuto hranici
+     */
+    static inline void barrier() { __asm__ __volatile__("" ::: "memory"); }
+
+public:
+    /**
+     * @brief Konstruktor prázdného bufferu
+     */
+    RingBuffer() : head(0), tail(0) {}
+
+    /**
+     * @brief Vloží prvek (volá pouze producent)
+     * @param item Vkládaný prvek
+     * @return False pokud je buffer plný a prvek byl zahozen
+     */
+    bool push(const T &item)
+    {
+        uint8_t h = head;
+        if ((uint8_t)(h - tail) >= Capacity)
+            return false;
+        items[h & mask] = item;
+        barrier();
+        head = h + 1;
+        return true;
+    }
+
+    /**
+     * @brief Vyjme nejstarší prvek (volá pouze konzument)
+     * @param item Reference pro vyjmutý prvek
+     * @return False pokud je buffer prázdný
+     */
+    bool pop(T &item)
+    {
+        uint8_t t = tail;
+        if (head == t)
+            return false;
+        barrier();
+        item = items[t & mask];
+        barrier();
+        tail = t + 1;
+        return true;
+    }
+
+    /**
+     * @brief Vrací počet prvků připravených ke čtení
+     */
+    uint8_t available() const
+    {
+        return (uint8_t)(head - tail);
+    }
+
+    /**
+     * @brief Zahodí všechny čekající prvky (volá pouze konzument)
+     */
+    void clear()
+    {
+        tail = head;
+    }
+};
+
+#endif // RING_BUFFER_H
@@ -0,0 +1,144 @@
+#include "RttHistogram.h"
+
+/**
+ * @brief Konstruktor prázdného histogramu
+ */
+RttHistogram::RttHistogram()
+{
+    reset();
+}
+
+/**
+ * @brief Vynuluje histogram
+ */
+void RttHistogram::reset()
+{
+    memset(counts, 0, sizeof(counts));
+    samples = 0;
+    lost = 0;
+    minUs = 0;
+    maxUs = 0;
+    lastUs = 0;
+}
+
+/**
+ * @brief Přidá jednu změřenou odezvu
+ * @param rttUs Doba odezvy v µs
+ */
+void RttHistogram::add(uint32_t rttUs)
+{
+    uint8_t bucket = bucketOf(rttUs);
+    if (counts[bucket] < UINT16_MAX)
+        counts[bucket]++;
+
+    if (samples == 0 || rttUs < minUs)
+        minUs = rttUs;
+    if (rttUs > maxUs)
+        maxUs = rttUs;
+    lastUs = rttUs;
+    samples++;
+}
+
+/**
+ * @brief Započítá PING, na který nepřišla odpověď
+ */
+void RttHistogram::addLost()
+{
+    lost++;
+}
+
+/**
+ * @brief Vrací index koše pro danou odezvu
+ * @param rttUs Doba odezvy v µs
+ */
+uint8_t RttHistogram::bucketOf(uint32_t rttUs)
+{
+    // Počet bitů nad spodní mezí = index koše, bez dělení a float
+    uint8_t bucket = 0;
+    for (uint32_t v = rttUs >> rttHistogramMinLog2; v && bucket < rttHistogramBuckets - 1; v >>= 1)
+        bucket++;
+    return bucket;
+}
+
+/**
+ * @brief Vrací horní mez koše v µs (poslední koš je shora otevřený)
+ * @param bucket Index koše
+ */
+uint32_t RttHistogram::getBucketLimitUs(uint8_t bucket)
+{
+    return bucket < rttHistogramBuckets - 1 ? 1UL << (rttHistogramMinLog2 + bucket) : UINT32_MAX;
+}
+
+/**
+ * @brief Vrací počet odezev v koši
+ * @param bucket Index koše
+ */
+uint16_t RttHistogram::getCount(uint8_t bucket) const
+{
+    return bucket < rttHistogramBuckets ? counts[bucket] : 0;
+}
+
+/**
+ * @brief Odhad percentilu jako horní mez koše, ve kterém leží
+ * @param percent Percentil 1 až 100
+ * @return Horní mez koše v µs, 0 pokud histogram neobsahuje žádnou odezvu
+ */
+uint32_t RttHistogram::getPercentileUs(uint8_t percent) const
+{
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < rttHistogramBuckets; i++)
+        total += counts[i];
+    if (total == 0)
+        return 0;
+
+    // Poslední koš nemá horní mez, místo ní se vrátí naměřené maximum
+    uint32_t rank = (total * percent + 99) / 100;
+    uint32_t seen = 0;
+    for (uint8_t i = 0; i < rttHistogramBuckets; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+            return i < rttHistogramBuckets - 1 && getBucketLimitUs(i) < maxUs ? getBucketLimitUs(i) : maxUs;
+    }
+    return maxUs;
+}
+
+/**
+ * @brief Vrací počet změřených odezev
+ */
+uint32_t RttHistogram::getSamples() const
+{
+    return samples;
+}
+
+/**
+ * @brief Vrací počet PINGů bez odpovědi
+ */
+uint32_t RttHistogram::getLost() const
+{
+    return lost;
+}
+
+/**
+ * @brief Vrací nejkratší odezvu v µs
+ */
+uint32_t RttHistogram::getMinUs() const
+{
+    return minUs;
+}
+
+/**
+ * @brief Vrací nejdelší odezvu v µs
+ */
+uint32_t RttHistogram::getMaxUs() const
+{
+    return maxUs;
+}
+
+/**
+ * @brief Vrací poslední odezvu v µs
+ */
+uint32_t RttHistogram::getLastUs() const
+{
+    return lastUs;
+}
@@ -0,0 +1,98 @@
+#ifndef RTT_HISTOGRAM_H
+#define RTT_HISTOGRAM_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/**
+ * @class RttHistogram
+ * @brief Histogram doby odezvy s logaritmickými koši a konstantní pamětí
+ *
+ * Koš i obsahuje odezvy pod 2^(rttHistogramMinLog2 + i) µs, tedy každý koš
+ * je dvakrát širší než předchozí. Poslední koš je shora otevřený. Čítače
+ * košů se zastaví na maximu, poměr mezi koši tím zůstane zachovaný.
+ */
+class RttHistogram
+{
+private:
+    uint16_t counts[rttHistogramBuckets]; // Počet odezev v každém koši
+    uint32_t samples;                     // Počet změřených odezev
+    uint32_t lost;                        // Počet PINGů bez odpovědi
+    uint32_t minUs;                       // Nejkratší odezva v µs
+    uint32_t maxUs;                       // Nejdelší odezva v µs
+    uint32_t lastUs;                      // Poslední odezva v µs
+
+public:
+    /**
+     * @brief Konstruktor prázdného histogramu
+     */
+    RttHistogram();
+
+    /**
+     * @brief Vynuluje histogram
+     */
+    void reset();
+
+    /**
+     * @brief Přidá jednu změřenou odezvu
+     * @param rttUs Doba odezvy v µs
+     */
+    void add(uint32_t rttUs);
+
+    /**
+     * @brief Započítá PING, na který nepřišla odpověď
+     */
+    void addLost();
+
+    /**
+     * @brief Vrací index koše pro danou odezvu
+     * @param rttUs Doba odezvy v µs
+     */
+    static uint8_t bucketOf(uint32_t rttUs);
+
+    /**
+     * @brief Vrací horní mez koše v µs (poslední koš je shora otevřený)
+     * @param bucket Index koše
+     */
+    static uint32_t getBucketLimitUs(uint8_t bucket);
+
+    /**
+     * @brief Vrací počet odezev v koši
+     * @param bucket Index koše
+     */
+    uint16_t getCount(uint8_t bucket) const;
+
+    /**
+     * @brief Odhad percentilu jako horní mez koše, ve kterém leží
+     * @param percent Percentil 1 až 100
+     * @return Horní mez koše v µs, 0 pokud histogram neobsahuje žádnou odezvu
+     */
+    uint32_t getPercentileUs(uint8_t percent) const;
+
+    /**
+     * @brief Vrací počet změřených odezev
+     */
+    uint32_t getSamples() const;
+
+    /**
+     * @brief Vrací počet PINGů bez odpovědi
+     */
+    uint32_t getLost() const;
+
+    /**
+     * @brief Vrací nejkratší odezvu v µs
+     */
+    uint32_t getMinUs() const;
+
+    /**
+     * @brief Vrací nejdelší odezvu v µs
+     */
+    uint32_t getMaxUs() const;
+
+    /**
+     * @brief Vrací poslední odezvu v µs
+     */
+    uint32_t getLastUs() const;
+};
+
+#endif // RTT_HISTOGRAM_H
@@ -0,0 +1,59 @@
+#include "RunningStats.h"
+
+/**
+ * @brief Konstruktor prázdné statistiky
+ */
+RunningStats::RunningStats()
+{
+    reset();
+}
+
+/**
+ * @brief Vynuluje statistiku
+ */
+void RunningStats::reset()
+{
+    count = 0;
+    sum = 0;
+    sumSquares = 0;
+}
+
+/**
+ * @brief Přidá jeden vzorek
+ * @param value Hodnota vzorku
+ */
+void RunningStats::add(int32_t value)
+{
+    count++;
+    sum += value;
+    sumSquares += (int64_t)value * value;
+}
+
+/**
+ * @brief Vrací počet zpracovaných vzorků
+ */
+uint32_t RunningStats::getCount() const
+{
+    return count;
+}
+
+/**
+ * @brief Vrací průměr zpracovaných vzorků
+ */
+float RunningStats::getMean() const
+{
+    return count > 0 ? (float)sum / count : 0.0;
+}
+
+/**
+ * @brief Vrací populační rozptyl zpracovaných vzorků
+ */
+float RunningStats::getVariance() const
+{
+    if (count == 0)
+        return 0.0;
+
+    // n·Σx² − (Σx)² je přesné v celých číslech, dělí se až jednou na konci
+    int64_t centered = (int64_t)count * sumSquares - sum * sum;
+    return centered > 0 ? (float)centered / ((float)count * count) : 0.0;
+}
@@ -0,0 +1,54 @@
+#ifndef RUNNING_STATS_H
+#define RUNNING_STATS_H
+
+#include <Arduino.h>
+
+/**
+ * @class RunningStats
+ * @brief Průměr a rozptyl celočíselných vzorků ze součtů (bez dělení na vzorek)
+ *
+ * Na vzorek se jen přičte hodnota a její čtverec do 64bitových součtů,
+ * průměr a rozptyl se spočítají až při dotazu. Součty stačí na ~3000 vzorků
+ * plného rozsahu Q8 (obálka 1023 LSB), tedy na celé kalibrační okno.
+ */
+class RunningStats
+{
+private:
+    uint32_t count;     // Počet zpracovaných vzorků
+    int64_t sum;        // Součet vzorků
+    int64_t sumSquares; // Součet čtverců vzorků
+
+public:
+    /**
+     * @brief Konstruktor prázdné statistiky
+     */
+    RunningStats();
+
+    /**
+     * @brief Vynuluje statistiku
+     */
+    void reset();
+
+    /**
+     * @brief Přidá jeden vzorek
+     * @param value Hodnota vzorku
+     */
+    void add(int32_t value);
+
+    /**
+     * @brief Vrací počet zpracovaných vzorků
+     */
+    uint32_t getCount() const;
+
+    /**
+     * @brief Vrací průměr zpracovaných vzorků
+     */
+    float getMean() const;
+
+    /**
+     * @brief Vrací populační rozptyl zpracovaných vzorků
+     */
+    float getVariance() const;
+};
+
+#endif // RUNNING_STATS_H
@@ -0,0 +1,141 @@
+#include "TimerWheel.h"
+
+static_assert((timerWheelBuckets & (timerWheelBuckets - 1)) == 0, "Pocet kosu casoveho kola musi byt mocnina dvou");
+static_assert(timerWheelCapacity < timerNone, "Identifikator casovace nesmi splynout s timerNone");
+
+/**
+ * @brief Zruší všechny časovače a nastaví počátek času
+ * @param nowMs Aktuální čas (millis)
+ */
+void TimerWheel::begin(unsigned long nowMs)
+{
+    for (uint8_t i = 0; i < timerWheelCapacity; i++)
+        timers[i].active = false;
+    for (uint8_t i = 0; i < timerWheelBuckets; i++)
+        buckets[i] = timerNone;
+
+    nowTick = 0;
+    nextTick = 0;
+    tickStartMs = nowMs;
+    stats = TimerStats();
+}
+
+/**
+ * @brief Vyjme časovač ze seznamu jeho koše
+ */
+void TimerWheel::unlink(uint8_t id)
+{
+    Timer &t = timers[id];
+    if (t.prev != timerNone)
+        timers[t.prev].next = t.next;
+    else
+        buckets[t.due & (timerWheelBuckets - 1)] = t.next;
+    if (t.next != timerNone)
+        timers[t.next].prev = t.prev;
+    t.active = false;
+}
+
+/**
+ * @brief Naplánuje (nebo přeplánuje) časovač
+ * @param id Identifikátor časovače
+ * @param delayMs Zpoždění v ms (přesnost jeden tik timerWheelTickMs, nejméně jeden tik)
+ */
+void TimerWheel::schedule(uint8_t id, uint16_t delayMs)
+{
+    if (id >= timerWheelCapacity)
+        return;
+    if (timers[id].active)
+        unlink(id);
+
+    uint16_t ticks = (delayMs + timerWheelTickMs - 1) / timerWheelTickMs;
+    Timer &t = timers[id];
+    t.due = nowTick + (ticks ? ticks : 1);
+    t.active = true;
+
+    // Nový časovač jde na začátek seznamu koše
+    uint8_t &head = buckets[t.due & (timerWheelBuckets - 1)];
+    t.prev = timerNone;
+    t.next = head;
+    if (head != timerNone)
+        timers[head].prev = id;
+    head = id;
+}
+
+/**
+ * @brief Zruší časovač (neplánovaný časovač se ignoruje)
+ * @param id Identifikátor časovače
+ */
+void TimerWheel::cancel(uint8_t id)
+{
+    if (id < timerWheelCapacity && timers[id].active)
+        unlink(id);
+}
+
+/**
+ * @brief Vrací příznak naplánovaného časovače
+ * @param id Identifikátor časovače
+ */
+bool TimerWheel::isActive(uint8_t id) const
+{
+    return id < timerWheelCapacity && timers[id].active;
+}
+
+/**
+ * @brief Vrací další vypršelý časovač (jeden za volání, ostatní zůstávají v kole)
+ * @param nowMs Aktuální čas (millis)
+ * @return Identifikátor vypršelého časovače nebo timerNone
+ */
+uint8_t TimerWheel::poll(unsigned long nowMs)
+{
+    // Tiky se odečítají z rozdílu časů, přetečení millis nevadí
+    while (nowMs - tickStartMs >= timerWheelTickMs)
+    {
+        tickStartMs += timerWheelTickMs;
+        nowTick++;
+    }
+
+    // Každý uplynulý tik projde svůj koš; časovače dalších otáček v něm zůstanou
+    while ((int16_t)(nowTick - nextTick) >= 0)
+    {
+        for (uint8_t id = buckets[nextTick & (timerWheelBuckets - 1)]; id != timerNone; id = timers[id].next)
+        {
+            if (timers[id].due != nextTick)
+                continue;
+
+            unlink(id);
+            uint16_t lateMs = (uint16_t)(nowTick - nextTick) * timerWheelTickMs;
+            stats.fired++;
+            if (lateMs > 0)
+                stats.late++;
+            if (lateMs > stats.maxLateMs)
+                stats.maxLateMs = lateMs;
+            return id;
+        }
+        nextTick++;
+    }
+    return timerNone;
+}
+
+/**
+ * @brief Uzavře průchod smyčky a zapíše, kolik vypršelých časovačů čeká na další
+ */
+void TimerWheel::endPass()
+{
+    // Projde všechny časovače (jen timerWheelCapacity), ne koše všech zameškaných tiků
+    uint16_t waiting = 0;
+    for (uint8_t id = 0; id < timerWheelCapacity; id++)
+    {
+        if (timers[id].active && (int16_t)(nowTick - timers[id].due) >= 0)
+            waiting++;
+    }
+    if (waiting > stats.maxCatchUp)
+        stats.maxCatchUp = waiting;
+}
+
+/**
+ * @brief Vrací čítače spuštění a zpoždění
+ */
+const TimerStats &TimerWheel::getStats() const
+{
+    return stats;
+}
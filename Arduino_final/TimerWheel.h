@@ -0,0 +1,103 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+const uint8_t timerNone = 0xFF; // Žádný časovač (prázdný seznam, nic nevypršelo)
+
+/**
+ * @struct TimerStats
+ * @brief Čítače spuštěných a opožděných časovačů
+ */
+struct TimerStats
+{
+    uint32_t fired = 0;      // Počet spuštěných časovačů
+    uint32_t late = 0;       // Spuštěné aspoň o jeden tik později (smyčka se zdržela)
+    uint16_t maxLateMs = 0;  // Největší zpoždění spuštění v ms
+    uint16_t maxCatchUp = 0; // Nejvíc vypršelých časovačů odložených na další průchod smyčky
+};
+
+/**
+ * @class TimerWheel
+ * @brief Časové kolo s pevným počtem časovačů pro odložené akce
+ *
+ * Časovače mají pevné identifikátory 0 až timerWheelCapacity - 1 a leží
+ * v obousměrných seznamech košů podle tiku vypršení (timerWheelTickMs).
+ * Naplánování i zrušení je O(1), poll za každý uplynulý tik projde jen
+ * jeden koš a vrátí nejvýš jeden časovač; kolik jich volající obslouží
+ * za průchod smyčky, určuje on (nevyřízené počkají na další průchod). Časovač o víc než jednu otáčku kola čeká v koši, dokud jeho
+ * tik nepřijde znovu. Bez alokace na haldě.
+ */
+class TimerWheel
+{
+private:
+    /**
+     * @struct Timer
+     * @brief Uzel seznamu koše
+     */
+    struct Timer
+    {
+        uint16_t due; // Tik vypršení
+        uint8_t prev; // Předchozí časovač v koši
+        uint8_t next; // Další časovač v koši
+        bool active;  // Časovač je naplánovaný
+    };
+
+    Timer timers[timerWheelCapacity];   // Časovače podle identifikátoru
+    uint8_t buckets[timerWheelBuckets]; // První časovač každého koše
+    uint16_t nowTick = 0;               // Aktuální tik (podle millis)
+    uint16_t nextTick = 0;              // Další tik, jehož koš se má projít
+    unsigned long tickStartMs = 0;      // Čas začátku aktuálního tiku
+    TimerStats stats;                   // Čítače spuštění a zpoždění
+
+    /**
+     * @brief Vyjme časovač ze seznamu jeho koše
+     */
+    void unlink(uint8_t id);
+
+public:
+    /**
+     * @brief Zruší všechny časovače a nastaví počátek času
+     * @param nowMs Aktuální čas (millis)
+     */
+    void begin(unsigned long nowMs);
+
+    /**
+     * @brief Naplánuje (nebo přeplánuje) časovač
+     * @param id Identifikátor časovače
+     * @param delayMs Zpoždění v ms (přesnost jeden tik timerWheelTickMs, nejméně jeden tik)
+     */
+    void schedule(uint8_t id, uint16_t delayMs);
+
+    /**
+     * @brief Zruší časovač (neplánovaný časovač se ignoruje)
+     * @param id Identifikátor časovače
+     */
+    void cancel(uint8_t id);
+
+    /**
+     * @brief Vrací příznak naplánovaného časovače
+     * @param id Identifikátor časovače
+     */
+    bool isActive(uint8_t id) const;
+
+    /**
+     * @brief Vrací další vypršelý časovač (jeden za volání, ostatní zůstávají v kole)
+     * @param nowMs Aktuální čas (millis)
+     * @return Identifikátor vypršelého časovače nebo timerNone
+     */
+    uint8_t poll(unsigned long nowMs);
+
+    /**
+     * @brief Uzavře průchod smyčky a zapíše, kolik vypršelých časovačů čeká na další
+     */
+    void endPass();
+
+    /**
+     * @brief Vrací čítače spuštění a zpoždění
+     */
+    const TimerStats &getStats() const;
+};
+
+#endif // TIMER_WHEEL_H
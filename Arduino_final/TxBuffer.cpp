@@ -0,0 +1,149 @@
+#include "TxBuffer.h"
+
+/**
+ * @brief Konstruktor bufferu pro dané spojení
+ * @param target Klient, kterému se zprávy posílají
+ * @param storage Paměť bufferu
+ * @param size Velikost paměti v bajtech
+ */
+TxBuffer::TxBuffer(WiFiClient &target, uint8_t *storage, uint8_t size) : client(target), data(storage), capacity(size)
+{
+}
+
+/**
+ * @brief Připíše bajt do bufferu
+ */
+size_t TxBuffer::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+/**
+ * @brief Připíše blok do bufferu (při zaplnění vyprázdní buffer)
+ * @return Počet přijatých bajtů, 0 pokud předchozí vyprázdnění selhalo
+ */
+size_t TxBuffer::write(const uint8_t *buffer, size_t size)
+{
+    // Za nedoručenými daty by blok navázal na neúplnou zprávu
+    if (failed)
+    {
+        stats.droppedBytes += size;
+        return 0;
+    }
+
+    if (length + size > capacity)
+    {
+        if (length > 0)
+        {
+            stats.overflowFlushes++;
+            if (!flush(false))
+            {
+                stats.droppedBytes += size;
+                return 0;
+            }
+        }
+        // Blok delší než celý buffer se nekopíruje, odejde přímo jedním zápisem
+        if (size > capacity)
+        {
+            stats.flushes++;
+            windowFlushes++;
+            return transmit(buffer, size);
+        }
+    }
+
+    memcpy(data + length, buffer, size);
+    length += size;
+    return size;
+}
+
+/**
+ * @brief Zapíše blok do klienta a započte ho
+ * @return Počet bajtů, které modul přijal
+ */
+size_t TxBuffer::transmit(const uint8_t *buffer, size_t size)
+{
+    size_t written = client.write(buffer, size);
+    stats.writeCalls++;
+    windowWriteCalls++;
+    stats.bytes += written;
+    windowBytes += written;
+    stats.droppedBytes += size - written;
+    if (written != size)
+        failed = true;
+    return written;
+}
+
+/**
+ * @brief Odešle obsah bufferu jedním zápisem
+ * @param urgent True pro naléhavou zprávu (příkaz), jen pro statistiku
+ * @return False pokud modul nepřijal všechna data
+ */
+bool TxBuffer::flush(bool urgent)
+{
+    if (length == 0)
+        return true;
+
+    size_t written = transmit(data, length);
+    bool complete = written == length;
+    length = 0;
+
+    stats.flushes++;
+    windowFlushes++;
+    if (urgent)
+        stats.urgentFlushes++;
+    return complete;
+}
+
+/**
+ * @brief Konec průchodu smyčkou - odešle, co se nasbíralo, a přepočte rychlosti
+ */
+void TxBuffer::endTick()
+{
+    flush(false);
+
+    unsigned long now = millis();
+    unsigned long elapsed = now - windowStart;
+    if (elapsed < 1000)
+        return;
+
+    stats.bytesPerSecond = windowBytes * 1000UL / elapsed;
+    stats.flushesPerSecond = (uint32_t)windowFlushes * 1000UL / elapsed;
+    stats.writeCallsPerSecond = (uint32_t)windowWriteCalls * 1000UL / elapsed;
+    windowBytes = 0;
+    windowFlushes = 0;
+    windowWriteCalls = 0;
+    windowStart = now;
+}
+
+/**
+ * @brief Zahodí neodeslaný obsah a chybu zápisu (odpojený nebo nový klient)
+ */
+void TxBuffer::clear()
+{
+    length = 0;
+    failed = false;
+}
+
+/**
+ * @brief Vrací true, pokud modul nepřijal všechna data (proud na spojení je přerušený)
+ */
+bool TxBuffer::hasFailed() const
+{
+    return failed;
+}
+
+/**
+ * @brief Vrací počet bajtů čekajících v bufferu
+ */
+uint8_t TxBuffer::pending() const
+{
+    return length;
+}
+
+/**
+ * @brief Vrací čítače bufferu
+ */
+const TxStats &TxBuffer::getStats() const
+{
+    return stats;
+}
@@ -0,0 +1,114 @@
+#ifndef TX_BUFFER_H
+#define TX_BUFFER_H
+
+#include <Arduino.h>
+#include <WiFiNINA.h>
+#include "Config.h"
+
+/**
+ * @struct TxStats
+ * @brief Čítače výstupního bufferu (celkové a za poslední celou sekundu)
+ */
+struct TxStats
+{
+    uint32_t bytes = 0;               // Počet odeslaných bajtů
+    uint32_t flushes = 0;             // Počet vyprázdnění bufferu
+    uint32_t urgentFlushes = 0;       // Z toho vynucených naléhavou zprávou
+    uint32_t overflowFlushes = 0;     // Z toho vynucených zaplněním kapacity
+    uint32_t writeCalls = 0;          // Počet volání client.write (transakcí SPI s modulem NINA)
+    uint32_t droppedBytes = 0;        // Bajty, které modul nepřijal
+    uint32_t bytesPerSecond = 0;      // Bajty za poslední celou sekundu
+    uint16_t flushesPerSecond = 0;    // Vyprázdnění za poslední celou sekundu
+    uint16_t writeCallsPerSecond = 0; // Volání client.write za poslední celou sekundu
+};
+
+/**
+ * @class TxBuffer
+ * @brief Výstupní buffer, který spojí všechny zprávy jednoho průchodu smyčkou
+ *
+ * Každé client.print je u WiFiNINA samostatná transakce SPI s koprocesorem
+ * (stovky µs). Zprávy se proto jen připisují do bufferu a na konci průchodu
+ * (endTick) odejdou jedním client.write. Příkazy pro robota se odesílají
+ * s příznakem naléhavosti, který buffer vyprázdní hned. Při zaplnění
+ * kapacity se buffer vyprázdní předčasně; blok delší než kapacita se po
+ * vyprázdnění zapíše přímo. Paměť bufferu patří vlastníkovi, klienti TCP
+ * a HTTP spojení tak mají každý svou kapacitu.
+ * Pokud modul nepřijme všechna data, proud na spojení už není celistvý:
+ * buffer si chybu pamatuje, další zápisy zahazuje (vrací 0) a vlastník má
+ * spojení zavřít (hasFailed). Chybu smaže až clear() pro nové spojení.
+ */
+class TxBuffer : public Print
+{
+private:
+    WiFiClient &client;            // Cílové spojení
+    uint8_t *data;                 // Zprávy čekající na odeslání (paměť vlastníka)
+    uint8_t capacity;              // Velikost paměti data
+    uint8_t length = 0;            // Počet bajtů v bufferu
+    bool failed = false;           // Modul nepřijal část dat, další zápisy se zahazují
+    TxStats stats;                 // Čítače
+    unsigned long windowStart = 0; // Začátek okna měření za sekundu
+    uint32_t windowBytes = 0;      // Bajty v aktuálním okně
+    uint16_t windowFlushes = 0;    // Vyprázdnění v aktuálním okně
+    uint16_t windowWriteCalls = 0; // Volání client.write v aktuálním okně
+
+    /**
+     * @brief Zapíše blok do klienta a započte ho
+     * @return Počet bajtů, které modul přijal
+     */
+    size_t transmit(const uint8_t *buffer, size_t size);
+
+public:
+    /**
+     * @brief Konstruktor bufferu pro dané spojení
+     * @param target Klient, kterému se zprávy posílají
+     * @param storage Paměť bufferu
+     * @param size Velikost paměti v bajtech
+     */
+    TxBuffer(WiFiClient &target, uint8_t *storage, uint8_t size);
+
+    /**
+     * @brief Připíše bajt do bufferu
+     */
+    size_t write(uint8_t c) override;
+
+    /**
+     * @brief Připíše blok do bufferu (při zaplnění vyprázdní buffer)
+     * @return Počet přijatých bajtů, 0 pokud předchozí vyprázdnění selhalo
+     */
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+
+    /**
+     * @brief Odešle obsah bufferu jedním zápisem
+     * @param urgent True pro naléhavou zprávu (příkaz), jen pro statistiku
+     * @return False pokud modul nepřijal všechna data
+     */
+    bool flush(bool urgent);
+
+    /**
+     * @brief Konec průchodu smyčkou - odešle, co se nasbíralo, a přepočte rychlosti
+     */
+    void endTick();
+
+    /**
+     * @brief Zahodí neodeslaný obsah a chybu zápisu (odpojený nebo nový klient)
+     */
+    void clear();
+
+    /**
+     * @brief Vrací true, pokud modul nepřijal všechna data (proud na spojení je přerušený)
+     */
+    bool hasFailed() const;
+
+    /**
+     * @brief Vrací počet bajtů čekajících v bufferu
+     */
+    uint8_t pending() const;
+
+    /**
+     * @brief Vrací čítače bufferu
+     */
+    const TxStats &getStats() const;
+};
+
+#endif // TX_BUFFER_H
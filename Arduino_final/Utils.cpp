@@ -1,4 +1,5 @@
 #include "Utils.h"
+#include <avr/pgmspace.h>
 #include <avr/wdt.h>
 
 /**
@@ -27,8 +28,33 @@ void printIfPinLow(const __FlashStringHelper *message, int pin)
     }
 }
 
+// Hodnota hexadecimální číslice pro znaky ASCII, 0xFF = není číslice
+static const uint8_t hexDigitValues[128] PROGMEM = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
 /**
- * @brief Utility funkce pro práci s řetězci a URL dekódování
+ * @brief Vrací hodnotu hexadecimální číslice (0-15) nebo 0xFF
+ * @param c Znak
+ */
+uint8_t hexDigitValue(char c)
+{
+    return (uint8_t)c < 128 ? pgm_read_byte(&hexDigitValues[(uint8_t)c]) : 0xFF;
+}
+
+/**
+ * @brief Dekóduje URL (application/x-www-form-urlencoded)
+ *
+ * Dekóduje všechny sekvence %XX (velká i malá písmena) a '+' na mezeru.
+ * Neplatná sekvence (např. "%zz" nebo '%' na konci) se zkopíruje beze změny.
+ * Výstup není nikdy delší než vstup, buffer proto smí být přímo str.
  * @param str Řetězec k dekódování (C-string)
  * @param buffer Buffer pro dekódovaný řetězec
  * @param bufferSize Velikost bufferu
@@ -39,147 +65,123 @@ int urlDecode(const char *str, char *buffer, int bufferSize)
     if (!str || !buffer || bufferSize <= 0)
         return -1;
 
-    int srcLen = strlen(str);
     int destIndex = 0;
-
-    for (int i = 0; i < srcLen && destIndex < bufferSize - 1; i++)
+    while (*str && destIndex < bufferSize - 1)
     {
-        if (str[i] == '+')
+        char c = *str++;
+        if (c == '%')
         {
-            buffer[destIndex++] = ' ';
-        }
-        else if (str[i] == '%' && i + 2 < srcLen)
-        {
-            // Convert hex to number more efficiently
-            char c1 = str[i + 1];
-            char c2 = str[i + 2];
-
-            // Simple hex decode for most common cases
-            if (c1 == '2')
-            {
-                switch (c2)
-                {
-                case '0':
-                    buffer[destIndex++] = ' ';
-                    break;
-                case '1':
-                    buffer[destIndex++] = '!';
-                    break;
-                case '2':
-                    buffer[destIndex++] = '"';
-                    break;
-                case '3':
-                    buffer[destIndex++] = '#';
-                    break;
-                case '4':
-                    buffer[destIndex++] = '$';
-                    break;
-                case '5':
-                    buffer[destIndex++] = '%';
-                    break;
-                case '6':
-                    buffer[destIndex++] = '&';
-                    break;
-                case '7':
-                    buffer[destIndex++] = '\'';
-                    break;
-                case '8':
-                    buffer[destIndex++] = '(';
-                    break;
-                case '9':
-                    buffer[destIndex++] = ')';
-                    break;
-                case 'A':
-                case 'a':
-                    buffer[destIndex++] = '*';
-                    break;
-                case 'B':
-                case 'b':
-                    buffer[destIndex++] = '+';
-                    break;
-                case 'C':
-                case 'c':
-                    buffer[destIndex++] = ',';
-                    break;
-                case 'D':
-                case 'd':
-                    buffer[destIndex++] = '-';
-                    break;
-                case 'E':
-                case 'e':
-                    buffer[destIndex++] = '.';
-                    break;
-                case 'F':
-                case 'f':
-                    buffer[destIndex++] = '/';
-                    break;
-                default:
-                    buffer[destIndex++] = str[i];
-                    if (destIndex < bufferSize - 1)
-                        buffer[destIndex++] = c1;
-                    if (destIndex < bufferSize - 1)
-                        buffer[destIndex++] = c2;
-                    break;
-                }
-            }
-            else if (c1 == '3')
-            {
-                switch (c2)
-                {
-                case 'A':
-                case 'a':
-                    buffer[destIndex++] = ':';
-                    break;
-                case 'B':
-                case 'b':
-                    buffer[destIndex++] = ';';
-                    break;
-                case 'C':
-                case 'c':
-                    buffer[destIndex++] = '<';
-                    break;
-                case 'D':
-                case 'd':
-                    buffer[destIndex++] = '=';
-                    break;
-                case 'E':
-                case 'e':
-                    buffer[destIndex++] = '>';
-                    break;
-                case 'F':
-                case 'f':
-                    buffer[destIndex++] = '?';
-                    break;
-                default:
-                    buffer[destIndex++] = str[i];
-                    if (destIndex < bufferSize - 1)
-                        buffer[destIndex++] = c1;
-                    if (destIndex < bufferSize - 1)
-                        buffer[destIndex++] = c2;
-                    break;
-                }
-            }
-            else
+            // Druhá číslice se čte, jen když první není konec řetězce
+            uint8_t high = hexDigitValue(str[0]);
+            uint8_t low = high != 0xFF ? hexDigitValue(str[1]) : 0xFF;
+            if (((high | low) & 0xF0) == 0)
             {
-                // For other hex codes, just copy original characters
-                buffer[destIndex++] = str[i];
-                if (destIndex < bufferSize - 1)
-                    buffer[destIndex++] = c1;
-                if (destIndex < bufferSize - 1)
-                    buffer[destIndex++] = c2;
+                c = (char)(high << 4 | low);
+                str += 2;
             }
-            i += 2; // Skip the next two characters
         }
-        else
+        else if (c == '+')
         {
-            buffer[destIndex++] = str[i];
+            c = ' ';
         }
+        buffer[destIndex++] = c;
     }
 
     buffer[destIndex] = '\0';
     return destIndex;
 }
 
+/**
+ * @brief Celočíselná odmocnina bez použití float
+ * @param value Vstupní hodnota
+ * @return Dolní celá část druhé odmocniny
+ */
+uint16_t isqrt32(uint32_t value)
+{
+    uint32_t result = 0;
+    uint32_t bit = 1UL << 30;
+
+    // Nejvyšší mocnina čtyř, která není větší než vstup
+    while (bit > value)
+        bit >>= 2;
+
+    while (bit != 0)
+    {
+        if (value >= result + bit)
+        {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        }
+        else
+        {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint16_t)result;
+}
+
+/**
+ * @brief CRC-16/CCITT (polynom 0x1021) pro kontrolu dat v EEPROM
+ * @param data Data
+ * @param length Délka dat v bajtech
+ * @param crc Počáteční hodnota (pro navázání výpočtu)
+ * @return Kontrolní součet
+ */
+uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc)
+{
+    while (length--)
+    {
+        crc ^= (uint16_t)*data++ << 8;
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+#ifdef __AVR__
+extern char __heap_start;
+extern char *__brkval;
+#endif
+static const uint8_t memoryPaint = 0xA5; // Značka nepoužité SRAM
+
+/**
+ * @brief Vyplní volnou SRAM mezi haldou a zásobníkem značkou (volat na začátku setup)
+ */
+void paintFreeMemory()
+{
+#ifdef __AVR__
+    char *p = __brkval ? __brkval : &__heap_start;
+    char top;
+
+    // Rezerva pro rámec této funkce, zásobník pod ní se nepřepisuje
+    while (p < &top - 16)
+        *p++ = memoryPaint;
+#endif
+}
+
+/**
+ * @brief Vrací počet bajtů volné SRAM, na které od paintFreeMemory nesáhl zásobník ani halda
+ */
+uint16_t getUntouchedMemory()
+{
+#ifdef __AVR__
+    const char *p = __brkval ? __brkval : &__heap_start;
+    char top;
+    uint16_t count = 0;
+
+    // Zásobník roste shora, souvislý úsek značek nad haldou je nejmenší rezerva
+    while (p < &top && *(const uint8_t *)p == memoryPaint)
+    {
+        p++;
+        count++;
+    }
+    return count;
+#else
+    return 0;
+#endif
+}
+
 /**
  * @brief Restartuje Arduino pomocí watchdog timeru
  */
@@ -18,7 +18,17 @@ void printIfPinLow(const char *message, int pin);
 void printIfPinLow(const __FlashStringHelper *message, int pin);
 
 /**
- * @brief Utility funkce pro práci s řetězci a URL dekódování
+ * @brief Vrací hodnotu hexadecimální číslice (0-15) nebo 0xFF (tabulka v PROGMEM)
+ * @param c Znak
+ */
+uint8_t hexDigitValue(char c);
+
+/**
+ * @brief Dekóduje URL (application/x-www-form-urlencoded)
+ *
+ * Dekóduje všechny sekvence %XX a '+' na mezeru, neplatné sekvence ponechá.
+ * Buffer smí být přímo str (dekódování na místě). Sekvence %00 ukončí
+ * C-string předčasně, vrácený počet ji ale zahrnuje.
  * @param str Řetězec k dekódování (C-string)
  * @param buffer Buffer pro dekódovaný řetězec
  * @param bufferSize Velikost bufferu
@@ -26,6 +36,34 @@ void printIfPinLow(const __FlashStringHelper *message, int pin);
  */
 int urlDecode(const char *str, char *buffer, int bufferSize);
 
+/**
+ * @brief Celočíselná odmocnina bez použití float
+ * @param value Vstupní hodnota
+ * @return Dolní celá část druhé odmocniny
+ */
+uint16_t isqrt32(uint32_t value);
+
+/**
+ * @brief CRC-16/CCITT (polynom 0x1021) pro kontrolu dat v EEPROM
+ * @param data Data
+ * @param length Délka dat v bajtech
+ * @param crc Počáteční hodnota (pro navázání výpočtu)
+ * @return Kontrolní součet
+ */
+uint16_t crc16(const uint8_t *data, size_t length, uint16_t crc = 0xFFFF);
+
+/**
+ * @brief Vyplní volnou SRAM mezi haldou a zásobníkem značkou (volat na začátku setup)
+ */
+void paintFreeMemory();
+
+/**
+ * @brief Vrací počet bajtů volné SRAM, na které od paintFreeMemory nesáhl zásobník ani halda
+ *
+ * Nejmenší rezerva SRAM za dobu běhu; mimo AVR vrací 0.
+ */
+uint16_t getUntouchedMemory();
+
 /**
  * @brief Restartuje Arduino pomocí watchdog timeru
  */
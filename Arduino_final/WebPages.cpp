@@ -0,0 +1,297 @@
+// Vygenerováno skriptem web/build_pages.py ze šablon web/*.html - neupravovat ručně
+#include "WebPages.h"
+
+static const uint8_t webConfigPageSegment0[] PROGMEM = {
+    0x84, 0x55, 0xcd, 0xae, 0xe3, 0x34, 0x14, 0xde, 0xf7, 0x29, 0x8c, 0xae, 0x50, 0x40, 0xba, 0xe9,
+    0x4d, 0x9a, 0xa6, 0x4d, 0xd3, 0xb4, 0x62, 0x34, 0xdc, 0x61, 0x85, 0x06, 0x89, 0x41, 0x08, 0xa1,
+    0x59, 0x38, 0xb6, 0xd3, 0x58, 0x37, 0xb1, 0x23, 0xdb, 0xe9, 0x0f, 0x51, 0xde, 0x80, 0x25, 0xfb,
+    0xd1, 0x2c, 0x59, 0x20, 0x9e, 0x60, 0x56, 0x15, 0xef, 0xc3, 0x23, 0xe0, 0xfc, 0x36, 0x69, 0x0b,
+    0x6c, 0x52, 0x35, 0xce, 0xf9, 0xce, 0xf9, 0xbe, 0x73, 0x3e, 0x9f, 0xe0, 0xb3, 0xaf, 0xdf, 0xbe,
+    0x7e, 0xf7, 0xd3, 0x77, 0xcf, 0x20, 0x56, 0x69, 0xb2, 0x0d, 0xda, 0x27, 0x81, 0x78, 0x3b, 0x09,
+    0x52, 0xa2, 0x20, 0x40, 0x31, 0x14, 0x92, 0xa8, 0x8d, 0xf1, 0xc3, 0xbb, 0x37, 0xa6, 0x67, 0x6c,
+    0x9b, 0xb7, 0x0c, 0xa6, 0x64, 0x63, 0xec, 0x29, 0x39, 0x64, 0x5c, 0x28, 0x03, 0x20, 0xce, 0x14,
+    0x61, 0xfa, 0xab, 0x03, 0xc5, 0x2a, 0xde, 0x60, 0xb2, 0xa7, 0x88, 0x98, 0xf5, 0x9f, 0x47, 0xca,
+    0xa8, 0xa2, 0x30, 0x31, 0x25, 0x82, 0x09, 0xd9, 0xd8, 0x53, 0xcb, 0xd0, 0xd8, 0x8a, 0xaa, 0x84,
+    0x6c, 0x5f, 0x09, 0x9c, 0x53, 0xc6, 0xc1, 0xf3, 0xb7, 0xdf, 0x00, 0x13, 0xfc, 0x48, 0xdf, 0x50,
+    0xf0, 0x9a, 0xb3, 0x88, 0xee, 0x82, 0xa7, 0xe6, 0x83, 0x49, 0x20, 0xd5, 0x49, 0xff, 0x86, 0x1c,
+    0x9f, 0x8a, 0x48, 0x27, 0x31, 0x23, 0x98, 0xd2, 0xe4, 0xe4, 0xbf, 0x12, 0x1a, 0xf2, 0x51, 0x42,
+    0x26, 0x4d, 0x49, 0x04, 0x8d, 0xd6, 0x29, 0x14, 0x3b, 0xca, 0xfc, 0x99, 0x95, 0x1d, 0xd7, 0x21,
+    0x44, 0x2f, 0x3b, 0xc1, 0x73, 0x86, 0xfd, 0x87, 0xc5, 0x62, 0x49, 0x08, 0x5c, 0x23, 0x9e, 0x70,
+    0xe1, 0x3f, 0x38, 0x8e, 0x53, 0x4e, 0xa6, 0x55, 0xb5, 0x90, 0x32, 0x22, 0x8a, 0x14, 0x1e, 0x9b,
+    0x2a, 0xfd, 0x85, 0x55, 0x45, 0xb6, 0x28, 0x16, 0x80, 0xb9, 0xe2, 0x43, 0x9c, 0x43, 0x4c, 0x15,
+    0x59, 0x87, 0x5c, 0x60, 0x22, 0x4c, 0x01, 0x31, 0xcd, 0xa5, 0x6f, 0x57, 0x11, 0x19, 0xc4, 0x98,
+    0xb2, 0x9d, 0x3f, 0x73, 0xb3, 0x63, 0x39, 0x89, 0xed, 0xa2, 0xcd, 0x34, 0x43, 0x0e, 0x71, 0xad,
+    0xb5, 0x22, 0x47, 0x65, 0xc2, 0x84, 0xee, 0x98, 0x8f, 0xb4, 0x40, 0x44, 0xb4, 0x29, 0xcc, 0x90,
+    0x2b, 0xc5, 0xd3, 0x06, 0xa3, 0x26, 0x26, 0xe9, 0x2f, 0xc4, 0x9f, 0x91, 0xb4, 0x8c, 0x6d, 0xdf,
+    0x0f, 0x49, 0xc4, 0x05, 0x29, 0x5a, 0x59, 0x7d, 0xe3, 0xef, 0x0f, 0xbf, 0xfd, 0x6a, 0x74, 0xa1,
+    0x82, 0xee, 0x62, 0x55, 0x47, 0x6a, 0x2e, 0x32, 0x0f, 0x6b, 0xa9, 0x8a, 0xdb, 0x4c, 0x6d, 0x25,
+    0xcb, 0xc8, 0x43, 0x1e, 0xbe, 0xca, 0x5b, 0x95, 0xdb, 0xe6, 0xad, 0x04, 0xf6, 0xa9, 0xd2, 0xa1,
+    0xa8, 0x23, 0xd8, 0x7d, 0x94, 0x1d, 0x81, 0xe4, 0x09, 0xc5, 0xe0, 0x81, 0xa0, 0xc8, 0x8a, 0xec,
+    0x8e, 0x6d, 0x5f, 0x7d, 0x43, 0x7a, 0xd6, 0x91, 0x76, 0xe6, 0xf3, 0x95, 0x4b, 0xfa, 0x5e, 0xe8,
+    0x53, 0x60, 0x01, 0xdb, 0x1d, 0x51, 0xb4, 0xa7, 0x0e, 0x49, 0xbb, 0x44, 0x09, 0x89, 0x94, 0x3f,
+    0xbf, 0xa4, 0x71, 0xe6, 0x2b, 0x0f, 0x87, 0x7d, 0x9a, 0xfa, 0xb8, 0x49, 0x32, 0x95, 0x0a, 0xaa,
+    0x5c, 0x16, 0x9d, 0xde, 0xf6, 0xac, 0x6a, 0xf4, 0xa8, 0x1f, 0x5e, 0xdf, 0xc0, 0x9e, 0x40, 0xaf,
+    0xee, 0x81, 0xd4, 0xa2, 0x85, 0x3c, 0xc1, 0xb7, 0x3d, 0xe9, 0xd1, 0xa7, 0x30, 0x2b, 0x86, 0xc3,
+    0x13, 0x45, 0x04, 0xc2, 0x65, 0x9b, 0x66, 0x24, 0x87, 0xbd, 0xb4, 0x5c, 0xb7, 0x53, 0x78, 0x86,
+    0x9d, 0xb9, 0xb3, 0xb8, 0xa0, 0xe8, 0xb6, 0x31, 0x82, 0x14, 0xc1, 0x23, 0x30, 0xcb, 0x0a, 0xbd,
+    0xd5, 0xfc, 0x0e, 0x98, 0x65, 0x41, 0xcb, 0xeb, 0xc0, 0xea, 0x41, 0xd3, 0x50, 0xba, 0xff, 0xa9,
+    0x59, 0x85, 0x66, 0xc5, 0x2d, 0xa7, 0x32, 0x81, 0x21, 0x49, 0x0a, 0x4c, 0x65, 0x96, 0xc0, 0x93,
+    0x1f, 0x26, 0x1c, 0xbd, 0x5c, 0x51, 0x77, 0xaf, 0x98, 0xeb, 0xf9, 0x5e, 0x8f, 0x46, 0xb3, 0x9c,
+    0x50, 0x96, 0xe5, 0xea, 0x67, 0x75, 0xca, 0xb4, 0x95, 0x2b, 0x4d, 0x8c, 0xf7, 0x8f, 0xc3, 0x57,
+    0x19, 0x94, 0xf2, 0xa0, 0x8b, 0x35, 0xde, 0x17, 0x8d, 0x45, 0x6c, 0xcb, 0xfa, 0x7c, 0x7d, 0x47,
+    0xff, 0x21, 0x17, 0x8c, 0xf1, 0x55, 0x57, 0xae, 0xba, 0x3f, 0xaf, 0xc3, 0x8e, 0xd5, 0xbf, 0x0a,
+    0xa6, 0x1f, 0xb8, 0x63, 0x5b, 0x8f, 0x1f, 0x71, 0xa4, 0xdb, 0xcc, 0x73, 0x95, 0x68, 0x87, 0xfa,
+    0x8c, 0xb3, 0xde, 0x76, 0xfd, 0x90, 0x55, 0x33, 0x52, 0x4e, 0xc2, 0x5c, 0x13, 0x65, 0xa3, 0x92,
+    0xb5, 0x19, 0x52, 0xaa, 0x79, 0x8c, 0x74, 0x6f, 0x67, 0x6a, 0x20, 0xef, 0x88, 0x04, 0xa8, 0xad,
+    0xd0, 0x32, 0x19, 0xa6, 0xfb, 0xf7, 0xfa, 0x51, 0x2e, 0xa4, 0xc6, 0xca, 0x38, 0x1d, 0x3a, 0xba,
+    0xb1, 0xa5, 0x77, 0xab, 0x7b, 0x57, 0xaa, 0x1f, 0xf3, 0x3d, 0x11, 0x77, 0x0b, 0x6e, 0x8e, 0x46,
+    0x65, 0xcf, 0x56, 0x9e, 0x15, 0xae, 0xca, 0x69, 0xa8, 0x98, 0xbe, 0xe2, 0xd0, 0xe8, 0x6c, 0xe5,
+    0x42, 0x17, 0x2e, 0xfa, 0xb3, 0x3b, 0xd1, 0x8d, 0xe9, 0xf5, 0x1c, 0x51, 0x16, 0xf1, 0x4a, 0xde,
+    0xf1, 0x5c, 0x7b, 0xd1, 0x2a, 0x82, 0x97, 0xbb, 0xcb, 0xfa, 0x0f, 0x2f, 0xd5, 0xa7, 0xc0, 0xea,
+    0x14, 0xb2, 0x07, 0xbd, 0x26, 0x64, 0x46, 0x16, 0x5d, 0x0e, 0xad, 0x6b, 0x5a, 0xdc, 0xb9, 0xdc,
+    0xba, 0x24, 0xee, 0x00, 0xa5, 0xff, 0xe0, 0xfa, 0x82, 0x29, 0x2f, 0x58, 0x7e, 0x02, 0xa5, 0x32,
+    0x51, 0x4c, 0x13, 0x6d, 0xa3, 0x51, 0x54, 0xd5, 0xa4, 0x2e, 0x6b, 0x63, 0x84, 0x1b, 0x8b, 0x8f,
+    0x2f, 0xe1, 0xce, 0x27, 0x94, 0x55, 0x33, 0x65, 0xb6, 0x76, 0xd1, 0x75, 0xb6, 0x73, 0xed, 0xd4,
+    0x57, 0xe9, 0x57, 0x29, 0xc1, 0x14, 0x82, 0x2f, 0x2e, 0x3b, 0x61, 0xb9, 0xd0, 0x32, 0x7c, 0x59,
+    0x8c, 0xf6, 0x45, 0x2d, 0xc9, 0x88, 0x58, 0x7d, 0x3f, 0x0d, 0xab, 0xb9, 0x20, 0xd7, 0x5b, 0xe4,
+    0x7f, 0x5c, 0x5a, 0x96, 0x93, 0xe0, 0xa9, 0xd9, 0x72, 0xc1, 0x53, 0xbd, 0x79, 0x83, 0x6a, 0xdb,
+    0x6d, 0x03, 0x4c, 0xf7, 0x00, 0x69, 0x11, 0xe4, 0xc6, 0xe8, 0x0b, 0xa8, 0x56, 0x67, 0x6c, 0x8f,
+    0xf6, 0xe6, 0xf7, 0x27, 0xa9, 0xce, 0xbf, 0xa7, 0x3a, 0xd6, 0xd6, 0x87, 0x59, 0x17, 0xd2, 0xed,
+    0x05, 0x63, 0xfb, 0x9c, 0x90, 0x17, 0x25, 0x78, 0x7a, 0xe2, 0x3b, 0x01, 0x23, 0x8a, 0x5e, 0xce,
+    0x9f, 0x80, 0x6c, 0x82, 0x40, 0x26, 0x38, 0x90, 0xec, 0xfc, 0x47, 0x7a, 0xfe, 0xa8, 0x9f, 0x40,
+    0xee, 0x61, 0xc2, 0xf7, 0xe7, 0x4f, 0x28, 0x06, 0x52, 0x5f, 0x8f, 0xe7, 0x8f, 0xc9, 0x5f, 0x7f,
+    0x06, 0x4f, 0xd9, 0x76, 0xf2, 0x0f, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment1[] PROGMEM = {
+    0x74, 0x91, 0xb1, 0x4e, 0xc3, 0x30, 0x10, 0x86, 0xf7, 0x3e, 0xc5, 0x6d, 0x07, 0x43, 0x15, 0x91,
+    0x11, 0x25, 0x9e, 0x10, 0x02, 0x21, 0x01, 0x52, 0x40, 0xcc, 0x6e, 0xe2, 0x36, 0x96, 0x1c, 0x3b,
+    0xc4, 0x76, 0x28, 0xbc, 0x02, 0x62, 0x81, 0x91, 0xa1, 0x62, 0x60, 0x60, 0xe8, 0xca, 0xd8, 0x25,
+    0xed, 0xfb, 0xf4, 0x11, 0xb8, 0x04, 0x28, 0x6d, 0x51, 0xc7, 0xbb, 0xfb, 0xff, 0xdf, 0xdf, 0xf9,
+    0x7a, 0x51, 0x1e, 0xb2, 0xe5, 0xe4, 0xe5, 0x13, 0x6e, 0xe4, 0xb1, 0x84, 0x33, 0xa3, 0x87, 0x72,
+    0xe4, 0x2b, 0x9e, 0x8a, 0x28, 0xa0, 0x49, 0x2f, 0x1a, 0x9a, 0xaa, 0x80, 0x42, 0xb8, 0xdc, 0x64,
+    0x31, 0x5e, 0x5e, 0x24, 0x57, 0x08, 0x3c, 0x75, 0xd2, 0xe8, 0x18, 0x03, 0x64, 0x51, 0x26, 0x6b,
+    0x48, 0x15, 0xb7, 0x36, 0xc6, 0x56, 0xd9, 0x1f, 0x55, 0xc6, 0x97, 0x48, 0x3e, 0xc5, 0x07, 0x42,
+    0x01, 0xf5, 0x62, 0x94, 0xba, 0xf4, 0xee, 0x00, 0x59, 0xf7, 0x82, 0x6d, 0xa6, 0x8b, 0x77, 0xd8,
+    0x4b, 0x92, 0xd3, 0xa3, 0xfd, 0xc3, 0x28, 0xe8, 0x64, 0x24, 0xef, 0x34, 0xe0, 0xee, 0x4b, 0x11,
+    0xa3, 0x13, 0x63, 0x87, 0x20, 0xb3, 0x95, 0x13, 0x34, 0x2f, 0xc4, 0x5f, 0x55, 0x2a, 0xc2, 0xcb,
+    0x8d, 0xca, 0x04, 0x85, 0x9f, 0x37, 0x6f, 0x0f, 0xa2, 0x86, 0xdf, 0x6c, 0x37, 0x7f, 0x45, 0xa8,
+    0xc4, 0xad, 0x97, 0x95, 0xc8, 0x58, 0x14, 0x10, 0x1f, 0xa5, 0xef, 0xa0, 0xfc, 0x07, 0x19, 0x22,
+    0x3b, 0x11, 0x56, 0x99, 0x1d, 0x60, 0x25, 0x25, 0xdc, 0x99, 0x2a, 0x5b, 0x83, 0x0b, 0x37, 0xe0,
+    0xc2, 0x2d, 0xb8, 0x8e, 0x2a, 0x6f, 0x13, 0x71, 0xc5, 0xb2, 0x1e, 0x68, 0xfd, 0xa0, 0x90, 0xb4,
+    0x6b, 0xcd, 0x95, 0xa7, 0x72, 0x39, 0x79, 0x9e, 0xc1, 0xb5, 0x32, 0x8b, 0x99, 0x74, 0xc0, 0x69,
+    0x0d, 0xeb, 0x78, 0xe5, 0x4c, 0xcd, 0x5d, 0x6b, 0x6f, 0xc9, 0x37, 0x77, 0x91, 0x7a, 0x68, 0xfa,
+    0x03, 0x33, 0xa6, 0xe9, 0xf7, 0x15, 0x1f, 0x21, 0x31, 0x7e, 0xfe, 0xc4, 0xad, 0x6e, 0x3e, 0x88,
+    0x8b, 0xec, 0xb5, 0xd0, 0xcd, 0xf4, 0xe7, 0x94, 0xdb, 0x4e, 0xe9, 0x44, 0x41, 0x56, 0x5b, 0x72,
+    0xbd, 0xd1, 0xef, 0x56, 0x47, 0xd6, 0x9e, 0x88, 0x3e, 0xa2, 0x1d, 0x33, 0xf8, 0x02, 0x00, 0x00,
+    0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment2[] PROGMEM = {
+    0xb2, 0xd1, 0x4f, 0xc9, 0x2c, 0xb3, 0xe3, 0xb2, 0x01, 0x92, 0x0a, 0xc9, 0x39, 0x89, 0xc5, 0xc5,
+    0xb6, 0xea, 0x99, 0x79, 0x69, 0xf9, 0xba, 0x99, 0x25, 0xa9, 0xb9, 0xea, 0x76, 0x36, 0xc5, 0x05,
+    0x89, 0x79, 0x28, 0xe2, 0x39, 0x89, 0x49, 0xa9, 0x39, 0xea, 0x76, 0x1e, 0xa9, 0xc5, 0x39, 0xf9,
+    0x56, 0x36, 0xfa, 0x20, 0x79, 0x3b, 0x05, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment3[] PROGMEM = {
+    0x00, 0x07, 0x00, 0xf8, 0xff, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a,
+};
+
+static const uint8_t webConfigPageSegment4[] PROGMEM = {
+    0xb2, 0xd1, 0x4f, 0xc9, 0x2c, 0xb3, 0xe3, 0xb2, 0x01, 0x92, 0x0a, 0xc9, 0x39, 0x89, 0xc5, 0xc5,
+    0xb6, 0xea, 0x99, 0x79, 0x69, 0xf9, 0xba, 0x49, 0xf9, 0x15, 0xea, 0x76, 0x36, 0x19, 0x46, 0x76,
+    0x8f, 0x5a, 0x76, 0xbe, 0xdf, 0xd1, 0xaf, 0x10, 0x5c, 0x59, 0x5c, 0x72, 0x78, 0x65, 0xae, 0x8d,
+    0x3e, 0x50, 0x08, 0x53, 0x75, 0x66, 0x49, 0x6a, 0x2e, 0x50, 0x79, 0x71, 0x41, 0x62, 0x1e, 0x8a,
+    0x78, 0x4e, 0x62, 0x52, 0x6a, 0x8e, 0xba, 0x5d, 0x70, 0x49, 0x62, 0x99, 0x95, 0x8d, 0x3e, 0x48,
+    0xda, 0x4e, 0x01, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment5[] PROGMEM = {
+    0x9c, 0x8d, 0x31, 0x0b, 0x83, 0x30, 0x14, 0x84, 0xf7, 0xfe, 0x8a, 0xb7, 0xb9, 0xd4, 0xa6, 0x5d,
+    0x4b, 0x1a, 0x90, 0x12, 0x44, 0x68, 0x69, 0x68, 0xc4, 0x3d, 0xad, 0xaf, 0x10, 0x8c, 0x89, 0xf8,
+    0x52, 0x41, 0x7f, 0x7d, 0x75, 0x11, 0xba, 0xba, 0x1c, 0xdc, 0x1d, 0xf7, 0x1d, 0x67, 0xb5, 0x1d,
+    0xc4, 0x8e, 0xcf, 0x0a, 0x6f, 0x67, 0x88, 0x2e, 0x89, 0xf5, 0x9f, 0x90, 0xda, 0x88, 0x6d, 0x22,
+    0x38, 0x75, 0xc6, 0xff, 0xe5, 0xce, 0xbc, 0xd0, 0x25, 0xa2, 0xc2, 0x7e, 0xc2, 0x33, 0x67, 0x4b,
+    0x2f, 0x40, 0xde, 0x73, 0xd0, 0x23, 0xcd, 0x13, 0x18, 0x4e, 0x87, 0x23, 0xdf, 0xc6, 0x54, 0x7d,
+    0x88, 0xa1, 0x09, 0x6e, 0xc5, 0x96, 0x57, 0xc5, 0x0a, 0x05, 0x04, 0xd9, 0xad, 0xa8, 0x24, 0x34,
+    0x88, 0x9d, 0x71, 0x76, 0xc0, 0x8d, 0xfc, 0xa7, 0xd4, 0x25, 0x64, 0xaa, 0x58, 0xf9, 0xb9, 0x2c,
+    0x81, 0x51, 0x34, 0xf1, 0x4b, 0x7b, 0x50, 0x0f, 0xbd, 0x38, 0xf4, 0x75, 0xfa, 0x0e, 0x6d, 0x6b,
+    0x7c, 0xbd, 0xf1, 0x46, 0xa3, 0x9f, 0x42, 0x3f, 0xae, 0x2f, 0x3f, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment6[] PROGMEM = {
+    0xaa, 0x50, 0x70, 0xf5, 0x75, 0xb7, 0xd1, 0x4f, 0xc9, 0x2c, 0xb3, 0xe3, 0xb2, 0x01, 0x92, 0x0a,
+    0xc9, 0x39, 0x89, 0xc5, 0xc5, 0xb6, 0xea, 0x99, 0x79, 0x69, 0xf9, 0xba, 0x99, 0x25, 0xa9, 0xb9,
+    0xea, 0x76, 0x36, 0xc5, 0x05, 0x89, 0x79, 0x28, 0xe2, 0x39, 0x89, 0x49, 0xa9, 0x39, 0xea, 0x76,
+    0x6e, 0x45, 0xa9, 0xd9, 0x65, 0xa9, 0x79, 0xc9, 0xa9, 0x56, 0x36, 0xfa, 0x20, 0x35, 0x76, 0x0a,
+    0x00, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webConfigPageSegment7[] PROGMEM = {
+    0x00, 0x0a, 0x00, 0xf5, 0xff, 0x20, 0x48, 0x7a, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a,
+};
+
+static const uint8_t webConfigPageSegment8[] PROGMEM = {
+    0x00, 0x07, 0x00, 0xf8, 0xff, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a,
+};
+
+static const uint8_t webConfigPageSegment10[] PROGMEM = {
+    0x00, 0x15, 0x00, 0xea, 0xff, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x3c, 0x2f, 0x62, 0x6f, 0x64,
+    0x79, 0x3e, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x0a,
+};
+
+static const GzipSegment webConfigPageSegments[] PROGMEM = {
+    {webConfigPageSegment0, 939, 2088, 0x32173ac0UL, 0xc76e6911UL},
+    {webConfigPageSegment1, 322, 552, 0x7085cfeeUL, 0x912d3e40UL},
+    {webConfigPageSegment2, 61, 69, 0x531c63feUL, 0x40752973UL},
+    {webConfigPageSegment3, 12, 7, 0xdfa5283eUL, 0xed59b63bUL},
+    {webConfigPageSegment4, 88, 114, 0xed370078UL, 0x5bbc1025UL},
+    {webConfigPageSegment5, 160, 354, 0x7c70dadaUL, 0xd15fe070UL},
+    {webConfigPageSegment6, 70, 78, 0xf6ce88c3UL, 0x9e1f738dUL},
+    {webConfigPageSegment7, 15, 10, 0xb6c4b0a1UL, 0x8816eaf2UL},
+    {webConfigPageSegment8, 12, 7, 0xdfa5283eUL, 0xed59b63bUL},
+    {nullptr, 0, 0, 0x00000000UL, 0x80000000UL},
+    {webConfigPageSegment10, 26, 21, 0x43ec7151UL, 0xae6be681UL},
+};
+
+static const uint8_t webConfigPageFields[] PROGMEM = {
+    PAGE_FIELD_STATUS, PAGE_FIELD_SSID, PAGE_FIELD_PASSWORD, PAGE_FIELD_NETWORK, PAGE_FIELD_MODE, PAGE_FIELD_CHANNELS, PAGE_FIELD_RATE, PAGE_FIELD_LINK, PAGE_FIELD_RTT, PAGE_FIELD_RESTART,
+};
+
+// 3300 B textu, 1728 B gzip bez polí
+const GzipPage webConfigPage PROGMEM = {webConfigPageSegments, webConfigPageFields, 10, 1728};
+
+static const uint8_t webSuccessPageSegment0[] PROGMEM = {
+    0x6c, 0x53, 0xcf, 0x6e, 0x9b, 0x30, 0x18, 0xbf, 0xe7, 0x29, 0x5c, 0xf5, 0xc0, 0xa5, 0x04, 0x48,
+    0x9a, 0x84, 0x10, 0x40, 0x9a, 0xd6, 0x74, 0x9a, 0xa6, 0xaa, 0xd5, 0xda, 0x6a, 0xda, 0xd1, 0xd8,
+    0x1f, 0xc1, 0x1b, 0xd8, 0xcc, 0x36, 0x49, 0x58, 0xc4, 0x71, 0x6f, 0xb1, 0x27, 0xd9, 0x61, 0x97,
+    0x69, 0x2f, 0xb2, 0x27, 0x99, 0x09, 0x64, 0x49, 0xa6, 0x5e, 0x10, 0xf6, 0xe7, 0xdf, 0x3f, 0x7f,
+    0x9f, 0xc3, 0x8b, 0x9b, 0xfb, 0xd7, 0x4f, 0x1f, 0x1f, 0x96, 0x28, 0xd3, 0x45, 0x1e, 0x87, 0xfd,
+    0x17, 0x30, 0x8d, 0x07, 0x61, 0x01, 0x1a, 0x23, 0x92, 0x61, 0xa9, 0x40, 0x47, 0xd6, 0xf3, 0xd3,
+    0xad, 0xed, 0x5b, 0x71, 0xb7, 0xcb, 0x71, 0x01, 0x91, 0xb5, 0x66, 0xb0, 0x29, 0x85, 0xd4, 0x16,
+    0x22, 0x82, 0x6b, 0xe0, 0xe6, 0xd4, 0x86, 0x51, 0x9d, 0x45, 0x14, 0xd6, 0x8c, 0x80, 0xbd, 0x5f,
+    0x5c, 0x31, 0xce, 0x34, 0xc3, 0xb9, 0xad, 0x08, 0xce, 0x21, 0xf2, 0x86, 0xae, 0x65, 0xb8, 0x35,
+    0xd3, 0x39, 0xc4, 0xcb, 0xbb, 0x37, 0xc8, 0x46, 0xcf, 0xb9, 0xf8, 0xfd, 0x13, 0xb8, 0x08, 0x9d,
+    0x6e, 0xb7, 0x93, 0xc8, 0xb4, 0x2e, 0x6d, 0xf8, 0x52, 0xb1, 0x75, 0x64, 0x49, 0x48, 0x25, 0xa8,
+    0xec, 0x44, 0xc7, 0x73, 0x17, 0x95, 0xcc, 0x23, 0xc7, 0x72, 0x0c, 0x99, 0xd2, 0xb5, 0x81, 0x25,
+    0x82, 0xd6, 0xbb, 0xd4, 0x1c, 0xb0, 0x53, 0x5c, 0xb0, 0xbc, 0x0e, 0x5e, 0x49, 0x23, 0x7b, 0xa5,
+    0x30, 0x57, 0xb6, 0x02, 0xc9, 0xd2, 0x45, 0x81, 0xe5, 0x8a, 0xf1, 0x60, 0xe4, 0x96, 0xdb, 0x45,
+    0x82, 0xc9, 0xe7, 0x95, 0x14, 0x15, 0xa7, 0xc1, 0xe5, 0x74, 0x3a, 0x03, 0xc0, 0x0b, 0x22, 0x72,
+    0x21, 0x83, 0xcb, 0xf1, 0x78, 0xdc, 0x0c, 0x86, 0x89, 0xd8, 0xee, 0x0a, 0xbc, 0xed, 0x32, 0x04,
+    0x13, 0xb7, 0xc5, 0xf4, 0xf8, 0x89, 0xf9, 0x47, 0xb8, 0xd2, 0xe2, 0x94, 0x64, 0x93, 0x31, 0x0d,
+    0x8b, 0x44, 0x48, 0x0a, 0xd2, 0x96, 0x98, 0xb2, 0x4a, 0x05, 0x5e, 0x0b, 0x2a, 0x31, 0xa5, 0x8c,
+    0xaf, 0x82, 0x71, 0xbb, 0xd0, 0xb0, 0xd5, 0x36, 0xce, 0xd9, 0x8a, 0x07, 0xc4, 0xe4, 0x00, 0xd9,
+    0x0c, 0x32, 0x6f, 0xd7, 0x0b, 0x8f, 0x66, 0x18, 0xa6, 0x6e, 0xaf, 0x62, 0x27, 0x42, 0x6b, 0x51,
+    0xec, 0xcd, 0x36, 0x43, 0x55, 0x11, 0x02, 0x4a, 0x75, 0xf1, 0x14, 0xfb, 0x0a, 0xc1, 0xb4, 0xa5,
+    0x7b, 0x09, 0xb8, 0x47, 0x20, 0xb7, 0x19, 0x24, 0x95, 0x21, 0xe0, 0xbb, 0xd3, 0xa0, 0xe3, 0xeb,
+    0xb9, 0x4f, 0x93, 0x1e, 0xd6, 0x39, 0x3e, 0xd8, 0xf3, 0x46, 0x06, 0x35, 0x9a, 0xb4, 0x37, 0xb3,
+    0xcf, 0x10, 0x70, 0xc1, 0xff, 0xcf, 0xd3, 0x56, 0x8f, 0x0e, 0xbc, 0xeb, 0xd6, 0x41, 0x25, 0x95,
+    0xe1, 0x2a, 0x05, 0x6b, 0xd3, 0x1c, 0x2c, 0xf8, 0xc6, 0x73, 0xaf, 0x1f, 0x64, 0x62, 0x0d, 0xf2,
+    0xcc, 0xc5, 0x68, 0xee, 0xbb, 0xc9, 0xbc, 0x19, 0x26, 0x9a, 0x9b, 0xc6, 0x90, 0xb3, 0xda, 0x7c,
+    0x82, 0x27, 0x78, 0xfa, 0xaf, 0xf6, 0x02, 0x7a, 0x96, 0xfa, 0xc4, 0xa7, 0xa6, 0x43, 0x8c, 0xa7,
+    0xe2, 0xac, 0x02, 0x7e, 0x7a, 0x9d, 0xfa, 0xc7, 0x44, 0xc7, 0x30, 0x87, 0x00, 0xfe, 0xb1, 0x89,
+    0xdd, 0x2d, 0x9d, 0x36, 0x24, 0x87, 0x54, 0x37, 0x83, 0xd0, 0xe9, 0xa6, 0x29, 0x74, 0xf6, 0xaf,
+    0x20, 0x6c, 0xa7, 0x2a, 0x0e, 0x29, 0x5b, 0x23, 0x92, 0x63, 0xa5, 0x22, 0xcb, 0x0c, 0x46, 0x3b,
+    0xc0, 0x27, 0x3b, 0x7d, 0x73, 0xac, 0xf8, 0xcf, 0xf7, 0x6f, 0xa1, 0x63, 0x0a, 0xe6, 0x05, 0x79,
+    0xf1, 0x3b, 0xc1, 0x53, 0xb6, 0xaa, 0x24, 0x26, 0x80, 0xaa, 0x6e, 0xc2, 0xf1, 0x85, 0x61, 0xf5,
+    0x0c, 0xb8, 0x8c, 0x3f, 0xb0, 0x5b, 0x86, 0x7e, 0xfd, 0xa0, 0xf8, 0x13, 0xa0, 0xa4, 0xce, 0xeb,
+    0xc3, 0x91, 0x1a, 0x51, 0x81, 0x96, 0xcb, 0x87, 0xf7, 0xf7, 0x77, 0xc3, 0xd0, 0x29, 0xcf, 0x85,
+    0xda, 0xc4, 0xe6, 0x05, 0x26, 0xf1, 0xe3, 0xe3, 0xdb, 0x9b, 0x20, 0x74, 0x92, 0x18, 0xfd, 0x05,
+    0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webSuccessPageSegment1[] PROGMEM = {
+    0x2c, 0x8f, 0x31, 0x4e, 0x03, 0x31, 0x10, 0x45, 0xfb, 0x9c, 0x62, 0x94, 0x66, 0x1b, 0xd8, 0x85,
+    0x16, 0x79, 0x2d, 0xa5, 0x89, 0x28, 0xd3, 0x20, 0xa4, 0x74, 0xb6, 0xd7, 0x68, 0x9d, 0x75, 0x3c,
+    0x96, 0x3d, 0x8e, 0x44, 0x0e, 0x40, 0x4d, 0x1b, 0x51, 0x71, 0x80, 0x5c, 0x80, 0x22, 0xcd, 0xb2,
+    0x17, 0xe1, 0x24, 0xcc, 0x06, 0xda, 0xaf, 0x37, 0xef, 0xff, 0x11, 0x3a, 0x49, 0xa1, 0xe5, 0xa3,
+    0xcd, 0x1e, 0x1f, 0x44, 0xa3, 0x25, 0x3c, 0x79, 0x9c, 0x2e, 0x36, 0xa0, 0x68, 0x3a, 0x77, 0x90,
+    0x0b, 0x11, 0xe5, 0x2a, 0x75, 0xc5, 0x05, 0x84, 0x6c, 0x21, 0xe2, 0x50, 0xf2, 0x78, 0x86, 0x38,
+    0x9d, 0x5c, 0xc4, 0x9d, 0x23, 0x18, 0xe0, 0xd9, 0xad, 0x5d, 0x0d, 0x1b, 0x4e, 0x20, 0xd8, 0xf1,
+    0x2b, 0xc7, 0xef, 0x0f, 0xd3, 0x97, 0x99, 0xce, 0xb1, 0x64, 0x62, 0x7a, 0xb5, 0x81, 0x64, 0xa7,
+    0x8b, 0xdb, 0xd7, 0xa2, 0x89, 0x57, 0x25, 0x57, 0x6e, 0xd5, 0x74, 0x1a, 0xcf, 0x47, 0x1b, 0x18,
+    0x60, 0x36, 0xd9, 0x4c, 0x2a, 0x51, 0xd9, 0xd9, 0x1b, 0xc8, 0x94, 0xc6, 0xcf, 0x30, 0xa8, 0x39,
+    0x47, 0x1d, 0xf0, 0xc0, 0xc8, 0x51, 0xc1, 0xfd, 0x1d, 0x07, 0x43, 0x09, 0x5d, 0x3d, 0x0f, 0xfd,
+    0x53, 0xe9, 0x42, 0x84, 0x01, 0x30, 0x18, 0xef, 0xcc, 0xd0, 0x2e, 0x3d, 0x1a, 0x45, 0x0e, 0x43,
+    0xdd, 0x27, 0xfb, 0xd2, 0x56, 0x4d, 0xb5, 0x04, 0xe3, 0x55, 0xce, 0x6d, 0xa5, 0x29, 0xdc, 0x66,
+    0x6b, 0x2a, 0xf9, 0xf3, 0xf6, 0x0e, 0x5b, 0x1e, 0x49, 0x6c, 0xb9, 0x5e, 0xb3, 0xe6, 0xff, 0xd7,
+    0x46, 0x63, 0xf7, 0xca, 0xe6, 0x9e, 0xf6, 0x5e, 0x2e, 0x7e, 0x01, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const GzipSegment webSuccessPageSegments[] PROGMEM = {
+    {webSuccessPageSegment0, 564, 961, 0xc9e66330UL, 0xcd409ff5UL},
+    {webSuccessPageSegment1, 239, 284, 0xf835d321UL, 0xd552260cUL},
+};
+
+static const uint8_t webSuccessPageFields[] PROGMEM = {
+    PAGE_FIELD_SSID,
+};
+
+// 1245 B textu, 826 B gzip bez polí
+const GzipPage webSuccessPage PROGMEM = {webSuccessPageSegments, webSuccessPageFields, 1, 826};
+
+static const uint8_t webRestartPageSegment0[] PROGMEM = {
+    0x6c, 0x53, 0xcd, 0x8e, 0xd3, 0x30, 0x10, 0xbe, 0xf7, 0x29, 0x8c, 0x56, 0x28, 0x20, 0x6d, 0xda,
+    0xa4, 0xdd, 0x2d, 0x25, 0x49, 0x23, 0x10, 0x2c, 0x9c, 0x10, 0x2b, 0xb4, 0x7b, 0xe0, 0xe8, 0xc4,
+    0x93, 0xc4, 0x34, 0xb1, 0xc3, 0xd8, 0xe9, 0x0f, 0x55, 0x25, 0x0e, 0x3c, 0x02, 0x77, 0xb4, 0xdc,
+    0xf6, 0xb0, 0x4f, 0xd1, 0x37, 0xe1, 0x09, 0x78, 0x04, 0x9c, 0x9f, 0x2e, 0x0d, 0xec, 0xc5, 0xb2,
+    0x67, 0x3c, 0xdf, 0x7c, 0xdf, 0xfc, 0x04, 0x8f, 0x5e, 0xbf, 0x7f, 0x75, 0xf5, 0xf1, 0xf2, 0x82,
+    0x64, 0xba, 0xc8, 0xc3, 0xa0, 0x3b, 0x81, 0xb2, 0x70, 0x10, 0x14, 0xa0, 0x29, 0x89, 0x33, 0x8a,
+    0x0a, 0xf4, 0xdc, 0xba, 0xbe, 0x7a, 0x63, 0xcf, 0xac, 0xb0, 0xb5, 0x0a, 0x5a, 0xc0, 0xdc, 0x5a,
+    0x72, 0x58, 0x95, 0x12, 0xb5, 0x45, 0x62, 0x29, 0x34, 0x08, 0xf3, 0x6b, 0xc5, 0x99, 0xce, 0xe6,
+    0x0c, 0x96, 0x3c, 0x06, 0xbb, 0x79, 0x9c, 0x72, 0xc1, 0x35, 0xa7, 0xb9, 0xad, 0x62, 0x9a, 0xc3,
+    0xdc, 0x1d, 0x3a, 0x96, 0xc1, 0xd6, 0x5c, 0xe7, 0x10, 0x5e, 0xbc, 0x7b, 0x4b, 0x6c, 0xf2, 0x01,
+    0x94, 0xa6, 0xa8, 0x83, 0x51, 0x6b, 0x6c, 0x33, 0x64, 0x5a, 0x97, 0x36, 0x7c, 0xae, 0xf8, 0x72,
+    0x6e, 0x21, 0x24, 0x08, 0x2a, 0x3b, 0x4a, 0xe3, 0x3a, 0x7e, 0x85, 0xf9, 0x7c, 0x64, 0x8d, 0x0c,
+    0x96, 0xd2, 0x1b, 0x13, 0x16, 0x49, 0xb6, 0xd9, 0x26, 0xe6, 0x83, 0x9d, 0xd0, 0x82, 0xe7, 0x1b,
+    0xef, 0x25, 0x9a, 0xac, 0xa7, 0x8a, 0x0a, 0x65, 0x2b, 0x40, 0x9e, 0xf8, 0x05, 0xc5, 0x94, 0x0b,
+    0x6f, 0xec, 0x94, 0x6b, 0x3f, 0xa2, 0xf1, 0x22, 0x45, 0x59, 0x09, 0xe6, 0x9d, 0x4c, 0xa7, 0xcf,
+    0x00, 0xa8, 0x1f, 0xcb, 0x5c, 0xa2, 0x77, 0x32, 0x99, 0x4c, 0x7c, 0x0d, 0x6b, 0x6d, 0xd3, 0x9c,
+    0xa7, 0xc2, 0x8b, 0x4d, 0x3e, 0xc0, 0xdd, 0x60, 0x18, 0xc9, 0xf5, 0xb6, 0xa0, 0xeb, 0x56, 0x94,
+    0x77, 0xee, 0xd4, 0x28, 0x1d, 0xe2, 0xb9, 0xb9, 0x13, 0x5a, 0x69, 0x79, 0x0c, 0xbb, 0xca, 0xb8,
+    0x06, 0x3f, 0x92, 0xc8, 0x00, 0x6d, 0xa4, 0x8c, 0x57, 0xca, 0x73, 0xeb, 0xa0, 0x92, 0x32, 0xc6,
+    0x45, 0xea, 0x4d, 0xcc, 0x63, 0x37, 0xc8, 0xdc, 0x6d, 0x97, 0x18, 0x0c, 0x8d, 0xf1, 0xb8, 0xc3,
+    0xb4, 0x23, 0xa9, 0xb5, 0x2c, 0x1a, 0xb2, 0xbb, 0x21, 0xb6, 0x15, 0x6a, 0xe5, 0x29, 0xfe, 0x05,
+    0xbc, 0x69, 0x8d, 0xf4, 0x50, 0x60, 0x13, 0x41, 0x1c, 0x9f, 0x0a, 0x5e, 0x50, 0xcd, 0xa5, 0xf0,
+    0x54, 0xc9, 0x05, 0x19, 0x2b, 0x92, 0x73, 0x01, 0x14, 0x09, 0x17, 0x49, 0xdd, 0x11, 0xd8, 0x0d,
+    0x5e, 0x2c, 0x60, 0x93, 0xa0, 0xe9, 0xa4, 0x22, 0xf5, 0x9f, 0xad, 0xf3, 0x78, 0xab, 0xd1, 0x94,
+    0x2b, 0x91, 0x58, 0x78, 0x28, 0x35, 0xd5, 0xf0, 0xc4, 0x61, 0x90, 0x3e, 0xdd, 0xb9, 0xce, 0x43,
+    0xbe, 0xc9, 0xb4, 0xf5, 0x9a, 0xe2, 0x94, 0x28, 0x53, 0x43, 0x52, 0x6d, 0x8f, 0xeb, 0x0a, 0x71,
+    0xe2, 0x24, 0xee, 0xbf, 0x25, 0x38, 0x37, 0xc4, 0x33, 0xe0, 0x69, 0xa6, 0xdb, 0x4e, 0xf4, 0x69,
+    0xcb, 0x25, 0x60, 0x92, 0xcb, 0x95, 0x97, 0x71, 0xc6, 0x40, 0xd4, 0x75, 0xa7, 0xd8, 0x43, 0x9d,
+    0x9c, 0x3d, 0x9f, 0xb1, 0xe8, 0x00, 0x51, 0x33, 0xf3, 0xdb, 0x96, 0x98, 0xcb, 0x5f, 0xd1, 0x07,
+    0x42, 0x64, 0x76, 0x2f, 0xdc, 0x50, 0x5f, 0x51, 0x64, 0xaa, 0x27, 0xfc, 0x9e, 0xb8, 0x11, 0x78,
+    0x80, 0x69, 0xe5, 0xb6, 0xaf, 0xfa, 0x5a, 0x0b, 0x34, 0x55, 0x93, 0x7d, 0x71, 0xb3, 0xe4, 0x2c,
+    0x99, 0xdd, 0x37, 0xb3, 0x91, 0xd5, 0x57, 0x3a, 0xfb, 0x4f, 0xdc, 0xd1, 0x58, 0xe5, 0x90, 0xe8,
+    0xdd, 0x20, 0x18, 0xb5, 0xb3, 0x1b, 0x8c, 0x9a, 0x95, 0x0b, 0xea, 0x19, 0x0e, 0x03, 0xc6, 0x97,
+    0x24, 0xce, 0xa9, 0x52, 0x73, 0xcb, 0x0c, 0x5d, 0xbd, 0x2d, 0x47, 0x96, 0x6e, 0x14, 0xac, 0xf0,
+    0xf7, 0x8f, 0xef, 0xdf, 0x82, 0x91, 0xf1, 0x98, 0x7d, 0x75, 0xc3, 0x6e, 0x87, 0xe4, 0x72, 0x7f,
+    0x23, 0xf6, 0x77, 0xc3, 0xe1, 0xd0, 0x40, 0xba, 0x26, 0xb2, 0x6c, 0x76, 0x4c, 0x6d, 0x94, 0xde,
+    0xdf, 0x16, 0x44, 0x01, 0xe9, 0xe2, 0xab, 0x4f, 0x60, 0xbe, 0x94, 0xbd, 0x64, 0x87, 0x5a, 0x58,
+    0x7d, 0x0a, 0x14, 0x8d, 0xa1, 0x4d, 0xd4, 0x9c, 0x3d, 0x3a, 0x75, 0x5d, 0x8c, 0x3b, 0x0a, 0x2f,
+    0x51, 0x46, 0xfb, 0xbb, 0x6c, 0x7f, 0xe3, 0x05, 0xa3, 0xc8, 0x18, 0x30, 0x1c, 0xfc, 0xfa, 0xfa,
+    0x93, 0x5c, 0x2f, 0xf2, 0xfd, 0x0d, 0x6b, 0x48, 0x91, 0x85, 0x34, 0xa3, 0x97, 0x56, 0x48, 0x63,
+    0xa8, 0xfd, 0xb5, 0xbb, 0xa3, 0x4d, 0x0a, 0xbe, 0x40, 0x69, 0xfc, 0x1a, 0x65, 0xbe, 0xbf, 0xc5,
+    0xaa, 0x89, 0xff, 0x03, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const uint8_t webRestartPageSegment1[] PROGMEM = {
+    0xb2, 0xd1, 0x4f, 0xc9, 0x2c, 0xb3, 0xb3, 0x29, 0xb0, 0xb3, 0x49, 0xb2, 0x73, 0x2c, 0x2d, 0xc9,
+    0xcf, 0x4d, 0x2c, 0xc9, 0x4c, 0xce, 0x3e, 0xbc, 0x52, 0x21, 0x3f, 0x29, 0x2f, 0xbf, 0x2c, 0x35,
+    0xef, 0xf0, 0x5a, 0x85, 0xaa, 0x44, 0x05, 0x43, 0x03, 0x85, 0xe2, 0xd4, 0xec, 0xd2, 0xbc, 0x14,
+    0x3d, 0x1b, 0xfd, 0x24, 0x3b, 0x1b, 0xfd, 0x02, 0x3b, 0x2e, 0x1b, 0x88, 0x46, 0xfd, 0xa4, 0xfc,
+    0x94, 0x4a, 0x20, 0x95, 0x51, 0x92, 0x9b, 0x63, 0xc7, 0x05, 0x00, 0x00, 0x00, 0xff, 0xff,
+};
+
+static const GzipSegment webRestartPageSegments[] PROGMEM = {
+    {webRestartPageSegment0, 664, 1181, 0x87cd3897UL, 0x8b7c7ed0UL},
+    {webRestartPageSegment1, 79, 78, 0x722de872UL, 0x9e1f738dUL},
+};
+
+static const uint8_t webRestartPageFields[] PROGMEM = {
+    PAGE_FIELD_STEPS,
+};
+
+// 1259 B textu, 766 B gzip bez polí
+const GzipPage webRestartPage PROGMEM = {webRestartPageSegments, webRestartPageFields, 1, 766};
@@ -0,0 +1,32 @@
+// Vygenerováno skriptem web/build_pages.py ze šablon web/*.html - neupravovat ručně
+#ifndef WEB_PAGES_H
+#define WEB_PAGES_H
+
+#include <Arduino.h>
+#include "GzipPage.h"
+
+/**
+ * @brief Dynamická pole stránek ({{NAZEV}} v šabloně)
+ */
+enum WebPageField : uint8_t
+{
+    PAGE_FIELD_CHANNELS,
+    PAGE_FIELD_LINK,
+    PAGE_FIELD_MODE,
+    PAGE_FIELD_NETWORK,
+    PAGE_FIELD_PASSWORD,
+    PAGE_FIELD_RATE,
+    PAGE_FIELD_RESTART,
+    PAGE_FIELD_RTT,
+    PAGE_FIELD_SSID,
+    PAGE_FIELD_STATUS,
+    PAGE_FIELD_STEPS,
+};
+
+const uint8_t webPageMaxFields = 10; // Nejvíc polí na jedné stránce (velikost pole délek)
+
+extern const GzipPage webConfigPage;  // 3300 B textu, 1728 B gzip
+extern const GzipPage webSuccessPage; // 1245 B textu, 826 B gzip
+extern const GzipPage webRestartPage; // 1259 B textu, 766 B gzip
+
+#endif // WEB_PAGES_H
@@ -2,13 +2,53 @@
 #include "Config.h"
 #include "Utils.h"
 #include "EEPROMManager.h"
+#include "CommandTable.h"
+#include "FormParser.h"
+
+/**
+ * @brief Tabulka adres HTTP serveru
+ */
+const WiFiConfigSystem::HttpRoute WiFiConfigSystem::httpRoutes[] = {
+    {HTTP_GET, "/", &WiFiConfigSystem::handlePageRequest},
+    {HTTP_POST, "/", &WiFiConfigSystem::handleConfigFormRequest},
+    {HTTP_GET, "/status", &WiFiConfigSystem::handleStatusRequest},
+    {HTTP_POST, "/send-command", &WiFiConfigSystem::handleSendCommandRequest},
+    {HTTP_POST, "/restart", &WiFiConfigSystem::handleRestartRequest},
+};
+
+/**
+ * @brief Vrací text stavového kódu HTTP
+ * @param code Stavový kód
+ */
+static const __FlashStringHelper *httpStatusText(uint16_t code)
+{
+    switch (code)
+    {
+    case 200:
+        return F("OK");
+    case 400:
+        return F("Bad Request");
+    case 404:
+        return F("Not Found");
+    case 405:
+        return F("Method Not Allowed");
+    case 409:
+        return F("Conflict");
+    case 413:
+        return F("Payload Too Large");
+    case 414:
+        return F("URI Too Long");
+    default:
+        return F("Service Unavailable");
+    }
+}
 
 /**
  * @brief Konstruktor WiFiConfigSystem
  * @param emgSys Reference na EMG systém
  * @param lcd Pointer na LCD displej (volitelný)
  */
-WiFiConfigSystem::WiFiConfigSystem(EMGSystem &emgSys, LCDDisplay *lcd) : server(httpPort), isAPMode(false), initialized(false), emgSystem(emgSys), lcdDisplay(lcd)
+WiFiConfigSystem::WiFiConfigSystem(EMGSystem &emgSys, LCDDisplay *lcd) : server(httpPort), isAPMode(false), wifiState(WIFI_STATE_CONNECTING), initialized(false), emgSystem(emgSys), lcdDisplay(lcd)
 {
     // Initialize char arrays
     wifiSSID[0] = '\0';
@@ -16,10 +56,10 @@ WiFiConfigSystem::WiFiConfigSystem(EMGSystem &emgSys, LCDDisplay *lcd) : server(
 }
 
 /**
- * @brief Pokusí se připojit k WiFi síti
- * @return True pokud se připojení podařilo
+ * @brief Zahájí připojení k uložené WiFi síti (neblokující)
+ * @return False pokud nejsou uložené přihlašovací údaje
  */
-bool WiFiConfigSystem::connectToWiFi()
+bool WiFiConfigSystem::startConnecting()
 {
     if (strlen(wifiSSID) == 0 || strlen(wifiPass) == 0)
         return false;
@@ -43,83 +83,304 @@ bool WiFiConfigSystem::connectToWiFi()
 
     // Disconnect any previous connection
     WiFi.disconnect();
-    delay(100);
 
-    // Začni připojení
+    // Začni připojení, na výsledek se čeká v update()
     WiFi.begin(wifiSSID, wifiPass);
+    wifiState = WIFI_STATE_CONNECTING;
+    stateStartMs = lastProgressMs = millis();
+    noSsid = false;
+    return true;
+}
+
+/**
+ * @brief Zahájí spuštění Access Pointu (neblokující)
+ */
+void WiFiConfigSystem::startAccessPoint()
+{
+    printIfPinLow(F("Spouštím Access Point..."), debugPin);
 
-    // Čekej na připojení (max wifiTimeoutMs)
-    unsigned long startTime = millis();
-    while (WiFi.status() != WL_CONNECTED && (millis() - startTime) < wifiTimeoutMs)
+    // Update LCD
+    if (lcdDisplay && lcdDisplay->isReady())
     {
-        delay(500);
-        Serial.print(".");
-        Serial.print(WiFi.status());
+        lcdDisplay->clear();
+        lcdDisplay->printAt(0, 0, F("Access Point"));
+        lcdDisplay->printAt(0, 1, F("Spousteni..."));
     }
 
-    if (WiFi.status() == WL_CONNECTED)
+    // V AP režimu se EMG nepoužívá, vzorkování ani kalibrace nemají běžet
+    isAPMode = true;
+    emgSystem.end();
+
+    WiFi.beginAP(apSSID, apPass);
+    wifiState = WIFI_STATE_AP_STARTING;
+    stateStartMs = millis();
+}
+
+/**
+ * @brief Posune stav připojování a hlídá spojení v režimu STA (dotaz na modul jen po intervalech)
+ */
+void WiFiConfigSystem::advanceConnection()
+{
+    if (wifiState == WIFI_STATE_AP)
+        return;
+
+    // Každý dotaz na stav je přenos po SPI, vzorkování mezi nimi běží dál
+    unsigned long now = millis();
+    uint16_t interval = wifiState == WIFI_STATE_STA ? wifiLinkCheckMs : wifiPollIntervalMs;
+    if (now - lastWiFiPollMs < interval)
+        return;
+    lastWiFiPollMs = now;
+
+    uint8_t status = WiFi.status();
+    switch (wifiState)
     {
-        printIfPinLow(F("WiFi připojeno!"), debugPin);
-        IPAddress ip = WiFi.localIP();
-        char ipStr[17];
-        snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-        printIfPinLow(F("IP získána:"), debugPin);
-        printIfPinLow(ipStr, debugPin);
-        Serial.println(ipStr);
+    case WIFI_STATE_CONNECTING:
+        pollConnecting(status, now);
+        break;
+    case WIFI_STATE_AP_STARTING:
+        pollAccessPoint(status, now);
+        break;
+    case WIFI_STATE_STA:
+        if (status != WL_CONNECTED)
+            startReconnecting(status, now);
+        break;
+    case WIFI_STATE_RECONNECTING:
+        pollReconnecting(status, now);
+        break;
+    default:
+        break;
+    }
+}
 
-        printIfPinLow(F("Signál dobrý"), debugPin);
+/**
+ * @brief Vyhodnotí, zda probíhající pokus o připojení nemá naději
+ * @param status Stav z WiFi.status()
+ * @param now Aktuální čas (millis)
+ * @return True po odmítnutí přihlášení nebo po wifiNoSsidGraceMs bez nalezené sítě
+ */
+bool WiFiConfigSystem::isHopeless(uint8_t status, unsigned long now)
+{
+    // Špatné heslo modul hlásí hned, nenalezenou síť i mezi skenováními, ta proto musí chvíli vydržet
+    if (status != WL_NO_SSID_AVAIL)
+        noSsid = false;
+    else if (!noSsid)
+    {
+        noSsid = true;
+        noSsidSinceMs = now;
+    }
 
-        // Update LCD with success
-        if (lcdDisplay && lcdDisplay->isReady())
-        {
-            lcdDisplay->clear();
-            lcdDisplay->printAt(0, 0, F("WiFi pripojeno!"));
-            char ipStr[17];
-            snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
-            lcdDisplay->printAt(0, 1, ipStr);
-            delay(2000);
-        }
+    return status == WL_CONNECT_FAILED || (noSsid && now - noSsidSinceMs >= wifiNoSsidGraceMs);
+}
 
-        return true;
+/**
+ * @brief Vyhodnotí stav modulu při připojování k uložené síti
+ * @param status Stav z WiFi.status()
+ * @param now Aktuální čas (millis)
+ */
+void WiFiConfigSystem::pollConnecting(uint8_t status, unsigned long now)
+{
+    if (status == WL_CONNECTED)
+    {
+        onConnected();
+        return;
+    }
+
+    if (isHopeless(status, now) || now - stateStartMs >= wifiTimeoutMs)
+    {
+        char msg[48];
+        snprintf(msg, sizeof(msg), "WiFi připojení selhalo (stav %d)", status);
+        printIfPinLow(msg, debugPin);
+        bootStats.fallbackStatus = status;
+        startAccessPoint();
+        return;
     }
 
-    printIfPinLow(F("WiFi připojení selhalo"), debugPin);
-    return false;
+    if (now - lastProgressMs < wifiProgressIntervalMs)
+        return;
+    lastProgressMs = now;
+    Serial.print(".");
+    Serial.print(status);
+
+    if (lcdDisplay && lcdDisplay->isReady())
+    {
+        // Displej má 16 znaků, počet sekund se omezí na dvě číslice
+        uint32_t elapsedS = (now - stateStartMs) / 1000;
+        uint8_t shownS = elapsedS > 99 ? 99 : (uint8_t)elapsedS;
+        char progressStr[17];
+        snprintf(progressStr, sizeof(progressStr), "Pripojovani %2us", shownS);
+        lcdDisplay->printAt(0, 0, progressStr);
+    }
 }
 
 /**
- * @brief Spustí Access Point režim
- * @return True pokud se AP spustil úspěšně
+ * @brief Vyhodnotí stav modulu při spouštění Access Pointu
+ * @param status Stav z WiFi.status()
+ * @param now Aktuální čas (millis)
  */
-bool WiFiConfigSystem::startAccessPoint()
+void WiFiConfigSystem::pollAccessPoint(uint8_t status, unsigned long now)
 {
-    printIfPinLow(F("Spouštím Access Point..."), debugPin);
+    if (status == WL_AP_LISTENING)
+    {
+        onAccessPointReady();
+        return;
+    }
 
-    // Update LCD
+    if (status != WL_AP_FAILED && now - stateStartMs < apStartTimeoutMs)
+        return;
+
+    printIfPinLow(F("Chyba při spouštění AP"), debugPin);
+
+    // Update LCD with error
     if (lcdDisplay && lcdDisplay->isReady())
     {
         lcdDisplay->clear();
-        lcdDisplay->printAt(0, 0, F("Access Point"));
-        lcdDisplay->printAt(0, 1, F("Spousteni..."));
+        lcdDisplay->printAt(0, 0, F("Chyba AP!"));
+    }
+
+    while (true)
+        ; // Zastavení při chybě AP
+}
+
+/**
+ * @brief Spustí TCP server EMG a HTTP server po připojení k síti
+ */
+void WiFiConfigSystem::onConnected()
+{
+    printIfPinLow(F("WiFi připojeno!"), debugPin);
+    IPAddress ip = WiFi.localIP();
+    char ipStr[17];
+    snprintf(ipStr, sizeof(ipStr), "%d.%d.%d.%d", ip[0], ip[1], ip[2], ip[3]);
+    printIfPinLow(F("IP získána:"), debugPin);
+    printIfPinLow(ipStr, debugPin);
+    Serial.println(ipStr);
+
+    // IP adresu na LCD zobrazí EMG systém spolu s výzvou pro klienta
+    isAPMode = false;
+    wifiState = WIFI_STATE_STA;
+    bootStats.fallbackStatus = WL_CONNECTED;
+    printIfPinLow(F("WiFi připojeno - spouštím EMG systém"), debugPin);
+    emgSystem.beginServer();
+
+    // REST API a stránka se stavem běží vedle TCP serveru EMG
+    server.begin();
+    printIfPinLow(F("Web server spuštěn v režimu STA"), debugPin);
+    markServing();
+}
+
+/**
+ * @brief Zastaví servery po výpadku spojení a zahájí jeho obnovu
+ * @param status Stav z WiFi.status(), kterým výpadek začal
+ * @param now Aktuální čas (millis)
+ */
+void WiFiConfigSystem::startReconnecting(uint8_t status, unsigned long now)
+{
+    char msg[48];
+    snprintf(msg, sizeof(msg), "Výpadek WiFi (stav %d), obnovuji spojení", status);
+    printIfPinLow(msg, debugPin);
+
+    linkStats.outages++;
+    linkStats.downSinceMs = now;
+    linkStats.lastStatus = status;
+
+    // Sockety výpadek nepřežijí, vzorkování a kalibrace běží dál
+    emgSystem.endServer();
+    for (uint8_t i = 0; i < httpMaxConnections; i++)
+    {
+        if (httpSlots[i].client)
+            closeHttp(httpSlots[i]);
+    }
+
+    if (lcdDisplay && lcdDisplay->isReady())
+    {
+        lcdDisplay->clear();
+        lcdDisplay->printAt(0, 0, F("Vypadek WiFi"));
+        lcdDisplay->printAt(0, 1, F("Obnovuji..."));
+    }
+
+    // První pokus hned, další s odkladem od wifiRetryMinMs do wifiRetryMaxMs
+    wifiState = WIFI_STATE_RECONNECTING;
+    attemptActive = false;
+    retryWaitMs = 0;
+    stateStartMs = now;
+}
+
+/**
+ * @brief Obnovuje spojení po výpadku s rostoucím odkladem mezi pokusy
+ * @param status Stav z WiFi.status()
+ * @param now Aktuální čas (millis)
+ */
+void WiFiConfigSystem::pollReconnecting(uint8_t status, unsigned long now)
+{
+    if (status == WL_CONNECTED)
+    {
+        onReconnected(now);
+        return;
     }
 
-    if (WiFi.beginAP(apSSID, apPass) != WL_AP_LISTENING)
+    if (!attemptActive)
     {
-        printIfPinLow(F("Chyba při spouštění AP"), debugPin);
+        if (now - stateStartMs < retryWaitMs)
+            return;
+
+        WiFi.disconnect();
+        WiFi.begin(wifiSSID, wifiPass);
+        attemptActive = true;
+        noSsid = false;
+        stateStartMs = now;
+        linkStats.attempts++;
 
-        // Update LCD with error
         if (lcdDisplay && lcdDisplay->isReady())
         {
-            lcdDisplay->clear();
-            lcdDisplay->printAt(0, 0, F("Chyba AP!"));
-            delay(2000);
+            char attemptStr[17];
+            snprintf(attemptStr, sizeof(attemptStr), "Pokus %-10u", linkStats.attempts);
+            lcdDisplay->printAt(0, 1, attemptStr);
         }
-
-        return false;
+        return;
     }
 
-    delay(apStabilizationMs); // nutné pro stabilizaci
+    if (!isHopeless(status, now) && now - stateStartMs < wifiTimeoutMs)
+        return;
 
+    // Odklad se zdvojuje, aby opakované pokusy nezahlcovaly modul ani síť
+    retryWaitMs = retryWaitMs == 0 ? wifiRetryMinMs : (retryWaitMs > wifiRetryMaxMs / 2 ? wifiRetryMaxMs : retryWaitMs * 2);
+    WiFi.disconnect();
+    attemptActive = false;
+    stateStartMs = now;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "Obnovení WiFi selhalo (stav %d), další pokus za %u ms", status, retryWaitMs);
+    printIfPinLow(msg, debugPin);
+}
+
+/**
+ * @brief Zaznamená výpadek a znovu spustí TCP server EMG a HTTP server
+ * @param now Aktuální čas (millis)
+ */
+void WiFiConfigSystem::onReconnected(unsigned long now)
+{
+    uint32_t outage = now - linkStats.downSinceMs;
+    linkStats.lastOutageMs = outage;
+    linkStats.totalOutageMs += outage;
+    if (outage > linkStats.maxOutageMs)
+        linkStats.maxOutageMs = outage;
+    linkStats.lastReconnectMs = attemptActive ? now - stateStartMs : 0;
+
+    char msg[64];
+    snprintf(msg, sizeof(msg), "WiFi obnoveno po %lu ms (připojení %lu ms)",
+             (unsigned long)outage, (unsigned long)linkStats.lastReconnectMs);
+    printIfPinLow(msg, debugPin);
+
+    wifiState = WIFI_STATE_STA;
+    attemptActive = false;
+    emgSystem.beginServer();
+    server.begin();
+}
+
+/**
+ * @brief Spustí HTTP server s konfigurační stránkou po spuštění AP
+ */
+void WiFiConfigSystem::onAccessPointReady()
+{
     IPAddress ip = WiFi.localIP();
     printIfPinLow(F("AP IP získána"), debugPin);
 
@@ -134,257 +395,254 @@ bool WiFiConfigSystem::startAccessPoint()
     }
 
     // Spusť web server pouze v AP režimu
+    wifiState = WIFI_STATE_AP;
     server.begin();
     printIfPinLow(F("Web server spuštěn v AP režimu"), debugPin);
-    return true;
+    markServing();
+}
+
+/**
+ * @brief Zaznamená a vypíše dobu od zapnutí do spuštění HTTP serveru
+ */
+void WiFiConfigSystem::markServing()
+{
+    bootStats.servingMs = millis();
+
+    char msg[72];
+    snprintf(msg, sizeof(msg), "Server připraven za %lu ms od zapnutí (síť %lu ms)",
+             (unsigned long)bootStats.servingMs, (unsigned long)(bootStats.servingMs - bootStats.networkStartMs));
+    printIfPinLow(msg, debugPin);
 }
 
 /**
  * @brief Zpracuje HTTP požadavek s WiFi údaji
- * @param reqLine Řádek HTTP požadavku
- * @param client WiFi klient pro odpověď
+ * @param form Tělo formuláře s input1 (SSID) a input2 (heslo), rozloží se na místě
+ * @param client Výstup pro odpověď (TxBuffer)
  * @return True pokud byl požadavek zpracován
  */
-bool WiFiConfigSystem::handleWiFiConfig(const char *reqLine, WiFiClient &client)
+bool WiFiConfigSystem::handleWiFiConfig(char *form, Print &client)
 {
-    // Find positions of parameters in the request line
-    const char *ssidStart = strstr(reqLine, "input1=");
-    const char *passStart = strstr(reqLine, "&input2=");
-    const char *passEnd = strchr(passStart ? passStart : reqLine, ' ');
+    FormParser params;
+    params.parse(form);
+    const char *ssid = params.get("input1");
+    const char *pass = params.get("input2");
 
-    if (ssidStart && passStart && passEnd && ssidStart < passStart)
-    {
-        // Extract SSID
-        ssidStart += 7; // Skip "input1="
-        int ssidLen = passStart - ssidStart;
-        if (ssidLen >= sizeof(wifiSSID))
-            ssidLen = sizeof(wifiSSID) - 1;
+    // Příliš dlouhý údaj by se uložil oříznutý, takový formulář se odmítne
+    if (!ssid || !pass || !*ssid || strlen(ssid) >= sizeof(wifiSSID) || strlen(pass) >= sizeof(wifiPass))
+        return false;
 
-        char tempSSID[32];
-        strncpy(tempSSID, ssidStart, ssidLen);
-        tempSSID[ssidLen] = '\0';
+    strcpy(wifiSSID, ssid);
+    strcpy(wifiPass, pass);
 
-        // Extract password
-        passStart += 8; // Skip "&input2="
-        int passLen = passEnd - passStart;
-        if (passLen >= sizeof(wifiPass))
-            passLen = sizeof(wifiPass) - 1;
+    printIfPinLow(F("Decoded values:"), debugPin);
+    printIfPinLow(wifiSSID, debugPin);
 
-        char tempPass[32];
-        strncpy(tempPass, passStart, passLen);
-        tempPass[passLen] = '\0';
+    printIfPinLow(F("Pass decoded"), debugPin);
 
-        // URL decode
-        urlDecode(tempSSID, wifiSSID, sizeof(wifiSSID));
-        urlDecode(tempPass, wifiPass, sizeof(wifiPass));
+    EEPROMManager::writeString(EEPROM_ADDR_WIFISSID, wifiSSID);
+    EEPROMManager::writeString(EEPROM_ADDR_WIFIPASS, wifiPass);
 
-        printIfPinLow(F("Decoded values:"), debugPin);
-        printIfPinLow(wifiSSID, debugPin);
+    printIfPinLow(F("Uloženo do EEPROM:"), debugPin);
+    printIfPinLow(wifiSSID, debugPin);
 
-        printIfPinLow(F("Pass decoded"), debugPin);
+    sendPage(client, webSuccessPage);
+    return true;
+}
 
-        EEPROMManager::writeString(EEPROM_ADDR_WIFISSID, wifiSSID);
-        EEPROMManager::writeString(EEPROM_ADDR_WIFIPASS, wifiPass);
+/**
+ * @brief Odešle předkomprimovanou stránku s doplněnými poli (gzip)
+ * @param client Výstup pro odpověď (TxBuffer)
+ * @param page Stránka z WebPages.h (PROGMEM)
+ */
+void WiFiConfigSystem::sendPage(Print &client, const GzipPage &page)
+{
+    GzipPage info;
+    memcpy_P(&info, &page, sizeof(info));
 
-        printIfPinLow(F("Uloženo do EEPROM:"), debugPin);
-        printIfPinLow(wifiSSID, debugPin);
+    // Content-Length musí předcházet tělu, délky polí se proto zjistí nanečisto
+    uint16_t fieldLengths[webPageMaxFields];
+    uint32_t contentLength = info.staticBytes;
+    for (uint8_t i = 0; i < info.fieldCount; i++)
+    {
+        ByteCounter counter;
+        renderPageField(pgm_read_byte(info.fields + i), counter);
+        fieldLengths[i] = counter.getCount();
+        if (fieldLengths[i] > 0)
+            contentLength += fieldLengths[i] + GzipPageWriter::fieldOverhead;
+    }
+    sendHttpHeader(client, 200, F("text/html; charset=UTF-8"), contentLength, true);
 
-        sendSuccessPage(client);
-        return true;
+    GzipPageWriter writer(client);
+    writer.begin();
+    for (uint8_t i = 0; i <= info.fieldCount; i++)
+    {
+        GzipSegment segment;
+        memcpy_P(&segment, info.segments + i, sizeof(segment));
+        writer.writeSegment(segment);
+        if (i == info.fieldCount)
+            break;
+
+        writer.beginField(fieldLengths[i]);
+        if (fieldLengths[i] > 0)
+            renderPageField(pgm_read_byte(info.fields + i), writer);
     }
-    return false;
+    writer.end();
 }
 
 /**
- * @brief Odešle HTML stránku s potvrzením úspěšného uložení
- * @param client WiFi klient pro odpověď
+ * @brief Vypíše hodnotu dynamického pole stránky
+ * @param field Pole (WebPageField)
+ * @param out Výstup hodnoty
  */
-void WiFiConfigSystem::sendSuccessPage(WiFiClient &client)
-{
-    client.println(F("HTTP/1.1 200 OK"));
-    client.println(F("Content-Type: text/html; charset=UTF-8"));
-    client.println(F("Connection: close"));
-    client.println();
-    client.println(F("<!DOCTYPE html><html><head>"));
-    client.println(F("<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1.0'>"));
-    client.println(F("<title>EMG - Uloženo</title>"));
-    client.println(F("<style>body{font-family:Arial,sans-serif;margin:20px;background:#667eea;color:#333}"));
-    client.println(F(".box{max-width:500px;margin:50px auto;background:white;border-radius:10px;padding:30px;text-align:center}"));
-    client.println(F("h1{color:#27ae60;margin-bottom:20px}.success{font-size:60px;color:#27ae60;margin:20px 0}"));
-    client.println(F("button{background:#3498db;color:white;padding:12px 25px;border:none;border-radius:5px;font-size:14px;cursor:pointer;margin:8px}"));
-    client.println(F("button:hover{background:#2980b9}.btn-sec{background:#95a5a6}.btn-sec:hover{background:#7f8c8d}"));
-    client.println(F(".info{background:#e8f4f8;padding:15px;border-radius:8px;margin:20px 0;text-align:left}"));
-    client.println(F("</style></head><body><div class='box'>"));
-    client.println(F("<div class='success'>✅</div><h1>Konfigurace uložena!</h1>"));
-    client.println(F("<p>WiFi údaje byly uloženy do EEPROM.</p>"));
+void WiFiConfigSystem::renderPageField(uint8_t field, Print &out)
+{
+    switch (field)
+    {
+    case PAGE_FIELD_STATUS:
+        if (isAPMode)
+            out.print(F("<div class='status ap'>⚠️ Access Point - nepodařilo se připojit k WiFi</div>"));
+        else
+            out.print(F("<div class='status connected'>✅ Připojeno k WiFi síti</div>"));
+        break;
+
+    case PAGE_FIELD_SSID:
+        out.print(strlen(wifiSSID) > 0 ? wifiSSID : "Nenastaveno");
+        break;
+
+    case PAGE_FIELD_PASSWORD:
+        out.print(strlen(wifiPass) > 0 ? "••••••••" : "Nenastaveno");
+        break;
+
+    case PAGE_FIELD_NETWORK:
+        if (isAPMode)
+            break;
+        out.print(F("<div class='info-item'><span class='info-label'>IP adresa:</span> "));
+        out.print(WiFi.localIP());
+        out.print(F("</div>\n<div class='info-item'><span class='info-label'>EMG TCP port:</span> "));
+        out.print(tcpPort);
+        out.print(F("</div>\n"));
+        break;
+
+    case PAGE_FIELD_MODE:
+        out.print(isAPMode ? F("Konfigurační režim") : F("EMG režim - TCP server aktivní"));
+        break;
+
+    case PAGE_FIELD_CHANNELS:
+        out.print(emgSystem.getChannelCount());
+        break;
+
+    case PAGE_FIELD_RATE:
+        out.print(refreshRateHz);
+        break;
+
+    case PAGE_FIELD_LINK:
+        if (isAPMode)
+        {
+            out.print(F("<div class='info-item'><span class='info-label'>Access Point:</span> "));
+            out.print(apSSID);
+            out.print(F("</div>\n<div class='info-item'><span class='info-label'>AP heslo:</span> "));
+            out.print(apPass);
+            out.print(F("</div>\n<div class='info-item'><span class='info-label'>AP IP:</span> "));
+            out.print(WiFi.localIP());
+            out.print(F("</div>\n"));
+        }
+        else
+        {
+            out.print(F("<div class='info-item'><span class='info-label'>ALIVE interval:</span> "));
+            out.print(aliveIntervalMs / 1000);
+            out.print(F(" s</div>\n<div class='info-item'><span class='info-label'>WiFi signál:</span> "));
+            out.print(WiFi.RSSI());
+            out.print(F(" dBm</div>\n"));
+        }
+        break;
 
-    client.println(F("<div class='info'><b>SSID:</b> "));
-    client.print(wifiSSID);
-    client.println(F("<br><b>Heslo:</b> Uloženo</div>"));
+    case PAGE_FIELD_RTT:
+        if (!isAPMode)
+            sendRttSection(out);
+        break;
 
-    client.println(F("<p>Arduino se pokusí připojit k WiFi. Při neúspěchu se spustí AP režim.</p>"));
-    client.println(F("<p><b>Restart za 5 sekund...</b></p>"));
-
-    client.println(F("<button onclick=\"location.href='/restart'\">🔄 Restart</button>"));
-    client.println(F("<button onclick=\"location.href='/'\" class='btn-sec'>← Zpět</button>"));
-
-    client.println(F("</div><script>setTimeout(function(){location.href='/restart';},5000);</script>"));
-    client.println(F("</body></html>"));
-}
-
-/**
- * @brief Odešle HTML stránku pro restart
- * @param client WiFi klient pro odpověď
- */
-void WiFiConfigSystem::sendRestartPage(WiFiClient &client)
-{
-    client.println(F("HTTP/1.1 200 OK"));
-    client.println(F("Content-Type: text/html; charset=UTF-8"));
-    client.println(F("Connection: close"));
-    client.println();
-    client.println(F("<!DOCTYPE html><html><head>"));
-    client.println(F("<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1.0'>"));
-    client.println(F("<title>EMG - Restart</title><meta http-equiv='refresh' content='10;url=/'/>"));
-    client.println(F("<style>body{font-family:Arial,sans-serif;margin:20px;background:#667eea;color:#333;text-align:center}"));
-    client.println(F(".box{max-width:500px;margin:50px auto;background:white;border-radius:10px;padding:30px}"));
-    client.println(F("h1{color:#e67e22;margin-bottom:20px}.restart{font-size:60px;color:#e67e22;margin:20px 0;animation:spin 2s linear infinite}"));
-    client.println(F("@keyframes spin{0%{transform:rotate(0deg)}100%{transform:rotate(360deg)}}"));
-    client.println(F(".progress{background:#ecf0f1;border-radius:15px;height:20px;margin:20px 0;overflow:hidden}"));
-    client.println(F(".bar{background:#3498db;height:100%;width:0%;animation:progress 8s linear forwards}"));
-    client.println(F("@keyframes progress{0%{width:0%}100%{width:100%}}"));
-    client.println(F(".info{background:#e8f4f8;padding:15px;border-radius:8px;margin:20px 0;text-align:left}"));
-    client.println(F("</style></head><body><div class='box'>"));
-    client.println(F("<div class='restart'>🔄</div><h1>Restartování...</h1>"));
-    client.println(F("<p>EMG systém se restartuje.</p><div class='progress'><div class='bar'></div></div>"));
-
-    client.println(F("<div class='info'><b>Probíhá:</b><br>"));
-    client.println(F("• Ukládání konfigurace<br>• Restart mikrokontroléru<br>"));
-    if (strlen(wifiSSID) > 0)
-    {
-        client.println(F("• Připojení k WiFi: <b>"));
-        client.print(wifiSSID);
-        client.println(F("</b><br>• Spuštění EMG serveru na portu "));
-        client.print(tcpPort);
-        client.println(F("<br>"));
-    }
-    else
-    {
-        client.println(F("• Spuštění Access Point<br>"));
-    }
-    client.println(F("</div><p><b>Automatické obnovení za 10 sekund.</b></p>"));
-    client.println(F("</div></body></html>"));
-}
-
-/**
- * @brief Odešle hlavní konfigurační HTML stránku
- * @param client WiFi klient pro odpověď
- */
-void WiFiConfigSystem::sendConfigPage(WiFiClient &client)
-{
-    client.println(F("HTTP/1.1 200 OK"));
-    client.println(F("Content-Type: text/html; charset=UTF-8"));
-    client.println(F("Connection: close"));
-    client.println();
-    client.println(F("<!DOCTYPE html><html><head>"));
-    client.println(F("<meta charset='UTF-8'><meta name='viewport' content='width=device-width,initial-scale=1.0'>"));
-    client.println(F("<title>Arduino EMG - WiFi Config</title>"));
-    client.println(F("<style>body{font-family:Arial,sans-serif;margin:20px;background:#667eea;color:#333}"));
-    client.println(F(".container{max-width:600px;margin:0 auto;background:white;border-radius:10px;padding:25px}"));
-    client.println(F("h1{color:#2c3e50;text-align:center;margin-bottom:10px;font-size:2em}h1::before{content:'🔌';margin-right:10px}"));
-    client.println(F(".subtitle{text-align:center;color:#7f8c8d;margin-bottom:25px;font-style:italic;border-bottom:2px solid #ecf0f1;padding-bottom:15px}"));
-    client.println(F("h2{color:#34495e;margin:25px 0 15px;font-size:1.3em;border-left:4px solid #3498db;padding-left:15px}"));
-    client.println(F(".status{padding:12px;border-radius:8px;margin-bottom:20px;font-weight:bold;text-align:center}"));
-    client.println(F(".status.ap{background:#ffeaa7;border:2px solid #e17055;color:#2d3436}"));
-    client.println(F(".status.connected{background:#00b894;border:2px solid #00a085;color:white}"));
-    client.println(F(".form-group{margin-bottom:20px}label{display:block;margin-bottom:5px;font-weight:600;color:#2c3e50}"));
-    client.println(F("input[type='text'],input[type='password']{width:100%;padding:12px;border:2px solid #ddd;border-radius:5px;font-size:14px;box-sizing:border-box}"));
-    client.println(F("input:focus{outline:none;border-color:#3498db}"));
-    client.println(F("button,input[type='submit']{background:#3498db;color:white;padding:12px 25px;border:none;border-radius:5px;font-size:14px;cursor:pointer;margin-right:8px;font-weight:600}"));
-    client.println(F("button:hover,input[type='submit']:hover{background:#2980b9}.btn-sec{background:#95a5a6}.btn-sec:hover{background:#7f8c8d}"));
-    client.println(F(".info-box{background:#f8f9fa;padding:20px;border-radius:8px;margin:20px 0;border:1px solid #dee2e6}"));
-    client.println(F(".info-item{margin-bottom:10px;padding:5px 0;border-bottom:1px solid #ecf0f1}.info-item:last-child{border-bottom:none}"));
-    client.println(F(".info-label{font-weight:bold;color:#2c3e50;display:inline-block;min-width:130px}"));
-    client.println(F("@media (max-width:768px){.container{margin:10px;padding:15px}.info-label{min-width:auto;display:block;margin-bottom:5px}}"));
-    client.println(F("</style></head><body><div class='container'>"));
-    client.println(F("<h1>Arduino EMG Systém</h1>"));
-    client.println(F("<p class='subtitle'>Elektromyografický systém pro snímání svalových signálů</p>"));
-
-    if (isAPMode)
-    {
-        client.println(F("<div class='status ap'>⚠️ Access Point - nepodařilo se připojit k WiFi</div>"));
-    }
-    else
-    {
-        client.println(F("<div class='status connected'>✅ Připojeno k WiFi síti</div>"));
-    }
-
-    client.println(F("<h2>📶 WiFi Konfigurace</h2>"));
-    client.println(F("<form method='GET'><div class='form-group'>"));
-    client.println(F("<label for='input1'>WiFi síť (SSID):</label>"));
-    client.println(F("<input type='text' id='input1' name='input1' placeholder='Název WiFi sítě' required></div>"));
-    client.println(F("<div class='form-group'><label for='input2'>Heslo:</label>"));
-    client.println(F("<input type='password' id='input2' name='input2' placeholder='WiFi heslo'></div>"));
-    client.println(F("<input type='submit' value='💾 Uložit a restartovat'></form>"));
-
-    client.println(F("<div class='info-box'><h2>📋 Současné nastavení</h2>"));
-    client.println(F("<div class='info-item'><span class='info-label'>SSID:</span> "));
-    client.print(strlen(wifiSSID) > 0 ? wifiSSID : "Nenastaveno");
-    client.println(F("</div><div class='info-item'><span class='info-label'>Heslo:</span> "));
-    client.print(strlen(wifiPass) > 0 ? "••••••••" : "Nenastaveno");
-    client.println(F("</div>"));
+    case PAGE_FIELD_RESTART:
+        if (!isAPMode)
+            out.print(F("<div style='margin-top:25px;text-align:center'>"
+                        "<form method='POST' action='/restart'><button class='btn-sec'>🔄 Restart</button></form></div>\n"));
+        break;
 
-    if (!isAPMode)
-    {
-        client.println(F("<div class='info-item'><span class='info-label'>IP adresa:</span> "));
-        client.print(WiFi.localIP());
-        client.println(F("</div><div class='info-item'><span class='info-label'>EMG TCP port:</span> "));
-        client.print(tcpPort);
-        client.println(F("</div>"));
+    case PAGE_FIELD_STEPS:
+        if (strlen(wifiSSID) > 0)
+        {
+            out.print(F("• Připojení k WiFi: <b>"));
+            out.print(wifiSSID);
+            out.print(F("</b><br>• Spuštění EMG serveru na portu "));
+            out.print(tcpPort);
+            out.print(F("<br>\n"));
+        }
+        else
+        {
+            out.print(F("• Spuštění Access Point<br>\n"));
+        }
+        break;
     }
-    client.println(F("</div>"));
+}
 
-    client.println(F("<div class='info-box'><h2>ℹ️ Systém</h2>"));
-    client.println(F("<div class='info-item'><span class='info-label'>Stav:</span> "));
-    client.print(isAPMode ? F("Konfigurační režim") : F("EMG režim - TCP server aktivní"));
-    client.println(F("</div><div class='info-item'><span class='info-label'>Verze:</span> EMG System v1.0</div>"));
-    client.println(F("<div class='info-item'><span class='info-label'>Protokol:</span> TCP/IP s ALIVE keepalive</div>"));
-    client.println(F("<div class='info-item'><span class='info-label'>REST API:</span> GET /status, POST /send-command</div>"));
-    client.println(F("<div class='info-item'><span class='info-label'>Senzory:</span> 2x EMG (A0, A1)</div>"));
-    client.println(F("<div class='info-item'><span class='info-label'>Frekvence:</span> "));
-    client.print(refreshRateHz);
-    client.println(F(" Hz</div>"));
-
-    if (isAPMode)
-    {
-        client.println(F("<div class='info-item'><span class='info-label'>Access Point:</span> "));
-        client.print(apSSID);
-        client.println(F("</div><div class='info-item'><span class='info-label'>AP heslo:</span> "));
-        client.print(apPass);
-        client.println(F("</div><div class='info-item'><span class='info-label'>AP IP:</span> "));
-        client.print(WiFi.localIP());
-        client.println(F("</div>"));
-    }
-    else
+/**
+ * @brief Odešle sekci stránky s histogramem odezvy řídicího klienta
+ * @param client Výstup pro odpověď
+ */
+void WiFiConfigSystem::sendRttSection(Print &client)
+{
+    const RttHistogram &rtt = emgSystem.getRttHistogram();
+
+    client.println(F("<div class='info-box'><h2>⏱️ Odezva klienta (RTT)</h2>"));
+    client.println(F("<div class='info-item'><span class='info-label'>Měření:</span> "));
+    client.print(rtt.getSamples());
+    client.print(F(" odezev, ztraceno "));
+    client.print(rtt.getLost());
+    client.println(F("</div><div class='info-item'><span class='info-label'>min/p50/p99/max:</span> "));
+    client.print(rtt.getMinUs() / 1000.0, 1);
+    client.print('/');
+    client.print(rtt.getPercentileUs(50) / 1000.0, 1);
+    client.print('/');
+    client.print(rtt.getPercentileUs(99) / 1000.0, 1);
+    client.print('/');
+    client.print(rtt.getMaxUs() / 1000.0, 1);
+    client.println(F(" ms</div>"));
+
+    // Řádek na každý neprázdný koš, délka pruhu je podíl z nejplnějšího koše
+    uint16_t peak = 1;
+    for (uint8_t i = 0; i < rttHistogramBuckets; i++)
+        peak = max(peak, rtt.getCount(i));
+
+    for (uint8_t i = 0; i < rttHistogramBuckets; i++)
     {
-        client.println(F("<div class='info-item'><span class='info-label'>ALIVE interval:</span> "));
-        client.print(aliveIntervalMs / 1000);
-        client.println(F(" s</div><div class='info-item'><span class='info-label'>WiFi signál:</span> "));
-        client.print(WiFi.RSSI());
-        client.println(F(" dBm</div>"));
-    }
-    client.println(F("</div>"));
+        uint16_t count = rtt.getCount(i);
+        if (count == 0)
+            continue;
 
-    if (!isAPMode)
-    {
-        client.println(F("<div style='margin-top:25px;text-align:center'>"));
-        client.println(F("<button onclick=\"location.href='/restart'\" class='btn-sec'>🔄 Restart</button></div>"));
+        client.print(F("<div class='info-item'><span class='info-label'>"));
+        if (i < rttHistogramBuckets - 1)
+        {
+            client.print(F("&lt; "));
+            client.print(RttHistogram::getBucketLimitUs(i) / 1000.0, 3);
+        }
+        else
+        {
+            client.print(F("&ge; "));
+            client.print(RttHistogram::getBucketLimitUs(i - 1) / 1000.0, 3);
+        }
+        client.print(F(" ms:</span> <span style='display:inline-block;height:10px;background:#3498db;width:"));
+        client.print((uint32_t)count * 60 / peak);
+        client.print(F("%'></span> "));
+        client.print(count);
+        client.println(F("</div>"));
     }
 
-    client.println(F("</div></body></html>"));
+    if (!emgSystem.hasControlClient())
+        client.println(F("<div class='info-item'>Řídicí klient není připojen.</div>"));
+    client.println(F("</div>"));
 }
 
 /**
- * @brief Inicializuje WiFi systém a načte konfiguraci z EEPROM
+ * @brief Inicializuje WiFi systém, načte konfiguraci z EEPROM a zahájí připojování
  */
 void WiFiConfigSystem::begin()
 {
@@ -403,23 +661,19 @@ void WiFiConfigSystem::begin()
     EEPROMManager::readString(EEPROM_ADDR_WIFIPASS, wifiPass, sizeof(wifiPass));
 
     printIfPinLow(F("EEPROM data načtena"), debugPin);
+    bootStats.networkStartMs = millis();
+
+    // Vzorkování a případná kalibrace běží souběžně s připojováním
+    emgSystem.begin();
+
+    // begin a beginAP jinak čekají na výsledek uvnitř knihovny, stav se sleduje v update()
+    WiFi.setTimeout(0);
 
     // Pokus o připojení k WiFi, pokud máme uložené údaje
-    if (connectToWiFi())
-    {
-        isAPMode = false;
-        printIfPinLow(F("WiFi připojeno - spouštím EMG systém"), debugPin);
-        emgSystem.beginServer();
-    }
-    else
+    if (!startConnecting())
     {
         printIfPinLow(F("Spouštím AP režim..."), debugPin);
-        isAPMode = true;
-        if (!startAccessPoint())
-        {
-            while (true)
-                ; // Zastavení při chybě AP
-        }
+        startAccessPoint();
     }
 
     initialized = true;
@@ -433,89 +687,506 @@ void WiFiConfigSystem::update()
     if (!initialized)
         return;
 
-    // V AP režimu zpracovávej web konfiguraci
-    if (isAPMode)
+    // V AP režimu jen konfigurační stránka, jinak i EMG systém (během připojování a výpadku bez TCP serveru)
+    unsigned long start = micros();
+    if (!isAPMode)
+        emgSystem.update();
+    if (wifiState == WIFI_STATE_STA || wifiState == WIFI_STATE_AP)
+        serviceHttp();
+    // Odpojení před restartem není výpadek, spojení se už neobnovuje
+    if (!rebootDisconnected)
+        advanceConnection();
+    serviceReboot();
+
+    unsigned long elapsed = micros() - start;
+    loopStats.passes++;
+    loopStats.lastUs = elapsed > 0xFFFF ? 0xFFFF : elapsed;
+    if (loopStats.lastUs > loopStats.maxUs)
+        loopStats.maxUs = loopStats.lastUs;
+}
+
+/**
+ * @brief Obslouží HTTP server (neblokující, volat v každém průchodu)
+ */
+void WiFiConfigSystem::serviceHttp()
+{
+    // Zpracování EMG má přednost, HTTP počká na průchod bez nahromaděných snímků
+    if (emgSystem.getPendingFrames() > httpMaxBacklogFrames)
     {
-        WiFiClient client = server.available();
-        if (!client)
-            return;
+        httpStats.deferred++;
+        return;
+    }
+
+    unsigned long start = micros();
+    acceptHttp();
 
-        printIfPinLow(F("Klient připojen"), debugPin);
+    unsigned long now = millis();
+    for (uint8_t i = 0; i < httpMaxConnections; i++)
+    {
+        HttpSlot &slot = httpSlots[i];
+        if (!slot.client || slot.parser.isComplete())
+            continue;
 
-        char reqLine[256] = "";
-        int reqIndex = 0;
-        unsigned long timeout = millis();
-        while (client.connected() && millis() - timeout < 2000)
+        if (now - slot.startMs >= httpRequestTimeoutMs)
         {
-            if (client.available())
-            {
-                char c = client.read();
-                if (reqIndex < sizeof(reqLine) - 1)
-                {
-                    reqLine[reqIndex++] = c;
-                    reqLine[reqIndex] = '\0';
-                }
-                if (c == '\n')
-                    break;
-            }
+            httpStats.timeouts++;
+            closeHttp(slot);
+            continue;
         }
+        readHttp(slot, start);
+    }
 
-        printIfPinLow(reqLine, debugPin);
-
-        // Zpracování GET parametrů
-        if (strncmp(reqLine, "GET /?", 6) == 0)
+    // Odpověď zabere několik zápisů do modulu, v jednom průchodu se odešle nejvýše jedna
+    for (uint8_t i = 0; i < httpMaxConnections; i++)
+    {
+        if (httpSlots[i].client && httpSlots[i].parser.isComplete())
         {
-            if (handleWiFiConfig(reqLine, client))
-            {
-                delay(50);
-                client.stop();
-                printIfPinLow(F("Klient odpojen po uložení konfigurace"), debugPin);
+            respondHttp(httpSlots[i]);
+            break;
+        }
+    }
 
-                // Krátká pauza před restartem
-                delay(2000);
+    unsigned long elapsed = micros() - start;
+    if (elapsed > httpStats.maxServiceUs)
+        httpStats.maxServiceUs = elapsed > 0xFFFF ? 0xFFFF : elapsed;
+}
 
-                // Ukončíme WiFi spojení
-                WiFi.disconnect();
-                delay(500);
+/**
+ * @brief Naplánuje restart po odeslání odpovědi (provede ho serviceReboot)
+ */
+void WiFiConfigSystem::scheduleReboot()
+{
+    if (rebootPending)
+        return;
+    rebootPending = true;
+    rebootStageMs = millis();
+}
+
+/**
+ * @brief Provede naplánovaný restart po uplynutí lhůt (neblokující, volat v každém průchodu)
+ */
+void WiFiConfigSystem::serviceReboot()
+{
+    if (!rebootPending)
+        return;
+
+    // EMG systém i HTTP mezitím běží dál, smyčka na lhůty nečeká
+    unsigned long now = millis();
+    if (!rebootDisconnected)
+    {
+        if (now - rebootStageMs < rebootReplyMs)
+            return;
+        printIfPinLow(F("Restartování po požadavku HTTP..."), debugPin);
+        WiFi.disconnect();
+        rebootDisconnected = true;
+        rebootStageMs = now;
+        return;
+    }
+
+    if (now - rebootStageMs >= rebootDisconnectMs)
+        reboot();
+}
 
-                // Restartujeme systém
-                printIfPinLow(F("Restartování po uložení nové konfigurace..."), debugPin);
-                reboot();
+/**
+ * @brief Vrací true, pokud se restart a změna WiFi údajů musí odmítnout
+ */
+bool WiFiConfigSystem::isConfigLocked() const
+{
+    // Řídicí klient by přišel o spojení uprostřed ovládání robota
+    return !isAPMode && emgSystem.hasControlClient();
+}
+
+/**
+ * @brief Přijme nové HTTP spojení (nejvýše jednou za clientStatusIntervalMs)
+ */
+void WiFiConfigSystem::acceptHttp()
+{
+    // Dotaz prochází všechny sockety modulu, stejně jako u TCP serveru EMG
+    unsigned long now = millis();
+    if (now - lastHttpAcceptMs < clientStatusIntervalMs)
+        return;
+    lastHttpAcceptMs = now;
+
+    // server.available() vrací i už přijatá spojení, která mají data ke čtení
+    WiFiClient incoming = server.available();
+    if (!incoming)
+        return;
+
+    HttpSlot *free = nullptr;
+    for (uint8_t i = 0; i < httpMaxConnections; i++)
+    {
+        if (httpSlots[i].client && httpSlots[i].client == incoming)
+            return;
+        if (!httpSlots[i].client && !free)
+            free = &httpSlots[i];
+    }
+
+    if (!free)
+    {
+        sendHttpError(incoming, 503);
+        incoming.stop();
+        httpStats.rejected++;
+        return;
+    }
+
+    free->client = incoming;
+    free->tx.clear();
+    free->parser.reset();
+    free->startMs = now;
+}
+
+/**
+ * @brief Přečte dostupnou část požadavku
+ * @param slot HTTP spojení
+ * @param start Čas začátku obsluhy průchodu (micros)
+ */
+void WiFiConfigSystem::readHttp(HttpSlot &slot, unsigned long start)
+{
+    // Čte se jen to, co už v modulu čeká; zbytek požadavku počká na další průchod
+    int available = slot.client.available();
+    if (available <= 0)
+        return;
+    if (available > httpRxBudgetBytes)
+        available = httpRxBudgetBytes;
+
+    uint8_t chunk[clientRxChunkBytes];
+    while (available > 0 && micros() - start < httpRxBudgetUs)
+    {
+        int count = slot.client.read(chunk, available < (int)sizeof(chunk) ? available : sizeof(chunk));
+        if (count <= 0)
+        {
+            closeHttp(slot);
+            return;
+        }
+        available -= count;
+
+        for (int i = 0; i < count; i++)
+        {
+            if (slot.parser.feed(chunk[i]) != HTTP_PARSE_PENDING)
                 return;
-            }
         }
+    }
+}
+
+/**
+ * @brief Vyhledá adresu v tabulce, zapíše odpověď a zavře spojení
+ * @param slot HTTP spojení s dokončeným požadavkem
+ */
+void WiFiConfigSystem::respondHttp(HttpSlot &slot)
+{
+    const HttpRequestParser &request = slot.parser;
+    uint16_t error = request.getError();
 
-        // Zpracování restart požadavku
-        if (strncmp(reqLine, "GET /restart", 12) == 0)
+    if (!error)
+    {
+        error = 404;
+        for (uint8_t i = 0; i < sizeof(httpRoutes) / sizeof(httpRoutes[0]); i++)
         {
-            sendRestartPage(client);
-            delay(50);
-            client.stop();
-            printIfPinLow(F("Restartování Arduino..."), debugPin);
+            if (strcmp(request.getPath(), httpRoutes[i].path) != 0)
+                continue;
+            if (request.getMethod() != httpRoutes[i].method)
+            {
+                error = 405;
+                continue;
+            }
+            (this->*httpRoutes[i].handler)(slot);
+            error = 0;
+            break;
+        }
+    }
 
-            // Ukončíme WiFi spojení
-            WiFi.disconnect();
+    if (error)
+    {
+        sendHttpError(slot.tx, error);
+        httpStats.errors++;
+    }
+    httpStats.requests++;
+    slot.tx.flush(false);
+    if (slot.tx.hasFailed())
+        httpStats.truncated++;
+
+    // Nepřečtený zbytek požadavku (např. po chybě 414) by zavření změnil na RST a odpověď by se ztratila
+    uint8_t chunk[clientRxChunkBytes];
+    for (uint8_t i = 0; i < httpDrainChunks && slot.client.available() > 0; i++)
+    {
+        if (slot.client.read(chunk, sizeof(chunk)) <= 0)
+            break;
+    }
+    closeHttp(slot);
+}
 
-            // Počkáme na dokončení všech operací
-            delay(1000);
+/**
+ * @brief Zavře HTTP spojení a uvolní slot
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::closeHttp(HttpSlot &slot)
+{
+    slot.tx.clear();
+    slot.parser.reset();
+    slot.client.stop();
+}
 
-            // Restartujeme systém
-            reboot();
-            return;
-        }
+/**
+ * @brief Zapíše stavový řádek a hlavičky odpovědi
+ * @param out Výstup odpovědi
+ * @param code Stavový kód HTTP
+ * @param contentType Typ obsahu
+ * @param contentLength Délka těla (0 = neuvedena, tělo končí zavřením spojení)
+ * @param gzip True pro tělo komprimované gzip
+ */
+void WiFiConfigSystem::sendHttpHeader(Print &out, uint16_t code, const __FlashStringHelper *contentType,
+                                      uint32_t contentLength, bool gzip)
+{
+    out.print(F("HTTP/1.1 "));
+    out.print(code);
+    out.print(' ');
+    out.println(httpStatusText(code));
+    out.print(F("Content-Type: "));
+    out.println(contentType);
+    if (contentLength > 0)
+    {
+        out.print(F("Content-Length: "));
+        out.println(contentLength);
+    }
+    if (gzip)
+        out.println(F("Content-Encoding: gzip"));
+    out.println(F("Cache-Control: no-store"));
+    out.println(F("Access-Control-Allow-Origin: *"));
+    out.println(F("Connection: close"));
+    out.println();
+}
+
+/**
+ * @brief Zapíše chybovou odpověď s JSON tělem {"error":kód}
+ * @param out Výstup odpovědi
+ * @param code Stavový kód HTTP
+ */
+void WiFiConfigSystem::sendHttpError(Print &out, uint16_t code)
+{
+    sendHttpHeader(out, code, F("application/json"));
+    out.print(F("{\"error\":"));
+    out.print(code);
+    out.println('}');
+}
 
-        // HTML odpověď - hlavní stránka
-        sendConfigPage(client);
+/**
+ * @brief GET / - konfigurační stránka (bez vedlejších účinků)
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::handlePageRequest(HttpSlot &slot)
+{
+    sendPage(slot.tx, webConfigPage);
+}
 
-        delay(10);
-        client.stop();
-        printIfPinLow(F("Klient odpojen"), debugPin);
+/**
+ * @brief POST / - uloží WiFi údaje z formuláře (input1, input2) a restartuje zařízení
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::handleConfigFormRequest(HttpSlot &slot)
+{
+    uint16_t error = isConfigLocked() ? 409 : 0;
+    if (!error && !handleWiFiConfig(slot.parser.getBody(), slot.tx))
+        error = 400;
+    if (error)
+    {
+        sendHttpError(slot.tx, error);
+        httpStats.errors++;
+        return;
     }
-    else
+    scheduleReboot();
+}
+
+/**
+ * @brief POST /restart - stránka restartu, zařízení se po odeslání restartuje
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::handleRestartRequest(HttpSlot &slot)
+{
+    if (isConfigLocked())
     {
-        // V WiFi režimu zpracovávej EMG systém a REST API
-        emgSystem.update();
+        sendHttpError(slot.tx, 409);
+        httpStats.errors++;
+        return;
+    }
+    sendPage(slot.tx, webRestartPage);
+    scheduleReboot();
+}
+
+/**
+ * @brief GET /status - stav EMG systému jako JSON
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::handleStatusRequest(HttpSlot &slot)
+{
+    Print &out = slot.tx;
+    static const char *const modeNames[] = {"EMA", "MAV", "RMS"};
+    int command = emgSystem.getCurrentCommand();
+
+    sendHttpHeader(out, 200, F("application/json"));
+    out.print(F("{\"uptimeMs\":"));
+    out.print(millis());
+    out.print(F(",\"ramUnused\":"));
+    out.print(getUntouchedMemory());
+    out.print(F(",\"initialized\":"));
+    out.print(emgSystem.isInitialized() ? F("true") : F("false"));
+    out.print(F(",\"calibrating\":"));
+    out.print(emgSystem.isCalibrating() ? F("true") : F("false"));
+    out.print(F(",\"calibrationProgress\":"));
+    out.print(emgSystem.getCalibrationProgress());
+    out.print(F(",\"command\":"));
+    out.print(command);
+    out.print(F(",\"commandLabel\":\""));
+    out.print(getCommandLabel(command));
+    out.print(F("\",\"envelopeMode\":\""));
+    out.print(modeNames[emgSystem.getEnvelopeMode()]);
+    out.print(F("\",\"clients\":"));
+    out.print(emgSystem.getClientCount());
+    out.print(F(",\"control\":"));
+    out.print(emgSystem.hasControlClient() ? F("true") : F("false"));
+
+    // Hodnoty kanálů ve voltech
+    out.print(F(",\"channels\":["));
+    for (uint8_t i = 0; i < emgSystem.getChannelCount(); i++)
+    {
+        if (i > 0)
+            out.print(',');
+        out.print(F("{\"envelope\":"));
+        out.print(emgSystem.getEnvelope(i), 4);
+        out.print(F(",\"upper\":"));
+        out.print(emgSystem.getThresholdUpper(i), 4);
+        out.print(F(",\"lower\":"));
+        out.print(emgSystem.getThresholdLower(i), 4);
+        out.print(F(",\"baseline\":"));
+        out.print(emgSystem.getBaseline(i), 4);
+        out.print(F(",\"baselineFault\":"));
+        out.print(emgSystem.hasBaselineFault(i) ? F("true") : F("false"));
+        out.print('}');
+    }
+
+    // maxUs platí od posledního dotazu, pravidelné dotazy tak ukazují špičky průběžně
+    out.print(F("],\"loop\":{\"passes\":"));
+    out.print(loopStats.passes);
+    out.print(F(",\"lastUs\":"));
+    out.print(loopStats.lastUs);
+    out.print(F(",\"maxUs\":"));
+    out.print(loopStats.maxUs);
+    out.print(F(",\"pendingFrames\":"));
+    out.print(emgSystem.getPendingFrames());
+    out.print(F(",\"samples\":"));
+    out.print(emgSystem.getSampleCount());
+    out.print(F(",\"overruns\":"));
+    out.print(emgSystem.getOverrunCount());
+
+    // Skutečná doba filtrů vedle ručního odhadu z EMGFilter.h
+    const EMGFilterProbe &probe = emgSystem.getFilterProbe();
+    out.print(F(",\"filterUs\":"));
+    out.print(probe.samples ? probe.totalUs / probe.samples : 0);
+    out.print(F(",\"filterMaxUs\":"));
+    out.print(probe.maxUs);
+    out.print(F(",\"filterEstimateUs\":"));
+    out.print(emgSystem.getFilterEstimateUs());
+    loopStats.maxUs = 0;
+
+    const RttHistogram &rtt = emgSystem.getRttHistogram();
+    out.print(F("},\"rtt\":{\"samples\":"));
+    out.print(rtt.getSamples());
+    out.print(F(",\"lost\":"));
+    out.print(rtt.getLost());
+    out.print(F(",\"p50Us\":"));
+    out.print(rtt.getPercentileUs(50));
+    out.print(F(",\"p99Us\":"));
+    out.print(rtt.getPercentileUs(99));
+
+    out.print(F("},\"http\":{\"requests\":"));
+    out.print(httpStats.requests);
+    out.print(F(",\"errors\":"));
+    out.print(httpStats.errors);
+    out.print(F(",\"timeouts\":"));
+    out.print(httpStats.timeouts);
+    out.print(F(",\"rejected\":"));
+    out.print(httpStats.rejected);
+    out.print(F(",\"deferred\":"));
+    out.print(httpStats.deferred);
+    out.print(F(",\"truncated\":"));
+    out.print(httpStats.truncated);
+    out.print(F(",\"maxServiceUs\":"));
+    out.print(httpStats.maxServiceUs);
+
+    out.print(F("},\"boot\":{\"networkStartMs\":"));
+    out.print(bootStats.networkStartMs);
+    out.print(F(",\"servingMs\":"));
+    out.print(bootStats.servingMs);
+    out.print(F(",\"wifiStatus\":"));
+    out.print(bootStats.fallbackStatus);
+
+    out.print(F("},\"link\":{\"outages\":"));
+    out.print(linkStats.outages);
+    out.print(F(",\"attempts\":"));
+    out.print(linkStats.attempts);
+    out.print(F(",\"lastOutageMs\":"));
+    out.print(linkStats.lastOutageMs);
+    out.print(F(",\"maxOutageMs\":"));
+    out.print(linkStats.maxOutageMs);
+    out.print(F(",\"totalOutageMs\":"));
+    out.print(linkStats.totalOutageMs);
+    out.print(F(",\"lastReconnectMs\":"));
+    out.print(linkStats.lastReconnectMs);
+    out.print(F(",\"lastStatus\":"));
+    out.print(linkStats.lastStatus);
+    out.println(F("}}"));
+}
+
+/**
+ * @brief POST /send-command - odešle robotovi aktuální nebo zadaný příkaz (command=N)
+ * @param slot HTTP spojení
+ */
+void WiFiConfigSystem::handleSendCommandRequest(HttpSlot &slot)
+{
+    // Kód příkazu z těla formuláře, případně z dotazu; bez něj se pošle aktuálně zvolený
+    int command = emgSystem.getCurrentCommand();
+    FormParser params;
+    params.parse(slot.parser.getBody());
+    const char *value = params.get("command");
+    if (!value)
+    {
+        params.parse(slot.parser.getQuery());
+        value = params.get("command");
+    }
+    if (value)
+    {
+        size_t digits = strspn(value, "0123456789");
+        command = atoi(value);
+        if (digits == 0 || digits > 3 || value[digits] ||
+            strcmp(getCommandLabel(command), "UNKNOWN") == 0)
+        {
+            sendHttpError(slot.tx, 400);
+            httpStats.errors++;
+            return;
+        }
+    }
+
+    Print &out = slot.tx;
+    bool sent = emgSystem.sendCommand(command);
+    sendHttpHeader(out, sent ? 200 : 409, F("application/json"));
+    out.print(F("{\"sent\":"));
+    out.print(sent ? F("true") : F("false"));
+    out.print(F(",\"command\":"));
+    out.print(command);
+    out.print(F(",\"label\":\""));
+    out.print(getCommandLabel(command));
+    out.print('"');
+    if (!sent)
+    {
+        out.print(F(",\"reason\":\""));
+        if (!emgSystem.hasControlClient())
+            out.print(F("NO_CONTROL"));
+        else if (!emgSystem.isInitialized() || command == 0)
+            out.print(F("NOT_READY"));
+        else
+            out.print(F("COOLDOWN"));
+        out.print('"');
     }
+    out.println('}');
 }
 
 /**
@@ -563,4 +1234,36 @@ bool WiFiConfigSystem::hasWiFiPassword() const
 void WiFiConfigSystem::setLCDDisplay(LCDDisplay *lcd)
 {
     lcdDisplay = lcd;
+}
+
+/**
+ * @brief Vrací čítače HTTP serveru
+ */
+const HttpStats &WiFiConfigSystem::getHttpStats() const
+{
+    return httpStats;
+}
+
+/**
+ * @brief Vrací dobu průchodu hlavní smyčkou
+ */
+const LoopStats &WiFiConfigSystem::getLoopStats() const
+{
+    return loopStats;
+}
+
+/**
+ * @brief Vrací časy startu
+ */
+const BootStats &WiFiConfigSystem::getBootStats() const
+{
+    return bootStats;
+}
+
+/**
+ * @brief Vrací statistiku výpadků spojení v režimu STA
+ */
+const LinkStats &WiFiConfigSystem::getLinkStats() const
+{
+    return linkStats;
 }
\ No newline at end of file
@@ -4,60 +4,349 @@
 #include <Arduino.h>
 #include <WiFiNINA.h>
 #include "EMGSystem.h"
+#include "TxBuffer.h"
+#include "HttpRequestParser.h"
+#include "WebPages.h"
 #include "LCDDisplay.h"
 
+/**
+ * @struct HttpSlot
+ * @brief Rozpracované HTTP spojení s parserem požadavku a výstupním bufferem
+ */
+struct HttpSlot
+{
+    WiFiClient client;           // Spojení (neplatné = volný slot)
+    uint8_t txData[httpTxBytes]; // Paměť výstupního bufferu
+    TxBuffer tx;                 // Odpověď, odchází po httpTxBytes místo po řádcích
+    HttpRequestParser parser;    // Rozpracovaný požadavek
+    unsigned long startMs;       // Přijetí spojení (millis), hlídá se httpRequestTimeoutMs
+
+    HttpSlot() : tx(client, txData, sizeof(txData)), startMs(0)
+    {
+    }
+    HttpSlot(const HttpSlot &) = delete; // tx drží referenci na vlastní client a txData
+    HttpSlot &operator=(const HttpSlot &) = delete;
+};
+
+/**
+ * @struct HttpStats
+ * @brief Čítače HTTP serveru
+ */
+struct HttpStats
+{
+    uint32_t requests = 0;     // Zodpovězené požadavky
+    uint32_t errors = 0;       // Z toho chybné (4xx)
+    uint32_t timeouts = 0;     // Nedokončené požadavky zahozené po httpRequestTimeoutMs
+    uint32_t rejected = 0;     // Spojení odmítnutá kódem 503 (všechny sloty obsazené)
+    uint32_t deferred = 0;     // Průchody, kdy HTTP ustoupilo nahromaděným snímkům EMG
+    uint32_t truncated = 0;    // Odpovědi, které modul nepřijal celé (spojení se zavřelo)
+    uint16_t maxServiceUs = 0; // Nejdelší obsluha HTTP v jednom průchodu smyčkou
+};
+
+/**
+ * @enum WiFiState
+ * @brief Stav připojování k síti (posouvá se v update, nic neblokuje)
+ */
+enum WiFiState : uint8_t
+{
+    WIFI_STATE_CONNECTING,   // Čeká se na připojení k uložené síti
+    WIFI_STATE_AP_STARTING,  // Čeká se, až modul spustí Access Point
+    WIFI_STATE_STA,          // Připojeno, běží TCP server EMG a HTTP server
+    WIFI_STATE_AP,           // Běží Access Point s konfigurační stránkou
+    WIFI_STATE_RECONNECTING, // Výpadek v režimu STA, spojení se obnovuje s rostoucím odkladem
+};
+
+/**
+ * @struct BootStats
+ * @brief Časy startu od zapnutí (millis)
+ */
+struct BootStats
+{
+    uint32_t networkStartMs = 0; // Konec setup(), start připojování
+    uint32_t servingMs = 0;      // HTTP server přijímá spojení (0 = ještě ne)
+    uint8_t fallbackStatus = 0;  // Stav WiFi, po kterém se přešlo do AP (WL_CONNECTED = nepřešlo, 0 = bez údajů)
+};
+
+/**
+ * @struct LinkStats
+ * @brief Výpadky spojení s přístupovým bodem v režimu STA
+ */
+struct LinkStats
+{
+    uint16_t outages = 0;         // Počet výpadků
+    uint16_t attempts = 0;        // Pokusy o obnovení (WiFi.begin) ve všech výpadcích
+    uint32_t downSinceMs = 0;     // Začátek probíhajícího výpadku (platí ve stavu WIFI_STATE_RECONNECTING)
+    uint32_t lastOutageMs = 0;    // Délka posledního skončeného výpadku
+    uint32_t maxOutageMs = 0;     // Nejdelší výpadek
+    uint32_t totalOutageMs = 0;   // Součet skončených výpadků
+    uint32_t lastReconnectMs = 0; // Trvání úspěšného pokusu (od WiFi.begin po WL_CONNECTED)
+    uint8_t lastStatus = 0;       // Stav modulu, kterým začal poslední výpadek
+};
+
+/**
+ * @struct LoopStats
+ * @brief Doba průchodu hlavní smyčkou (EMG systém a HTTP)
+ */
+struct LoopStats
+{
+    uint32_t passes = 0; // Počet průchodů
+    uint16_t lastUs = 0; // Doba posledního průchodu
+    uint16_t maxUs = 0;  // Nejdelší průchod od posledního dotazu GET /status
+};
+
 /**
  * @class WiFiConfigSystem
  * @brief Třída pro správu WiFi konfigurace a web serveru
+ *
+ * V režimu AP obsluhuje konfigurační stránku. V režimu STA běží HTTP server
+ * vedle TCP serveru EMG (GET /status, POST /send-command, GET /, POST /restart).
+ * Restart a změna WiFi údajů mění stav, proto jen přes POST a v režimu STA
+ * ne při připojeném řídicím klientovi (409).
+ * Oba režimy sdílí stejný neblokující server, v AP režimu jen bez EMG.
+ * Připojení k síti je stavový automat (WiFiState) posouvaný z update, takže
+ * vzorkování a kalibrace běží už během připojování a do AP režimu se přejde,
+ * jakmile modul ohlásí, že se připojit nepodaří.
+ * Požadavky se skládají po bajtech napříč průchody smyčkou s omezením
+ * httpRxBudgetBytes/Us, odpoví se nejvýše na jeden za průchod a při
+ * nahromaděných snímcích EMG se HTTP v průchodu vynechá.
  */
 class WiFiConfigSystem
 {
 private:
+    /**
+     * @struct HttpRoute
+     * @brief Položka tabulky adres HTTP serveru
+     */
+    struct HttpRoute
+    {
+        HttpMethod method;                                 // Povolená metoda
+        const char *path;                                  // Cesta bez dotazu
+        void (WiFiConfigSystem::*handler)(HttpSlot &slot); // Obsluha, zapíše celou odpověď do slot.tx
+    };
+
+    static const HttpRoute httpRoutes[];            // Tabulka adres (GET a POST /, GET /status, POST /send-command, POST /restart)
+    static const uint8_t httpDrainChunks = 16;      // Max. počet bloků nepřečteného požadavku zahozených před zavřením
+    static const uint16_t rebootReplyMs = 1000;     // Odklad odpojení před restartem, prohlížeč dočte odpověď
+    static const uint16_t rebootDisconnectMs = 500; // Odklad restartu po odpojení od sítě
+
     WiFiServer server;      // HTTP server instance
     char wifiSSID[32];      // Uložené WiFi SSID (C-string)
     char wifiPass[32];      // Uložené WiFi heslo (C-string)
     bool isAPMode;          // Příznak režimu Access Point
+    WiFiState wifiState;    // Stav připojování k síti
     bool initialized;       // Příznak inicializace systému
     EMGSystem &emgSystem;   // Reference na EMG systém
     LCDDisplay *lcdDisplay; // Pointer na LCD displej
 
+    HttpSlot httpSlots[httpMaxConnections]; // Rozpracovaná HTTP spojení
+    unsigned long lastHttpAcceptMs = 0;     // Čas posledního dotazu na nová HTTP spojení
+    bool rebootPending = false;             // Po odeslání odpovědi se zařízení restartuje
+    bool rebootDisconnected = false;        // Před restartem už proběhlo odpojení od sítě
+    unsigned long rebootStageMs = 0;        // Začátek aktuální fáze restartu (millis)
+    HttpStats httpStats;                    // Čítače HTTP serveru
+    LoopStats loopStats;                    // Doba průchodu smyčkou
+    BootStats bootStats;                    // Časy startu
+    unsigned long stateStartMs = 0;         // Vstup do aktuálního stavu WiFiState
+    unsigned long lastWiFiPollMs = 0;       // Čas posledního dotazu na stav modulu
+    unsigned long lastProgressMs = 0;       // Čas poslední obnovy průběhu na LCD
+    unsigned long noSsidSinceMs = 0;        // Od kdy modul hlásí nenalezenou síť
+    bool noSsid = false;                    // Modul hlásí nenalezenou síť
+    LinkStats linkStats;                    // Výpadky spojení v režimu STA
+    uint16_t retryWaitMs = 0;               // Odklad dalšího pokusu o obnovení spojení
+    bool attemptActive = false;             // Pokus o obnovení spojení právě běží
+
+    /**
+     * @brief Zahájí připojení k uložené WiFi síti (neblokující)
+     * @return False pokud nejsou uložené přihlašovací údaje
+     */
+    bool startConnecting();
+
     /**
-     * @brief Pokusí se připojit k WiFi síti
-     * @return True pokud se připojení podařilo
+     * @brief Zahájí spuštění Access Pointu (neblokující)
      */
-    bool connectToWiFi();
+    void startAccessPoint();
 
     /**
-     * @brief Spustí Access Point režim
-     * @return True pokud se AP spustil úspěšně
+     * @brief Posune stav připojování a hlídá spojení v režimu STA (dotaz na modul jen po intervalech)
      */
-    bool startAccessPoint();
+    void advanceConnection();
+
+    /**
+     * @brief Vyhodnotí, zda probíhající pokus o připojení nemá naději
+     * @param status Stav z WiFi.status()
+     * @param now Aktuální čas (millis)
+     * @return True po odmítnutí přihlášení nebo po wifiNoSsidGraceMs bez nalezené sítě
+     */
+    bool isHopeless(uint8_t status, unsigned long now);
+
+    /**
+     * @brief Vyhodnotí stav modulu při připojování k uložené síti
+     * @param status Stav z WiFi.status()
+     * @param now Aktuální čas (millis)
+     */
+    void pollConnecting(uint8_t status, unsigned long now);
+
+    /**
+     * @brief Vyhodnotí stav modulu při spouštění Access Pointu
+     * @param status Stav z WiFi.status()
+     * @param now Aktuální čas (millis)
+     */
+    void pollAccessPoint(uint8_t status, unsigned long now);
+
+    /**
+     * @brief Spustí TCP server EMG a HTTP server po připojení k síti
+     */
+    void onConnected();
+
+    /**
+     * @brief Zastaví servery po výpadku spojení a zahájí jeho obnovu
+     * @param status Stav z WiFi.status(), kterým výpadek začal
+     * @param now Aktuální čas (millis)
+     */
+    void startReconnecting(uint8_t status, unsigned long now);
+
+    /**
+     * @brief Obnovuje spojení po výpadku s rostoucím odkladem mezi pokusy
+     * @param status Stav z WiFi.status()
+     * @param now Aktuální čas (millis)
+     */
+    void pollReconnecting(uint8_t status, unsigned long now);
+
+    /**
+     * @brief Zaznamená výpadek a znovu spustí TCP server EMG a HTTP server
+     * @param now Aktuální čas (millis)
+     */
+    void onReconnected(unsigned long now);
+
+    /**
+     * @brief Spustí HTTP server s konfigurační stránkou po spuštění AP
+     */
+    void onAccessPointReady();
+
+    /**
+     * @brief Zaznamená a vypíše dobu od zapnutí do spuštění HTTP serveru
+     */
+    void markServing();
 
     /**
      * @brief Zpracuje HTTP požadavek s WiFi údaji
-     * @param reqLine Řádek HTTP požadavku (C-string)
-     * @param client WiFi klient pro odpověď
+     * @param form Tělo formuláře s input1 (SSID) a input2 (heslo), rozloží se na místě
+     * @param client Výstup pro odpověď (TxBuffer)
      * @return True pokud byl požadavek zpracován
      */
-    bool handleWiFiConfig(const char *reqLine, WiFiClient &client);
+    bool handleWiFiConfig(char *form, Print &client);
+
+    /**
+     * @brief Odešle předkomprimovanou stránku s doplněnými poli (gzip)
+     * @param client Výstup pro odpověď (TxBuffer)
+     * @param page Stránka z WebPages.h (PROGMEM)
+     */
+    void sendPage(Print &client, const GzipPage &page);
+
+    /**
+     * @brief Vypíše hodnotu dynamického pole stránky
+     * @param field Pole (WebPageField)
+     * @param out Výstup hodnoty
+     */
+    void renderPageField(uint8_t field, Print &out);
+
+    /**
+     * @brief Odešle sekci stránky s histogramem odezvy řídicího klienta
+     * @param client Výstup pro odpověď
+     */
+    void sendRttSection(Print &client);
+
+    /**
+     * @brief Obslouží HTTP server (neblokující, volat v každém průchodu)
+     */
+    void serviceHttp();
+
+    /**
+     * @brief Naplánuje restart po odeslání odpovědi (provede ho serviceReboot)
+     */
+    void scheduleReboot();
+
+    /**
+     * @brief Provede naplánovaný restart po uplynutí lhůt (neblokující, volat v každém průchodu)
+     */
+    void serviceReboot();
+
+    /**
+     * @brief Vrací true, pokud se restart a změna WiFi údajů musí odmítnout
+     */
+    bool isConfigLocked() const;
+
+    /**
+     * @brief Přijme nové HTTP spojení (nejvýše jednou za clientStatusIntervalMs)
+     */
+    void acceptHttp();
+
+    /**
+     * @brief Přečte dostupnou část požadavku
+     * @param slot HTTP spojení
+     * @param start Čas začátku obsluhy průchodu (micros)
+     */
+    void readHttp(HttpSlot &slot, unsigned long start);
 
     /**
-     * @brief Odešle HTML stránku s potvrzením úspěšného uložení
-     * @param client WiFi klient pro odpověď
+     * @brief Vyhledá adresu v tabulce, zapíše odpověď a zavře spojení
+     * @param slot HTTP spojení s dokončeným požadavkem
      */
-    void sendSuccessPage(WiFiClient &client);
+    void respondHttp(HttpSlot &slot);
 
     /**
-     * @brief Odešle HTML stránku pro restart
-     * @param client WiFi klient pro odpověď
+     * @brief Zavře HTTP spojení a uvolní slot
+     * @param slot HTTP spojení
      */
-    void sendRestartPage(WiFiClient &client);
+    void closeHttp(HttpSlot &slot);
 
     /**
-     * @brief Odešle hlavní konfigurační HTML stránku
-     * @param client WiFi klient pro odpověď
+     * @brief Zapíše stavový řádek a hlavičky odpovědi
+     * @param out Výstup odpovědi
+     * @param code Stavový kód HTTP
+     * @param contentType Typ obsahu
+     * @param contentLength Délka těla (0 = neuvedena, tělo končí zavřením spojení)
+     * @param gzip True pro tělo komprimované gzip
      */
-    void sendConfigPage(WiFiClient &client);
+    void sendHttpHeader(Print &out, uint16_t code, const __FlashStringHelper *contentType,
+                        uint32_t contentLength = 0, bool gzip = false);
+
+    /**
+     * @brief Zapíše chybovou odpověď s JSON tělem {"error":kód}
+     * @param out Výstup odpovědi
+     * @param code Stavový kód HTTP
+     */
+    void sendHttpError(Print &out, uint16_t code);
+
+    /**
+     * @brief GET / - konfigurační stránka (bez vedlejších účinků)
+     * @param slot HTTP spojení
+     */
+    void handlePageRequest(HttpSlot &slot);
+
+    /**
+     * @brief POST / - uloží WiFi údaje z formuláře (input1, input2) a restartuje zařízení
+     * @param slot HTTP spojení
+     */
+    void handleConfigFormRequest(HttpSlot &slot);
+
+    /**
+     * @brief POST /restart - stránka restartu, zařízení se po odeslání restartuje
+     * @param slot HTTP spojení
+     */
+    void handleRestartRequest(HttpSlot &slot);
+
+    /**
+     * @brief GET /status - stav EMG systému jako JSON
+     * @param slot HTTP spojení
+     */
+    void handleStatusRequest(HttpSlot &slot);
+
+    /**
+     * @brief POST /send-command - odešle robotovi aktuální nebo zadaný příkaz (command=N)
+     * @param slot HTTP spojení
+     */
+    void handleSendCommandRequest(HttpSlot &slot);
 
 public:
     /**
@@ -68,7 +357,7 @@ public:
     WiFiConfigSystem(EMGSystem &emgSys, LCDDisplay *lcd = nullptr);
 
     /**
-     * @brief Inicializuje WiFi systém a načte konfiguraci z EEPROM
+     * @brief Inicializuje WiFi systém, načte konfiguraci z EEPROM a zahájí připojování
      */
     void begin();
 
@@ -102,6 +391,26 @@ public:
      * @param lcd Pointer na LCD displej
      */
     void setLCDDisplay(LCDDisplay *lcd);
+
+    /**
+     * @brief Vrací čítače HTTP serveru
+     */
+    const HttpStats &getHttpStats() const;
+
+    /**
+     * @brief Vrací dobu průchodu hlavní smyčkou
+     */
+    const LoopStats &getLoopStats() const;
+
+    /**
+     * @brief Vrací časy startu
+     */
+    const BootStats &getBootStats() const;
+
+    /**
+     * @brief Vrací statistiku výpadků spojení v režimu STA
+     */
+    const LinkStats &getLinkStats() const;
 };
 
 #endif // WIFI_CONFIG_SYSTEM_H
@@ -0,0 +1,120 @@
+/**
+ * @file firmware_main.cpp
+ * @brief Celý firmware (setup/loop ze sketche) jako proces na PC
+ *
+ * TCP server EMG a webový server naslouchají na skutečných portech (volitelně
+ * posunutých o --port-offset), EEPROM se ukládá do souboru a analogové vstupy
+ * přehrávají CSV záznam. Připojení k WiFi lze zpomalit (--wifi-ms) nebo
+ * nechat selhat (--wifi-result failed|no-ssid) a sledovat přechod do AP.
+ * Výpadek přístupového bodu za běhu nasimuluje --wifi-outage-at/--wifi-outage-ms.
+ *
+ * Použití: emg_firmware [--eeprom soubor] [--ssid S --pass P] [--port-offset N]
+ *                       [--csv záznam.csv] [--debug] [--serial]
+ *                       [--wifi-ms N] [--wifi-result connected|failed|no-ssid]
+ *                       [--wifi-outage-at N --wifi-outage-ms M]
+ */
+
+#include "HostHAL.h"
+#include "Arduino_final.ino"
+#include <unistd.h>
+
+/**
+ * @brief Vypíše nápovědu k parametrům
+ */
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Použití: %s [--eeprom soubor] [--ssid S --pass P] [--port-offset N]\n"
+            "          [--csv záznam.csv] [--debug] [--serial]\n"
+            "          [--wifi-ms N] [--wifi-result connected|failed|no-ssid]\n"
+            "          [--wifi-outage-at N --wifi-outage-ms M]\n",
+            name);
+}
+
+int main(int argc, char **argv)
+{
+    const char *ssid = nullptr;
+    const char *pass = nullptr;
+    const char *csvPath = nullptr;
+    unsigned long wifiMs = 0;
+    uint8_t wifiResult = WL_CONNECTED;
+    unsigned long outageAtMs = 0;
+    unsigned long outageMs = 0;
+
+    hostSetArgs(argc, argv);
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--eeprom") && hasValue)
+            hostSetEEPROMFile(argv[++i]);
+        else if (!strcmp(argv[i], "--ssid") && hasValue)
+            ssid = argv[++i];
+        else if (!strcmp(argv[i], "--pass") && hasValue)
+            pass = argv[++i];
+        else if (!strcmp(argv[i], "--port-offset") && hasValue)
+            hostSetPortOffset((uint16_t)atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--csv") && hasValue)
+            csvPath = argv[++i];
+        else if (!strcmp(argv[i], "--wifi-ms") && hasValue)
+            wifiMs = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--wifi-result") && hasValue)
+        {
+            const char *result = argv[++i];
+            if (!strcmp(result, "failed"))
+                wifiResult = WL_CONNECT_FAILED;
+            else if (!strcmp(result, "no-ssid"))
+                wifiResult = WL_NO_SSID_AVAIL;
+            else if (strcmp(result, "connected"))
+            {
+                usage(argv[0]);
+                return 2;
+            }
+        }
+        else if (!strcmp(argv[i], "--wifi-outage-at") && hasValue)
+            outageAtMs = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--wifi-outage-ms") && hasValue)
+            outageMs = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--debug"))
+            hostSetPin(debugPin, LOW);
+        else if (!strcmp(argv[i], "--serial"))
+            hostSetPin(serialPrintPin, LOW);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    // Údaje WiFi se zapíší stejně jako z konfigurační stránky AP
+    if (ssid && pass)
+    {
+        EEPROMManager::writeString(EEPROM_ADDR_WIFISSID, ssid);
+        EEPROMManager::writeString(EEPROM_ADDR_WIFIPASS, pass);
+    }
+
+    if (csvPath)
+    {
+        int16_t *samples = nullptr;
+        uint32_t sampleRateHz = 0;
+        size_t count = hostLoadCsv(csvPath, &samples, &sampleRateHz);
+        if (count == 0)
+        {
+            fprintf(stderr, "Nelze načíst %s\n", csvPath);
+            return 1;
+        }
+        for (uint8_t i = 0; i < maxSensors; i++)
+            hostSetAnalogFeed(emgPins[i], samples, count, sampleRateHz, true);
+    }
+
+    hostSetWiFiLink(wifiMs, wifiResult);
+    hostSetWiFiOutage(outageAtMs, outageMs);
+    setup();
+    for (;;)
+    {
+        loop();
+        Serial.flush();
+        // Na desce smyčka běží naplno; na PC stačí krátký spánek, zmeškané periody dohání poll()
+        usleep(100);
+    }
+}
@@ -0,0 +1,496 @@
+/**
+ * @file form_bench.cpp
+ * @brief Kontrola a měření dekódování URL (urlDecode) a rozkladu formulářů (FormParser)
+ *
+ * Kontroly (při chybě návratový kód 1):
+ *  - každý bajt 1-255 zakódovaný jako %XX (velká i malá písmena) i přímo,
+ *  - všechny dvojice bajtů přes kódování a zpět (65 025 řetězců),
+ *  - všechny tříznakové sekvence "%XY" proti referenčnímu dekodéru,
+ *  - dekódování na místě dává totéž co do jiného bufferu,
+ *  - náhodné formuláře s parametry v náhodném pořadí přes FormParser.
+ * Měření porovná ns/bajt nové verze s původním dekodérem (jen %2X a %3X)
+ * a rozklad formuláře s původním hledáním "input1=" / "&input2=" a kopiemi.
+ *
+ * Použití: emg_form_bench [--repeat K] [--seed N]
+ */
+
+#include "HostHAL.h"
+#include "Config.h"
+#include "FormParser.h"
+#include "Utils.h"
+#include <ctype.h>
+#include <random>
+#include <string>
+#include <time.h>
+#include <vector>
+
+static uint64_t monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int failures = 0;
+
+/**
+ * @brief Započte a vypíše nesoulad (nejvýše prvních 10)
+ */
+static void fail(const char *what, const std::string &input, const std::string &got, const std::string &expected)
+{
+    if (failures++ < 10)
+        fprintf(stderr, "CHYBA %s: vstup \"%s\" -> \"%s\", očekáváno \"%s\"\n",
+                what, input.c_str(), got.c_str(), expected.c_str());
+}
+
+/**
+ * @brief Zakóduje text pro formulář (nerezervované znaky přímo, mezera jako '+')
+ * @param upper Velká písmena v %XX
+ * @param all Zakódovat všechny bajty jako %XX
+ */
+static std::string encode(const std::string &text, bool upper, bool all)
+{
+    static const char *const digits[2] = {"0123456789abcdef", "0123456789ABCDEF"};
+    std::string out;
+    for (unsigned char c : text)
+    {
+        if (!all && (isalnum(c) || c == '-' || c == '_' || c == '.' || c == '~'))
+            out += (char)c;
+        else if (!all && c == ' ')
+            out += '+';
+        else
+        {
+            out += '%';
+            out += digits[upper][c >> 4];
+            out += digits[upper][c & 0x0F];
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Dekóduje řetězec funkcí urlDecode do std::string (včetně bajtů za %00)
+ */
+static std::string decode(const std::string &encoded)
+{
+    std::vector<char> buffer(encoded.size() + 1);
+    int length = urlDecode(encoded.c_str(), buffer.data(), (int)buffer.size());
+    return std::string(buffer.data(), length < 0 ? 0 : length);
+}
+
+/**
+ * @brief Referenční dekodér (přímočarý, bez tabulky)
+ */
+static std::string referenceDecode(const std::string &encoded)
+{
+    std::string out;
+    for (size_t i = 0; i < encoded.size(); i++)
+    {
+        char c = encoded[i];
+        if (c == '%' && i + 2 < encoded.size() &&
+            isxdigit((unsigned char)encoded[i + 1]) && isxdigit((unsigned char)encoded[i + 2]))
+        {
+            out += (char)strtol(encoded.substr(i + 1, 2).c_str(), nullptr, 16);
+            i += 2;
+        }
+        else
+            out += c == '+' ? ' ' : c;
+    }
+    return out;
+}
+
+/**
+ * @brief Původní dekodér z Utils.cpp (jen %2X a %3X), pro porovnání rychlosti
+ */
+static int legacyUrlDecode(const char *str, char *buffer, int bufferSize)
+{
+    if (!str || !buffer || bufferSize <= 0)
+        return -1;
+
+    int srcLen = strlen(str);
+    int destIndex = 0;
+
+    for (int i = 0; i < srcLen && destIndex < bufferSize - 1; i++)
+    {
+        if (str[i] == '+')
+        {
+            buffer[destIndex++] = ' ';
+        }
+        else if (str[i] == '%' && i + 2 < srcLen)
+        {
+            // Convert hex to number more efficiently
+            char c1 = str[i + 1];
+            char c2 = str[i + 2];
+
+            // Simple hex decode for most common cases
+            if (c1 == '2')
+            {
+                switch (c2)
+                {
+                case '0':
+                    buffer[destIndex++] = ' ';
+                    break;
+                case '1':
+                    buffer[destIndex++] = '!';
+                    break;
+                case '2':
+                    buffer[destIndex++] = '"';
+                    break;
+                case '3':
+                    buffer[destIndex++] = '#';
+                    break;
+                case '4':
+                    buffer[destIndex++] = '$';
+                    break;
+                case '5':
+                    buffer[destIndex++] = '%';
+                    break;
+                case '6':
+                    buffer[destIndex++] = '&';
+                    break;
+                case '7':
+                    buffer[destIndex++] = '\'';
+                    break;
+                case '8':
+                    buffer[destIndex++] = '(';
+                    break;
+                case '9':
+                    buffer[destIndex++] = ')';
+                    break;
+                case 'A':
+                case 'a':
+                    buffer[destIndex++] = '*';
+                    break;
+                case 'B':
+                case 'b':
+                    buffer[destIndex++] = '+';
+                    break;
+                case 'C':
+                case 'c':
+                    buffer[destIndex++] = ',';
+                    break;
+                case 'D':
+                case 'd':
+                    buffer[destIndex++] = '-';
+                    break;
+                case 'E':
+                case 'e':
+                    buffer[destIndex++] = '.';
+                    break;
+                case 'F':
+                case 'f':
+                    buffer[destIndex++] = '/';
+                    break;
+                default:
+                    buffer[destIndex++] = str[i];
+                    if (destIndex < bufferSize - 1)
+                        buffer[destIndex++] = c1;
+                    if (destIndex < bufferSize - 1)
+                        buffer[destIndex++] = c2;
+                    break;
+                }
+            }
+            else if (c1 == '3')
+            {
+                switch (c2)
+                {
+                case 'A':
+                case 'a':
+                    buffer[destIndex++] = ':';
+                    break;
+                case 'B':
+                case 'b':
+                    buffer[destIndex++] = ';';
+                    break;
+                case 'C':
+                case 'c':
+                    buffer[destIndex++] = '<';
+                    break;
+                case 'D':
+                case 'd':
+                    buffer[destIndex++] = '=';
+                    break;
+                case 'E':
+                case 'e':
+                    buffer[destIndex++] = '>';
+                    break;
+                case 'F':
+                case 'f':
+                    buffer[destIndex++] = '?';
+                    break;
+                default:
+                    buffer[destIndex++] = str[i];
+                    if (destIndex < bufferSize - 1)
+                        buffer[destIndex++] = c1;
+                    if (destIndex < bufferSize - 1)
+                        buffer[destIndex++] = c2;
+                    break;
+                }
+            }
+            else
+            {
+                // For other hex codes, just copy original characters
+                buffer[destIndex++] = str[i];
+                if (destIndex < bufferSize - 1)
+                    buffer[destIndex++] = c1;
+                if (destIndex < bufferSize - 1)
+                    buffer[destIndex++] = c2;
+            }
+            i += 2; // Skip the next two characters
+        }
+        else
+        {
+            buffer[destIndex++] = str[i];
+        }
+    }
+
+    buffer[destIndex] = '\0';
+    return destIndex;
+}
+
+static void checkSingleBytes()
+{
+    for (int b = 1; b < 256; b++)
+    {
+        std::string expected(1, (char)b);
+        for (int variant = 0; variant < 3; variant++)
+        {
+            std::string encoded = variant < 2 ? encode(expected, variant == 1, true) : expected;
+            if (variant == 2 && (b == '%' || b == '+'))
+                continue;
+            std::string got = decode(encoded);
+            if (got != expected)
+                fail("bajt", encoded, got, expected);
+        }
+    }
+
+    // %00 ukončí C-string, délka ho ale zahrnuje
+    if (decode("%00") != std::string(1, '\0'))
+        fail("bajt", "%00", decode("%00"), "\\0");
+}
+
+static void checkPairs()
+{
+    for (int a = 1; a < 256; a++)
+    {
+        for (int b = 1; b < 256; b++)
+        {
+            std::string text;
+            text += (char)a;
+            text += (char)b;
+            std::string encoded = encode(text, (a ^ b) & 1, false);
+            std::string got = decode(encoded);
+            if (got != text)
+                fail("dvojice", encoded, got, text);
+        }
+    }
+}
+
+static void checkEscapes()
+{
+    for (int x = 1; x < 256; x++)
+    {
+        for (int y = 1; y < 256; y++)
+        {
+            std::string encoded = "%";
+            encoded += (char)x;
+            encoded += (char)y;
+            std::string expected = referenceDecode(encoded);
+            std::string got = decode(encoded);
+            if (got != expected)
+                fail("sekvence", encoded, got, expected);
+
+            // Zkrácené sekvence na konci řetězce se ponechají beze změny
+            std::string shortened = encoded.substr(0, 2);
+            if (decode(shortened) != referenceDecode(shortened))
+                fail("konec", shortened, decode(shortened), referenceDecode(shortened));
+        }
+    }
+}
+
+/**
+ * @brief Náhodný text z bajtů, které se ve formulářích vyskytují i kolidují s oddělovači
+ */
+static std::string randomText(std::mt19937 &rng, size_t maxLength)
+{
+    static const char specials[] = "&=%+ ?#@_.-~/";
+    std::string text;
+    size_t length = rng() % (maxLength + 1);
+    for (size_t i = 0; i < length; i++)
+    {
+        switch (rng() % 4)
+        {
+        case 0:
+            text += specials[rng() % (sizeof(specials) - 1)];
+            break;
+        case 1:
+            text += (char)(0x80 + rng() % 0x80); // Bajty UTF-8 vícebajtových znaků
+            break;
+        default:
+            text += (char)('a' + rng() % 26);
+            break;
+        }
+    }
+    return text;
+}
+
+static void checkForms(uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    for (int round = 0; round < 20000; round++)
+    {
+        size_t count = 1 + rng() % httpMaxFormParams;
+        std::vector<std::string> keys, values;
+        std::string form;
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string key = "k" + std::to_string(i) + randomText(rng, 4);
+            std::string value = randomText(rng, 24);
+            keys.push_back(key);
+            values.push_back(value);
+            if (!form.empty())
+                form += rng() % 8 ? "&" : "&&"; // Občas prázdná dvojice
+            form += encode(key, rng() & 1, false);
+            if (!value.empty() || rng() & 1)
+                form += "=" + encode(value, rng() & 1, false);
+        }
+
+        std::vector<char> buffer(form.begin(), form.end());
+        buffer.push_back('\0');
+        FormParser params;
+        if (params.parse(buffer.data()) != count)
+            fail("formulář", form, std::to_string(params.getCount()), std::to_string(count));
+
+        // Dotazy v opačném pořadí, než jsou parametry ve formuláři
+        for (size_t i = count; i-- > 0;)
+        {
+            const char *got = params.get(keys[i].c_str());
+            if (!got || values[i] != got)
+                fail("parametr", form, got ? got : "(chybí)", values[i]);
+        }
+        if (params.get("neexistuje"))
+            fail("parametr", form, params.get("neexistuje"), "(chybí)");
+    }
+}
+
+static void checkInPlace()
+{
+    static const char *const samples[] = {"Moje+s%C3%AD%C5%A5", "a%40b%5Fc", "%zz%4", "100%25", "+%2B+", ""};
+    for (const char *sample : samples)
+    {
+        std::vector<char> buffer(sample, sample + strlen(sample) + 1);
+        urlDecode(buffer.data(), buffer.data(), (int)buffer.size());
+        std::string expected = decode(sample);
+        if (expected != buffer.data())
+            fail("na místě", sample, buffer.data(), expected);
+    }
+}
+
+/**
+ * @brief Nejlepší doba z repeat opakování v ns na jedno volání fn
+ */
+template <class Fn>
+static double bestNs(int repeat, int iterations, Fn fn)
+{
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < repeat; r++)
+    {
+        uint64_t start = monotonicNs();
+        for (int i = 0; i < iterations; i++)
+            fn();
+        uint64_t elapsed = monotonicNs() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    return (double)best / iterations;
+}
+
+static volatile int sink; // Výsledky měřených funkcí, aby je překladač nevypustil
+
+static void benchmark(int repeat)
+{
+    const char *forms[] = {
+        "input1=DomaciSit&input2=heslo12345",
+        "input1=Moje+s%C3%AD%C5%A5+%F0%9F%93%B6&input2=p%40ss%2Fw%3Ard%21",
+    };
+    static const int iterations = 200000;
+
+    printf("%-44s %12s %12s\n", "formulář", "původní ns", "nový ns");
+    for (const char *form : forms)
+    {
+        size_t length = strlen(form);
+        char buffer[httpBodyBytes];
+
+        double legacyDecode = bestNs(repeat, iterations, [&]() {
+            sink += legacyUrlDecode(form, buffer, sizeof(buffer));
+        });
+        double newDecode = bestNs(repeat, iterations, [&]() {
+            sink += urlDecode(form, buffer, sizeof(buffer));
+        });
+
+        // Původní handleWiFiConfig: strstr, dvě kopie do pomocných bufferů a dekódování
+        double legacyForm = bestNs(repeat, iterations, [&]() {
+            const char *ssidStart = strstr(form, "input1=");
+            const char *passStart = strstr(form, "&input2=");
+            const char *passEnd = passStart ? passStart + 8 + strcspn(passStart + 8, " &") : nullptr;
+            char tempSSID[32], tempPass[32], ssid[32], pass[32];
+            int ssidLen = min(passStart - ssidStart - 7, (long)sizeof(tempSSID) - 1);
+            int passLen = min(passEnd - passStart - 8, (long)sizeof(tempPass) - 1);
+            strncpy(tempSSID, ssidStart + 7, ssidLen);
+            tempSSID[ssidLen] = '\0';
+            strncpy(tempPass, passStart + 8, passLen);
+            tempPass[passLen] = '\0';
+            sink += legacyUrlDecode(tempSSID, ssid, sizeof(ssid)) + legacyUrlDecode(tempPass, pass, sizeof(pass));
+        });
+        double newForm = bestNs(repeat, iterations, [&]() {
+            memcpy(buffer, form, length + 1); // Parser přepisuje vstup, kopie jen kvůli opakování
+            FormParser params;
+            params.parse(buffer);
+            sink += params.get("input1")[0] + params.get("input2")[0];
+        });
+
+        printf("%-44.44s\n", form);
+        printf("  %-42s %12.1f %12.1f\n", "urlDecode (celý řetězec)", legacyDecode, newDecode);
+        printf("  %-42s %12.1f %12.1f\n", "rozklad input1/input2", legacyForm, newForm);
+    }
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr, "Použití: %s [--repeat K] [--seed N]\n", name);
+}
+
+int main(int argc, char **argv)
+{
+    int repeat = 5;
+    uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--repeat") && hasValue)
+            repeat = max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+            seed = strtoul(argv[++i], nullptr, 10);
+        else
+        {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    checkSingleBytes();
+    checkPairs();
+    checkEscapes();
+    checkInPlace();
+    checkForms(seed);
+    if (failures > 0)
+    {
+        printf("Kontroly: %d chyb\n", failures);
+        return 1;
+    }
+    printf("Kontroly: bajty, dvojice, sekvence %%XY, dekódování na místě a formuláře v pořádku\n\n");
+
+    benchmark(repeat);
+    return 0;
+}
@@ -0,0 +1,165 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/**
+ * @file Arduino.h
+ * @brief Tenká náhrada jádra Arduino pro překlad firmwaru na PC (Linux)
+ *
+ * Obsahuje jen to, co sketch skutečně používá: čas, piny, analogRead, Print,
+ * Stream a Serial. Chování se řídí přes HostHAL.h.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define F_CPU 16000000UL
+
+#define PROGMEM
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+class __FlashStringHelper;
+
+template <class A, class B>
+auto min(A a, B b) -> decltype(a + b) { return a < b ? a : b; }
+template <class A, class B>
+auto max(A a, B b) -> decltype(a + b) { return a > b ? a : b; }
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+inline void noInterrupts() {}
+inline void interrupts() {}
+inline void cli() {}
+inline void sei() {}
+
+class Print;
+
+/**
+ * @class Printable
+ * @brief Objekt, který se umí vypsat do Print (např. IPAddress)
+ */
+class Printable
+{
+public:
+    virtual ~Printable() {}
+    virtual size_t printTo(Print &p) const = 0;
+};
+
+/**
+ * @class Print
+ * @brief Formátovaný výstup nad write() jako v jádře Arduino
+ */
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str) { return str ? write((const uint8_t *)str, strlen(str)) : 0; }
+    virtual int availableForWrite() { return 0; }
+    virtual void flush() {}
+
+    size_t print(const __FlashStringHelper *str);
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(unsigned char value, int base = DEC);
+    size_t print(int value, int base = DEC);
+    size_t print(unsigned int value, int base = DEC);
+    size_t print(long value, int base = DEC);
+    size_t print(unsigned long value, int base = DEC);
+    size_t print(double value, int digits = 2);
+    size_t print(const Printable &value);
+
+    size_t println();
+    template <class T>
+    size_t println(T value)
+    {
+        size_t n = print(value);
+        return n + println();
+    }
+    template <class T>
+    size_t println(T value, int format)
+    {
+        size_t n = print(value, format);
+        return n + println();
+    }
+};
+
+/**
+ * @class Stream
+ * @brief Vstupní proud s časovým limitem pro blokující čtení
+ */
+class Stream : public Print
+{
+protected:
+    unsigned long timeout = 1000; // Limit blokujícího čtení v ms
+
+    int timedRead();
+
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+
+    void setTimeout(unsigned long ms) { timeout = ms; }
+    size_t readBytes(char *buffer, size_t length);
+    size_t readBytesUntil(char terminator, char *buffer, size_t length);
+};
+
+/**
+ * @class HardwareSerial
+ * @brief Serial linka vypisovaná na stdout, vstup ze stdin (neblokující)
+ */
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    explicit operator bool() const { return true; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override { return 64; }
+    void flush() override;
+    int available() override;
+    int read() override;
+    int peek() override;
+};
+
+extern HardwareSerial Serial;
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,22 @@
+#ifndef HOST_EEPROM_H
+#define HOST_EEPROM_H
+
+#include <stdint.h>
+
+/**
+ * @class EEPROMClass
+ * @brief EEPROM o velikosti ATmega4809 (256 B), volitelně uložená v souboru
+ */
+class EEPROMClass
+{
+public:
+    void begin() {}
+    uint8_t read(int address);
+    void write(int address, uint8_t value);
+    void update(int address, uint8_t value);
+    uint16_t length() const;
+};
+
+extern EEPROMClass EEPROM;
+
+#endif // HOST_EEPROM_H
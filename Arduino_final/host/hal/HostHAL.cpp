@@ -0,0 +1,469 @@
+#include "HostHAL.h"
+#include <EEPROM.h>
+#include <Wire.h>
+#include <avr/wdt.h>
+#include <poll.h>
+#include <time.h>
+#include <unistd.h>
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+TwoWire Wire;
+
+static const uint8_t hostPinCount = 32;      // Počet emulovaných pinů
+static const uint16_t hostEEPROMSize = 256;  // Velikost EEPROM ATmega4809
+
+/**
+ * @brief Záznam přehrávaný na analogový pin
+ */
+struct AnalogFeed
+{
+    const int16_t *samples;
+    size_t count;
+    uint32_t sampleRateHz;
+    bool loop;
+    uint32_t startUs;
+    bool finished;
+};
+
+static bool simulatedTime = false;
+static uint64_t simulatedUs = 0;
+static uint64_t clockOriginNs = 0;
+static int pinLevels[hostPinCount];
+static bool pinLevelsReady = false;
+static AnalogFeed feeds[hostPinCount];
+static uint8_t eepromData[hostEEPROMSize];
+static bool eepromReady = false;
+static char eepromPath[256] = "";
+static int savedArgc = 0;
+static char **savedArgv = nullptr;
+
+/**
+ * @brief Monotónní čas systému v ns
+ */
+static uint64_t monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Aktuální čas od startu v µs (64 bitů, ořez na 32 bitů dělá micros)
+ */
+static uint64_t nowUs()
+{
+    if (simulatedTime)
+        return simulatedUs;
+    if (clockOriginNs == 0)
+        clockOriginNs = monotonicNs();
+    return (monotonicNs() - clockOriginNs) / 1000;
+}
+
+void hostUseSimulatedTime(bool enabled)
+{
+    if (enabled && !simulatedTime)
+        simulatedUs = nowUs();
+    simulatedTime = enabled;
+}
+
+void hostAdvanceMicros(unsigned long us)
+{
+    simulatedUs += us;
+}
+
+// Stejně jako na AVR je unsigned long 32bitový, přetečení se tedy projeví i na PC
+unsigned long millis()
+{
+    return (uint32_t)(nowUs() / 1000);
+}
+
+unsigned long micros()
+{
+    return (uint32_t)nowUs();
+}
+
+void delay(unsigned long ms)
+{
+    delayMicroseconds(0);
+    if (simulatedTime)
+    {
+        simulatedUs += (uint64_t)ms * 1000;
+        return;
+    }
+    usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    if (simulatedTime)
+    {
+        simulatedUs += us;
+        return;
+    }
+    if (us)
+        usleep(us);
+}
+
+/**
+ * @brief Výchozí stav pinů: vstupy s pull-up čtou HIGH (tlačítka nestisknuta)
+ */
+static void initPins()
+{
+    if (pinLevelsReady)
+        return;
+    for (uint8_t i = 0; i < hostPinCount; i++)
+        pinLevels[i] = HIGH;
+    pinLevelsReady = true;
+}
+
+void hostSetPin(uint8_t pin, int level)
+{
+    initPins();
+    if (pin < hostPinCount)
+        pinLevels[pin] = level;
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    hostSetPin(pin, value);
+}
+
+int digitalRead(uint8_t pin)
+{
+    initPins();
+    return pin < hostPinCount ? pinLevels[pin] : LOW;
+}
+
+void hostSetAnalogFeed(uint8_t pin, const int16_t *samples, size_t count, uint32_t sampleRateHz, bool loop)
+{
+    if (pin >= hostPinCount)
+        return;
+    AnalogFeed &feed = feeds[pin];
+    feed.samples = samples;
+    feed.count = count;
+    feed.sampleRateHz = sampleRateHz ? sampleRateHz : 1;
+    feed.loop = loop;
+    feed.startUs = micros();
+    feed.finished = count == 0;
+}
+
+bool hostAnalogFeedFinished(uint8_t pin)
+{
+    return pin >= hostPinCount || !feeds[pin].samples || feeds[pin].finished;
+}
+
+/**
+ * @brief Vrací hodnotu záznamu v aktuálním čase (lineární interpolace mezi vzorky)
+ */
+int analogRead(uint8_t pin)
+{
+    if (pin >= hostPinCount || !feeds[pin].samples || feeds[pin].count == 0)
+        return 0;
+
+    AnalogFeed &feed = feeds[pin];
+    uint64_t scaled = (uint64_t)(uint32_t)(micros() - feed.startUs) * feed.sampleRateHz;
+    size_t index = (size_t)(scaled / 1000000);
+    uint32_t fraction = (uint32_t)(scaled % 1000000);
+
+    if (index + 1 >= feed.count)
+    {
+        if (!feed.loop)
+        {
+            feed.finished = true;
+            return feed.samples[feed.count - 1];
+        }
+        index %= feed.count;
+    }
+
+    int a = feed.samples[index];
+    int b = feed.samples[(index + 1) % feed.count];
+    return a + (int)((int64_t)(b - a) * fraction / 1000000);
+}
+
+/**
+ * @brief Načte EEPROM ze souboru při prvním přístupu (smazaná EEPROM = 0xFF)
+ */
+static void loadEEPROM()
+{
+    if (eepromReady)
+        return;
+    memset(eepromData, 0xFF, sizeof(eepromData));
+    if (eepromPath[0])
+    {
+        FILE *file = fopen(eepromPath, "rb");
+        if (file)
+        {
+            size_t n = fread(eepromData, 1, sizeof(eepromData), file);
+            (void)n;
+            fclose(file);
+        }
+    }
+    eepromReady = true;
+}
+
+/**
+ * @brief Zapíše obsah EEPROM do souboru (zápisy jsou vzácné, stačí celý obraz)
+ */
+static void storeEEPROM()
+{
+    if (!eepromPath[0])
+        return;
+    FILE *file = fopen(eepromPath, "wb");
+    if (!file)
+        return;
+    fwrite(eepromData, 1, sizeof(eepromData), file);
+    fclose(file);
+}
+
+void hostSetEEPROMFile(const char *path)
+{
+    snprintf(eepromPath, sizeof(eepromPath), "%s", path ? path : "");
+    eepromReady = false;
+    loadEEPROM();
+}
+
+uint8_t EEPROMClass::read(int address)
+{
+    loadEEPROM();
+    return (address >= 0 && address < hostEEPROMSize) ? eepromData[address] : 0xFF;
+}
+
+void EEPROMClass::write(int address, uint8_t value)
+{
+    loadEEPROM();
+    if (address < 0 || address >= hostEEPROMSize)
+        return;
+    eepromData[address] = value;
+    storeEEPROM();
+}
+
+void EEPROMClass::update(int address, uint8_t value)
+{
+    if (read(address) != value)
+        write(address, value);
+}
+
+uint16_t EEPROMClass::length() const
+{
+    return hostEEPROMSize;
+}
+
+void hostSetArgs(int argc, char **argv)
+{
+    savedArgc = argc;
+    savedArgv = argv;
+}
+
+void wdt_disable()
+{
+}
+
+/**
+ * @brief Zapnutý watchdog firmware používá jen k restartu, na PC se proces spustí znovu
+ */
+void wdt_enable(int timeout)
+{
+    Serial.flush();
+    if (savedArgv)
+        execv("/proc/self/exe", savedArgv);
+    exit(0);
+}
+
+size_t hostLoadCsv(const char *path, int16_t **samples, uint32_t *sampleRateHz)
+{
+    FILE *file = fopen(path, "r");
+    if (!file)
+        return 0;
+
+    size_t capacity = 1024, count = 0;
+    int16_t *data = (int16_t *)malloc(capacity * sizeof(int16_t));
+    double firstTime = 0, lastTime = 0;
+    char line[128];
+
+    while (data && fgets(line, sizeof(line), file))
+    {
+        double timestamp, value;
+        // Hlavička a prázdné řádky se neparsují a přeskočí
+        if (sscanf(line, "%lf,%lf", &timestamp, &value) != 2)
+            continue;
+        if (count == capacity)
+        {
+            capacity *= 2;
+            int16_t *grown = (int16_t *)realloc(data, capacity * sizeof(int16_t));
+            if (!grown)
+                break;
+            data = grown;
+        }
+        if (count == 0)
+            firstTime = timestamp;
+        lastTime = timestamp;
+        data[count++] = (int16_t)constrain(value, 0.0, 1023.0);
+    }
+    fclose(file);
+
+    if (count < 2)
+    {
+        free(data);
+        return 0;
+    }
+
+    *samples = data;
+    *sampleRateHz = lastTime > firstTime ? (uint32_t)((count - 1) / (lastTime - firstTime) + 0.5) : 100;
+    return count;
+}
+
+/* ---------------- Print / Stream ---------------- */
+
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+        n += write(*buffer++);
+    return n;
+}
+
+size_t Print::print(const __FlashStringHelper *str)
+{
+    return write(reinterpret_cast<const char *>(str));
+}
+
+size_t Print::print(const char *str)
+{
+    return write(str);
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char value, int base)
+{
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(int value, int base)
+{
+    return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base)
+{
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(long value, int base)
+{
+    if (base == DEC && value < 0)
+        return print('-') + print((unsigned long)-value, base);
+    return print((unsigned long)value, base);
+}
+
+size_t Print::print(unsigned long value, int base)
+{
+    char buffer[24];
+    snprintf(buffer, sizeof(buffer), base == HEX ? "%lX" : "%lu", value);
+    return write(buffer);
+}
+
+size_t Print::print(double value, int digits)
+{
+    char buffer[40];
+    snprintf(buffer, sizeof(buffer), "%.*f", digits, value);
+    return write(buffer);
+}
+
+size_t Print::print(const Printable &value)
+{
+    return value.printTo(*this);
+}
+
+size_t Print::println()
+{
+    return write("\r\n");
+}
+
+int Stream::timedRead()
+{
+    unsigned long start = millis();
+    do
+    {
+        int c = read();
+        if (c >= 0)
+            return c;
+        if (available() == 0)
+            delay(1);
+    } while (millis() - start < timeout);
+    return -1;
+}
+
+size_t Stream::readBytes(char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        int c = timedRead();
+        if (c < 0)
+            break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
+{
+    size_t count = 0;
+    while (count < length)
+    {
+        int c = timedRead();
+        if (c < 0 || c == terminator)
+            break;
+        buffer[count++] = (char)c;
+    }
+    return count;
+}
+
+/* ---------------- Serial ---------------- */
+
+void HardwareSerial::begin(unsigned long baud)
+{
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    return fputc(c, stdout) == EOF ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    return fwrite(buffer, 1, size, stdout);
+}
+
+void HardwareSerial::flush()
+{
+    fflush(stdout);
+}
+
+int HardwareSerial::available()
+{
+    struct pollfd pfd = {STDIN_FILENO, POLLIN, 0};
+    return poll(&pfd, 1, 0) > 0 && (pfd.revents & POLLIN) ? 1 : 0;
+}
+
+int HardwareSerial::read()
+{
+    if (!available())
+        return -1;
+    unsigned char c;
+    return ::read(STDIN_FILENO, &c, 1) == 1 ? c : -1;
+}
+
+int HardwareSerial::peek()
+{
+    return -1;
+}
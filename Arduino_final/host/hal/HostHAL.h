@@ -0,0 +1,86 @@
+#ifndef HOST_HAL_H
+#define HOST_HAL_H
+
+#include <Arduino.h>
+
+/**
+ * @file HostHAL.h
+ * @brief Ovládání náhradního HAL z nástrojů běžících na PC
+ */
+
+/**
+ * @brief Přepne čas na simulovaný (millis/micros se posouvají jen ručně a v delay)
+ * @param enabled True pro simulovaný čas, false pro monotónní hodiny systému
+ */
+void hostUseSimulatedTime(bool enabled);
+
+/**
+ * @brief Posune simulovaný čas
+ * @param us Posun v µs
+ */
+void hostAdvanceMicros(unsigned long us);
+
+/**
+ * @brief Nastaví úroveň vstupního pinu vracenou z digitalRead
+ * @param pin Arduino pin
+ * @param level HIGH nebo LOW
+ */
+void hostSetPin(uint8_t pin, int level);
+
+/**
+ * @brief Připojí k analogovému pinu záznam, přehrávaný podle micros()
+ * @param pin Arduino pin
+ * @param samples Vzorky ADC (pole musí zůstat platné)
+ * @param count Počet vzorků
+ * @param sampleRateHz Vzorkovací frekvence záznamu (mezi vzorky se interpoluje)
+ * @param loop True pokud se má záznam opakovat dokola
+ */
+void hostSetAnalogFeed(uint8_t pin, const int16_t *samples, size_t count, uint32_t sampleRateHz, bool loop);
+
+/**
+ * @brief Vrací true, pokud záznam na pinu už doběhl do konce (bez opakování)
+ * @param pin Arduino pin
+ */
+bool hostAnalogFeedFinished(uint8_t pin);
+
+/**
+ * @brief Uloží EEPROM do souboru a načte ji z něj (neexistující soubor = smazaná EEPROM)
+ * @param path Cesta k souboru nebo nullptr pro EEPROM jen v paměti
+ */
+void hostSetEEPROMFile(const char *path);
+
+/**
+ * @brief Posune čísla všech portů WiFiServer (např. 80 -> 8080 bez práv roota)
+ * @param offset Posun portu
+ */
+void hostSetPortOffset(uint16_t offset);
+
+/**
+ * @brief Nastaví, za jak dlouho a s jakým výsledkem WiFi.begin dokončí připojení
+ * @param connectMs Doba připojování (do té doby modul hlásí WL_IDLE_STATUS)
+ * @param result Výsledný stav (WL_CONNECTED, WL_CONNECT_FAILED, WL_NO_SSID_AVAIL)
+ */
+void hostSetWiFiLink(unsigned long connectMs, uint8_t result);
+
+/**
+ * @brief Naplánuje výpadek přístupového bodu (modul zahodí spojení a WiFi.begin do konce výpadku selhává)
+ * @param atMs Začátek výpadku (millis)
+ * @param durationMs Délka výpadku (0 = bez výpadku)
+ */
+void hostSetWiFiOutage(unsigned long atMs, unsigned long durationMs);
+
+/**
+ * @brief Uloží argumenty procesu pro restart přes watchdog (execv)
+ */
+void hostSetArgs(int argc, char **argv);
+
+/**
+ * @brief Načte CSV záznam (sloupce čas v s, hodnota ADC) z EMG_elektrody_test/data
+ * @param path Cesta k souboru
+ * @param samples Výstupní pole (alokuje se přes malloc, uvolnit free)
+ * @param sampleRateHz Vzorkovací frekvence odvozená z časových značek
+ * @return Počet vzorků, 0 při chybě
+ */
+size_t hostLoadCsv(const char *path, int16_t **samples, uint32_t *sampleRateHz);
+
+#endif // HOST_HAL_H
@@ -0,0 +1,561 @@
+#include "HostHAL.h"
+#include <WiFiNINA.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <signal.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+WiFiClass WiFi;
+
+/**
+ * @brief Jeden socket tabulky (obdoba socketu modulu NINA)
+ */
+struct HostSocket
+{
+    int fd;          // Deskriptor nebo -1 pro volný slot
+    uint16_t server; // Port serveru, který spojení přijal (0 = odchozí)
+};
+
+static HostSocket sockets[hostMaxSockets];
+static bool socketsReady = false;
+static uint8_t wifiStatus = WL_IDLE_STATUS;
+static uint16_t portOffset = 0;
+static unsigned long wifiConnectMs = 0;      // Doba připojování (--wifi-ms)
+static uint8_t wifiResult = WL_CONNECTED;    // Výsledek připojení (--wifi-result)
+static unsigned long wifiBeginMs = 0;        // Čas volání WiFi.begin
+static bool wifiPending = false;             // Připojování ještě neskončilo
+static unsigned long wifiLibTimeout = 50000; // Čekání uvnitř WiFi.begin (setTimeout, výchozí jako WiFiNINA)
+static unsigned long outageAtMs = 0;         // Začátek výpadku AP (--wifi-outage)
+static unsigned long outageMs = 0;           // Délka výpadku AP (0 = bez výpadku)
+static bool outageStarted = false;           // Výpadek už nastal
+
+/**
+ * @brief Inicializuje tabulku socketů, zápis do zavřeného spojení nesmí ukončit proces
+ */
+static void initSockets()
+{
+    if (socketsReady)
+        return;
+    for (uint8_t i = 0; i < hostMaxSockets; i++)
+        sockets[i].fd = -1;
+    signal(SIGPIPE, SIG_IGN);
+    socketsReady = true;
+}
+
+/**
+ * @brief Uloží deskriptor do volného slotu
+ * @return Index slotu nebo hostNoSocket, pokud je tabulka plná
+ */
+static uint8_t allocSocket(int fd, uint16_t server)
+{
+    initSockets();
+    for (uint8_t i = 0; i < hostMaxSockets; i++)
+    {
+        if (sockets[i].fd < 0)
+        {
+            int flag = 1;
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+            sockets[i].fd = fd;
+            sockets[i].server = server;
+            return i;
+        }
+    }
+    close(fd);
+    return hostNoSocket;
+}
+
+static int socketFd(uint8_t sock)
+{
+    return (socketsReady && sock < hostMaxSockets) ? sockets[sock].fd : -1;
+}
+
+void hostSetPortOffset(uint16_t offset)
+{
+    portOffset = offset;
+}
+
+void hostSetWiFiLink(unsigned long connectMs, uint8_t result)
+{
+    wifiConnectMs = connectMs;
+    wifiResult = result;
+}
+
+void hostSetWiFiOutage(unsigned long atMs, unsigned long durationMs)
+{
+    outageAtMs = atMs;
+    outageMs = durationMs;
+    outageStarted = false;
+}
+
+/**
+ * @brief Vrací true, pokud naplánovaný výpadek AP právě probíhá
+ */
+static bool inOutage()
+{
+    return outageStarted && millis() - outageAtMs < outageMs;
+}
+
+/**
+ * @brief Zahájí výpadek: modul ztratí spojení a všechna spojení se ukončí
+ */
+static void startOutage()
+{
+    outageStarted = true;
+    wifiPending = false;
+    wifiStatus = WL_CONNECTION_LOST;
+    for (uint8_t i = 0; socketsReady && i < hostMaxSockets; i++)
+    {
+        if (sockets[i].fd >= 0)
+            shutdown(sockets[i].fd, SHUT_RDWR);
+    }
+}
+
+/* ---------------- IPAddress ---------------- */
+
+IPAddress::IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d)
+{
+    bytes[0] = a;
+    bytes[1] = b;
+    bytes[2] = c;
+    bytes[3] = d;
+}
+
+size_t IPAddress::printTo(Print &p) const
+{
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", bytes[0], bytes[1], bytes[2], bytes[3]);
+    return p.print(buffer);
+}
+
+/* ---------------- WiFiClient ---------------- */
+
+WiFiClient::WiFiClient() : sock(hostNoSocket)
+{
+}
+
+WiFiClient::WiFiClient(uint8_t sock) : sock(sock)
+{
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+    stop();
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1)
+        return 0;
+
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return 0;
+    if (::connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        close(fd);
+        return 0;
+    }
+    sock = allocSocket(fd, 0);
+    return sock != hostNoSocket;
+}
+
+/**
+ * @brief Spojení trvá, dokud protistrana nezavřela socket nebo jsou nepřečtená data
+ */
+uint8_t WiFiClient::connected()
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return 0;
+
+    char c;
+    ssize_t n = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (n > 0)
+        return 1;
+    if (n == 0)
+        return 0;
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? 1 : 0;
+}
+
+void WiFiClient::stop()
+{
+    int fd = socketFd(sock);
+    if (fd >= 0)
+    {
+        close(fd);
+        sockets[sock].fd = -1;
+    }
+    sock = hostNoSocket;
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+/**
+ * @brief Zápis jako u modulu NINA: data se předají celá, nebo se spojení považuje za chybné
+ */
+size_t WiFiClient::write(const uint8_t *buffer, size_t size)
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return 0;
+
+    size_t sent = 0;
+    unsigned long start = millis();
+    while (sent < size)
+    {
+        ssize_t n = send(fd, buffer + sent, size - sent, MSG_NOSIGNAL);
+        if (n > 0)
+        {
+            sent += n;
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) && millis() - start < timeout)
+        {
+            usleep(100);
+            continue;
+        }
+        break;
+    }
+    return sent;
+}
+
+int WiFiClient::availableForWrite()
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return 0;
+    int queued = 0, capacity = 0;
+    socklen_t len = sizeof(capacity);
+    ioctl(fd, TIOCOUTQ, &queued);
+    getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &capacity, &len);
+    return capacity > queued ? capacity - queued : 0;
+}
+
+int WiFiClient::available()
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return 0;
+    int count = 0;
+    return ioctl(fd, FIONREAD, &count) == 0 ? count : 0;
+}
+
+int WiFiClient::read()
+{
+    uint8_t c;
+    return read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return -1;
+    ssize_t n = recv(fd, buffer, size, MSG_DONTWAIT);
+    return n > 0 ? (int)n : -1;
+}
+
+int WiFiClient::peek()
+{
+    int fd = socketFd(sock);
+    if (fd < 0)
+        return -1;
+    uint8_t c;
+    return recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT) == 1 ? c : -1;
+}
+
+IPAddress WiFiClient::remoteIP()
+{
+    struct sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    int fd = socketFd(sock);
+    if (fd < 0 || getpeername(fd, (struct sockaddr *)&addr, &len) < 0)
+        return IPAddress();
+    uint32_t ip = ntohl(addr.sin_addr.s_addr);
+    return IPAddress(ip >> 24, ip >> 16, ip >> 8, ip);
+}
+
+uint16_t WiFiClient::remotePort()
+{
+    struct sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    int fd = socketFd(sock);
+    if (fd < 0 || getpeername(fd, (struct sockaddr *)&addr, &len) < 0)
+        return 0;
+    return ntohs(addr.sin_port);
+}
+
+/* ---------------- WiFiServer ---------------- */
+
+WiFiServer::WiFiServer(uint16_t port) : port(port)
+{
+}
+
+void WiFiServer::begin()
+{
+    if (listenFd >= 0)
+        return;
+
+    // Restart (execv ve wdt_enable) nesmí zdědit naslouchající socket
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return;
+
+    int flag = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &flag, sizeof(flag));
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port + portOffset);
+    if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, 4) < 0)
+    {
+        fprintf(stderr, "WiFiServer: port %u: %s\n", port + portOffset, strerror(errno));
+        close(fd);
+        return;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    listenFd = fd;
+}
+
+/**
+ * @brief Přijme čekající spojení do tabulky socketů
+ */
+void WiFiServer::acceptPending()
+{
+    if (listenFd < 0)
+        return;
+    int fd;
+    while ((fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+        allocSocket(fd, port);
+}
+
+/**
+ * @brief Vrací klienta tohoto serveru, který má data ke čtení (sémantika WiFiNINA)
+ */
+WiFiClient WiFiServer::available()
+{
+    acceptPending();
+    for (uint8_t i = 0; i < hostMaxSockets; i++)
+    {
+        if (sockets[i].fd < 0 || sockets[i].server != port)
+            continue;
+        WiFiClient client(i);
+        if (client.available() > 0)
+            return client;
+    }
+    return WiFiClient();
+}
+
+/**
+ * @brief Vrací nově přijaté spojení bez ohledu na data (sémantika WiFiNINA accept)
+ */
+WiFiClient WiFiServer::accept()
+{
+    if (listenFd < 0)
+        return WiFiClient();
+    int fd = ::accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0)
+        return WiFiClient();
+    uint8_t sock = allocSocket(fd, port);
+    return sock == hostNoSocket ? WiFiClient() : WiFiClient(sock);
+}
+
+/* ---------------- WiFiUDP ---------------- */
+
+uint8_t WiFiUDP::begin(uint16_t port)
+{
+    stop();
+
+    int sock = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (sock < 0)
+        return 0;
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(port + portOffset);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        fprintf(stderr, "WiFiUDP: port %u: %s\n", port + portOffset, strerror(errno));
+        close(sock);
+        return 0;
+    }
+    fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    fd = sock;
+    return 1;
+}
+
+void WiFiUDP::stop()
+{
+    if (fd >= 0)
+        close(fd);
+    fd = -1;
+    txLength = rxLength = rxPosition = 0;
+}
+
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    if (fd < 0)
+        return 0;
+    txAddress = ((uint32_t)ip[0] << 24) | ((uint32_t)ip[1] << 16) | ((uint32_t)ip[2] << 8) | ip[3];
+    txPort = port;
+    txLength = 0;
+    return 1;
+}
+
+int WiFiUDP::endPacket()
+{
+    if (fd < 0)
+        return 0;
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(txAddress);
+    addr.sin_port = htons(txPort);
+    ssize_t sent = sendto(fd, txPacket, txLength, 0, (struct sockaddr *)&addr, sizeof(addr));
+    txLength = 0;
+    return sent >= 0 ? 1 : 0;
+}
+
+int WiFiUDP::parsePacket()
+{
+    if (fd < 0)
+        return 0;
+
+    struct sockaddr_in addr = {};
+    socklen_t len = sizeof(addr);
+    ssize_t received = recvfrom(fd, rxPacket, sizeof(rxPacket), 0, (struct sockaddr *)&addr, &len);
+    if (received <= 0)
+        return 0;
+    rxLength = received;
+    rxPosition = 0;
+    rxAddress = ntohl(addr.sin_addr.s_addr);
+    rxPort = ntohs(addr.sin_port);
+    return received;
+}
+
+size_t WiFiUDP::write(uint8_t c)
+{
+    return write(&c, 1);
+}
+
+size_t WiFiUDP::write(const uint8_t *buffer, size_t size)
+{
+    if (size > sizeof(txPacket) - txLength)
+        size = sizeof(txPacket) - txLength;
+    memcpy(txPacket + txLength, buffer, size);
+    txLength += size;
+    return size;
+}
+
+int WiFiUDP::available()
+{
+    return rxLength - rxPosition;
+}
+
+int WiFiUDP::read()
+{
+    return rxPosition < rxLength ? rxPacket[rxPosition++] : -1;
+}
+
+int WiFiUDP::read(uint8_t *buffer, size_t size)
+{
+    size_t count = rxLength - rxPosition < size ? rxLength - rxPosition : size;
+    memcpy(buffer, rxPacket + rxPosition, count);
+    rxPosition += count;
+    return count;
+}
+
+int WiFiUDP::peek()
+{
+    return rxPosition < rxLength ? rxPacket[rxPosition] : -1;
+}
+
+IPAddress WiFiUDP::remoteIP()
+{
+    return IPAddress(rxAddress >> 24, rxAddress >> 16, rxAddress >> 8, rxAddress);
+}
+
+uint16_t WiFiUDP::remotePort()
+{
+    return rxPort;
+}
+
+/* ---------------- WiFiClass ---------------- */
+
+uint8_t WiFiClass::status()
+{
+    if (outageMs > 0 && !outageStarted && wifiStatus == WL_CONNECTED && millis() >= outageAtMs)
+        startOutage();
+    if (wifiPending && millis() - wifiBeginMs >= wifiConnectMs)
+    {
+        wifiStatus = inOutage() ? WL_NO_SSID_AVAIL : wifiResult;
+        wifiPending = false;
+    }
+    return wifiStatus;
+}
+
+/**
+ * @brief Připojení skončí po --wifi-ms s výsledkem --wifi-result, prázdné SSID vždy selže
+ *
+ * Stejně jako WiFiNINA čeká uvnitř na výsledek nejvýše setTimeout ms.
+ */
+int WiFiClass::begin(const char *ssid, const char *pass)
+{
+    if (!ssid || !ssid[0])
+    {
+        wifiPending = false;
+        wifiStatus = WL_CONNECT_FAILED;
+        return wifiStatus;
+    }
+
+    wifiStatus = WL_IDLE_STATUS;
+    wifiBeginMs = millis();
+    wifiPending = true;
+    while (wifiPending && millis() - wifiBeginMs < wifiLibTimeout)
+    {
+        if (status() != WL_IDLE_STATUS)
+            break;
+        delay(100);
+    }
+    return wifiStatus;
+}
+
+uint8_t WiFiClass::beginAP(const char *ssid, const char *pass)
+{
+    wifiPending = false;
+    wifiStatus = WL_AP_LISTENING;
+    return wifiStatus;
+}
+
+int WiFiClass::disconnect()
+{
+    wifiPending = false;
+    wifiStatus = WL_DISCONNECTED;
+    return wifiStatus;
+}
+
+IPAddress WiFiClass::localIP()
+{
+    return IPAddress(127, 0, 0, 1);
+}
+
+void WiFiClass::setTimeout(unsigned long ms)
+{
+    wifiLibTimeout = ms;
+}
+
+int32_t WiFiClass::RSSI()
+{
+    return wifiStatus == WL_CONNECTED ? -50 : 0;
+}
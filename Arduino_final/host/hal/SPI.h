@@ -0,0 +1,6 @@
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+// Sketch SPI přímo nepoužívá, hlavička je potřeba jen kvůli #include
+
+#endif // HOST_SPI_H
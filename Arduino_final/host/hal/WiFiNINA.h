@@ -0,0 +1,158 @@
+#ifndef HOST_WIFININA_H
+#define HOST_WIFININA_H
+
+/**
+ * @file WiFiNINA.h
+ * @brief WiFiNINA nad POSIX sockety pro překlad firmwaru na PC
+ *
+ * Klienti jsou jako u modulu NINA jen indexy do tabulky socketů, kopie objektu
+ * tedy sdílí spojení. WiFiServer::available() vrací (stejně jako knihovna
+ * WiFiNINA) pouze klienta, který má data ke čtení.
+ */
+
+#include <Arduino.h>
+
+#define WL_IDLE_STATUS 0
+#define WL_NO_SSID_AVAIL 1
+#define WL_SCAN_COMPLETED 2
+#define WL_CONNECTED 3
+#define WL_CONNECT_FAILED 4
+#define WL_CONNECTION_LOST 5
+#define WL_DISCONNECTED 6
+#define WL_AP_LISTENING 7
+#define WL_AP_CONNECTED 8
+#define WL_AP_FAILED 9
+#define WL_NO_MODULE 255
+
+const uint8_t hostNoSocket = 255; // Neplatný index socketu
+const uint8_t hostMaxSockets = 8; // Počet socketů (modul NINA jich má také několik málo)
+
+/**
+ * @class IPAddress
+ * @brief IPv4 adresa s indexováním po bajtech
+ */
+class IPAddress : public Printable
+{
+private:
+    uint8_t bytes[4];
+
+public:
+    IPAddress(uint8_t a = 0, uint8_t b = 0, uint8_t c = 0, uint8_t d = 0);
+    uint8_t operator[](int index) const { return bytes[index]; }
+    uint8_t &operator[](int index) { return bytes[index]; }
+    size_t printTo(Print &p) const override;
+};
+
+/**
+ * @class WiFiClient
+ * @brief TCP spojení (neblokující socket)
+ */
+class WiFiClient : public Stream
+{
+private:
+    uint8_t sock; // Index do tabulky socketů
+
+public:
+    WiFiClient();
+    explicit WiFiClient(uint8_t sock);
+
+    int connect(const char *host, uint16_t port);
+    uint8_t connected();
+    void stop();
+    explicit operator bool() const { return sock != hostNoSocket; }
+    bool operator==(const WiFiClient &other) const { return sock == other.sock; }
+    bool operator!=(const WiFiClient &other) const { return sock != other.sock; }
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    int availableForWrite() override;
+    void flush() override {}
+    int available() override;
+    int read() override;
+    int read(uint8_t *buffer, size_t size);
+    int peek() override;
+
+    IPAddress remoteIP();
+    uint16_t remotePort();
+    uint8_t getSocket() const { return sock; }
+};
+
+/**
+ * @class WiFiServer
+ * @brief Naslouchající TCP socket
+ */
+class WiFiServer
+{
+private:
+    uint16_t port;
+    int listenFd = -1;
+
+    void acceptPending();
+
+public:
+    explicit WiFiServer(uint16_t port);
+    void begin();
+    WiFiClient available();
+    WiFiClient accept();
+    uint8_t status() const { return listenFd >= 0 ? 1 : 0; }
+};
+
+/**
+ * @class WiFiUDP
+ * @brief UDP socket (neblokující), datagram se skládá mezi beginPacket a endPacket
+ */
+class WiFiUDP : public Stream
+{
+private:
+    int fd = -1;
+    uint8_t txPacket[1472];
+    size_t txLength = 0;
+    uint32_t txAddress = 0;
+    uint16_t txPort = 0;
+    uint8_t rxPacket[1472];
+    size_t rxLength = 0;
+    size_t rxPosition = 0;
+    uint32_t rxAddress = 0;
+    uint16_t rxPort = 0;
+
+public:
+    uint8_t begin(uint16_t port);
+    void stop();
+    int beginPacket(IPAddress ip, uint16_t port);
+    int endPacket();
+    int parsePacket();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *buffer, size_t size) override;
+    using Print::write;
+    void flush() override {}
+    int available() override;
+    int read() override;
+    int read(uint8_t *buffer, size_t size);
+    int peek() override;
+
+    IPAddress remoteIP();
+    uint16_t remotePort();
+};
+
+/**
+ * @class WiFiClass
+ * @brief Stav "rádia": připojení uspěje s jakýmkoli neprázdným SSID
+ */
+class WiFiClass
+{
+public:
+    uint8_t status();
+    int begin(const char *ssid, const char *pass);
+    uint8_t beginAP(const char *ssid, const char *pass);
+    int disconnect();
+    void end() {}
+    IPAddress localIP();
+    int32_t RSSI();
+    void setTimeout(unsigned long ms);
+};
+
+extern WiFiClass WiFi;
+
+#endif // HOST_WIFININA_H
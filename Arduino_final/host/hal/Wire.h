@@ -0,0 +1,16 @@
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+/**
+ * @class TwoWire
+ * @brief Prázdná sběrnice I2C (LCD na PC není)
+ */
+class TwoWire
+{
+public:
+    void begin() {}
+};
+
+extern TwoWire Wire;
+
+#endif // HOST_WIRE_H
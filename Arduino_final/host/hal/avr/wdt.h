@@ -0,0 +1,12 @@
+#ifndef HOST_AVR_WDT_H
+#define HOST_AVR_WDT_H
+
+#define WDTO_15MS 0
+
+/**
+ * @brief Watchdog na PC: zapnutí znamená restart procesu (viz HostHAL.cpp)
+ */
+void wdt_disable();
+void wdt_enable(int timeout);
+
+#endif // HOST_AVR_WDT_H
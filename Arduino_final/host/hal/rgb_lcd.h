@@ -0,0 +1,31 @@
+#ifndef HOST_RGB_LCD_H
+#define HOST_RGB_LCD_H
+
+#include <Arduino.h>
+
+/**
+ * @class rgb_lcd
+ * @brief LCD Grove bez výstupu, text se zahazuje
+ */
+class rgb_lcd : public Print
+{
+public:
+    void begin(uint8_t cols, uint8_t rows) {}
+    void clear() {}
+    void home() {}
+    void setCursor(uint8_t col, uint8_t row) {}
+    void cursor() {}
+    void noCursor() {}
+    void blink() {}
+    void noBlink() {}
+    void display() {}
+    void noDisplay() {}
+    void scrollDisplayLeft() {}
+    void scrollDisplayRight() {}
+    void setRGB(uint8_t r, uint8_t g, uint8_t b) {}
+
+    size_t write(uint8_t c) override { return 1; }
+    using Print::write;
+};
+
+#endif // HOST_RGB_LCD_H
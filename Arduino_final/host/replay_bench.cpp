@@ -0,0 +1,350 @@
+/**
+ * @file replay_bench.cpp
+ * @brief Přehrání záznamů z EMG_elektrody_test/data skutečnou cestou zpracování
+ *
+ * Záznamy (100 Hz) přehrává HAL na analogové piny v simulovaném čase, vzorkuje
+ * je EMGAcquisition::poll() s frekvencí refreshRateHz a zpracovává EMGSensorBank
+ * stejně jako EMGSystem. Kalibrace probíhá na klidovém záznamu. Vypisuje
+ * ns/vzorek (nejlepší z --repeat opakování), počty nástupů a konců aktivity a
+ * zpoždění rozhodnutí (od opuštění klidového pásma po potvrzení nástupu).
+ *
+ * S --filters místo toho změří jednotlivé stupně a řetězce z EMGFilter.h na
+ * klidovém záznamu a vypíše je vedle ručního odhadu cyklů AVR. Čas z PC
+ * nenahrazuje měření na desce (filterUs v GET /status), ukáže ale, zda
+ * poměry cen stupňů odpovídají odhadům.
+ *
+ * Použití: emg_replay_bench [--mode ema|mav|rms] [--channels N] [--repeat K]
+ *                           [--rest klid.csv] [--filters] [záznam.csv ...]
+ */
+
+#include "HostHAL.h"
+#include "Config.h"
+#include "EMGAcquisition.h"
+#include "EMGSensorBank.h"
+#include <string>
+#include <time.h>
+#include <vector>
+
+#ifndef EMG_DATA_DIR
+#define EMG_DATA_DIR "../EMG_elektrody_test/data"
+#endif
+
+static const char *const defaultRecordings[] = {
+    "impulzní_char.csv",
+    "přechodová_char.csv",
+    "zatnutí_tricepsu.csv",
+    "pohyb_ruky_prvni_k_sobe.csv",
+    "hýbání_kabely.csv",
+    "klidový_stav.csv",
+};
+
+static const unsigned long samplePeriodUs = 1000000UL / refreshRateHz;
+
+/**
+ * @brief Záznam načtený z CSV
+ */
+struct Recording
+{
+    int16_t *samples = nullptr;
+    size_t count = 0;
+    uint32_t sampleRateHz = 0;
+};
+
+/**
+ * @brief Souhrn jednoho přehrání
+ */
+struct ReplayResult
+{
+    size_t frames = 0;
+    double nsPerSample = 0;
+    uint32_t onsets = 0;
+    uint32_t offsets = 0;
+    EMGOnsetStats latency[maxSensors];
+};
+
+static uint64_t monotonicNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+/**
+ * @brief Vypíše text zarovnaný na šířku ve znacích (názvy záznamů jsou v UTF-8)
+ */
+static void printPadded(const char *text, int width)
+{
+    int chars = 0;
+    for (const char *c = text; *c; c++)
+        chars += ((*c & 0xC0) != 0x80);
+    printf("%s%*s", text, width > chars ? width - chars : 0, "");
+}
+
+static bool loadRecording(const char *path, Recording &recording)
+{
+    recording.count = hostLoadCsv(path, &recording.samples, &recording.sampleRateHz);
+    if (recording.count == 0)
+        fprintf(stderr, "Nelze načíst %s\n", path);
+    return recording.count > 0;
+}
+
+/**
+ * @brief Přehraje záznam na všechny kanály a posbírá snímky z EMGAcquisition
+ * @param recording Záznam
+ * @param channels Počet kanálů
+ * @param frames Výstup - snímky v pořadí vzorkování
+ * @param limitFrames Nejvýše tolik snímků (0 = celý záznam)
+ */
+static void acquire(const Recording &recording, uint8_t channels, std::vector<EMGFrame> &frames, size_t limitFrames)
+{
+    for (uint8_t i = 0; i < channels; i++)
+        hostSetAnalogFeed(emgPins[i], recording.samples, recording.count, recording.sampleRateHz, limitFrames != 0);
+
+    emgAcquisition.begin(channels, refreshRateHz);
+    frames.clear();
+
+    EMGFrame frame;
+    while (limitFrames ? frames.size() < limitFrames : !hostAnalogFeedFinished(emgPins[0]))
+    {
+        hostAdvanceMicros(samplePeriodUs);
+        emgAcquisition.poll();
+        while (emgAcquisition.read(frame))
+            frames.push_back(frame);
+    }
+    emgAcquisition.end();
+}
+
+/**
+ * @brief Zpracuje snímky kalibrovanou bankou a změří čas i detekce
+ */
+static ReplayResult replay(const EMGSensorBank &calibrated, const std::vector<EMGFrame> &frames, uint8_t channels, int repeat)
+{
+    ReplayResult result;
+    result.frames = frames.size();
+
+    EMGSensorBank bank;
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < repeat; r++)
+    {
+        bank = calibrated;
+        uint8_t previousActive = bank.getActiveMask();
+        uint32_t onsets = 0, offsets = 0;
+
+        uint64_t start = monotonicNs();
+        for (size_t i = 0; i < frames.size(); i++)
+        {
+            uint8_t active = bank.update(frames[i]);
+            onsets += __builtin_popcount(bank.getOnsetMask());
+            offsets += __builtin_popcount(previousActive & ~active);
+            previousActive = active;
+        }
+        uint64_t elapsed = monotonicNs() - start;
+
+        if (elapsed < best)
+            best = elapsed;
+        result.onsets = onsets;
+        result.offsets = offsets;
+    }
+
+    result.nsPerSample = frames.empty() ? 0 : (double)best / ((double)frames.size() * channels);
+    for (uint8_t ch = 0; ch < channels; ch++)
+        result.latency[ch] = bank.getOnsetStats(ch);
+    return result;
+}
+
+/**
+ * @brief Změří stupeň nebo řetězec filtrů na vstupních vzorcích a vypíše ho vedle odhadu
+ * @param name Název pro výpis
+ * @param input Vzorky ADC ve formátu Q3
+ * @param repeat Počet opakování (platí nejrychlejší)
+ * @param biquadNs Změřený čas biquadu pro poměr (0 = tento řádek je biquad)
+ * @return Změřený čas v ns/vzorek
+ */
+template <class Stage>
+static double timeStage(const char *name, const std::vector<int16_t> &input, int repeat, double biquadNs)
+{
+    volatile int16_t sink = 0;
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < repeat; r++)
+    {
+        Stage stage;
+        stage.reset(input[0]);
+        int32_t acc = 0;
+        uint64_t start = monotonicNs();
+        for (int16_t x : input)
+            acc += stage.process(x);
+        uint64_t elapsed = monotonicNs() - start;
+        sink = (int16_t)acc;
+        if (elapsed < best)
+            best = elapsed;
+    }
+    (void)sink;
+
+    double ns = (double)best / input.size();
+    double cyclesPerUs = F_CPU / 1000000.0;
+    printPadded(name, 28);
+    printf(" %8u %9.1f %9.2f %9.2f %9.2f\n", Stage::cycles, Stage::cycles / cyclesPerUs, ns,
+           (double)Stage::cycles / Biquad<HighPassDesign<refreshRateHz, 200> >::cycles, biquadNs > 0 ? ns / biquadNs : 1.0);
+    return ns;
+}
+
+/**
+ * @brief Vypíše změřené ceny stupňů a řetězců vedle odhadů cyklů z EMGFilter.h
+ * @param frames Snímky (použije se kanál 0)
+ * @param repeat Počet opakování
+ */
+static void benchFilters(const std::vector<EMGFrame> &frames, int repeat)
+{
+    std::vector<int16_t> input;
+    for (const EMGFrame &frame : frames)
+        input.push_back((int16_t)(frame.raw[0] << filterSampleShift));
+
+    printf("filtry na %zu vzorcích kanálu 0, odhad AVR při %lu MHz\n\n", input.size(), (unsigned long)(F_CPU / 1000000UL));
+    printPadded("stupeň", 28);
+    printf(" %8s %9s %9s %9s %9s\n", "cykly", "odhad µs", "PC ns", "odhad/BQ", "PC/BQ");
+
+    typedef Biquad<HighPassDesign<refreshRateHz, 200> > HighPass;
+    double biquad = timeStage<HighPass>("biquad horní propust 20 Hz", input, repeat, 0);
+    timeStage<Biquad<NotchDesign<refreshRateHz, 500, 5000> > >("biquad zádrž 50 Hz", input, repeat, biquad);
+    timeStage<Biquad<LowPassDesign<refreshRateHz, 100> > >("biquad dolní propust 10 Hz", input, repeat, biquad);
+    timeStage<Rectifier>("usměrnění", input, repeat, biquad);
+    timeStage<Teager<7> >("Teager-Kaiser", input, repeat, biquad);
+    timeStage<FixedOffset<341> >("pevný offset", input, repeat, biquad);
+    printf("\n");
+    timeStage<EMGLegacyChain>("EMGLegacyChain", input, repeat, biquad);
+    timeStage<EMGBandNotchChain>("EMGBandNotchChain", input, repeat, biquad);
+    timeStage<EMGTeagerChain>("EMGTeagerChain", input, repeat, biquad);
+
+    printf("\nodhad banky %lu cyklů/snímek = %.1f %% CPU při %d Hz (rozpočet %u %%)\n",
+           (unsigned long)EMGChannelFilters::cycles, EMGChannelFilters::cycles * 100.0 * refreshRateHz / F_CPU,
+           refreshRateHz, filterCpuBudgetPercent);
+}
+
+static void usage(const char *name)
+{
+    fprintf(stderr,
+            "Použití: %s [--mode ema|mav|rms] [--channels N] [--repeat K]\n"
+            "          [--rest klid.csv] [--filters] [záznam.csv ...]\n",
+            name);
+}
+
+int main(int argc, char **argv)
+{
+    EMGEnvelopeMode mode = envelopeMode;
+    uint8_t channels = emgChannelCount;
+    int repeat = 5;
+    std::string restPath = std::string(EMG_DATA_DIR) + "/klidový_stav.csv";
+    std::vector<std::string> paths;
+    bool filters = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--mode") && hasValue)
+        {
+            const char *name = argv[++i];
+            mode = !strcmp(name, "mav") ? EMG_ENVELOPE_MAV : !strcmp(name, "rms") ? EMG_ENVELOPE_RMS : EMG_ENVELOPE_EMA;
+        }
+        else if (!strcmp(argv[i], "--channels") && hasValue)
+        {
+            int count = atoi(argv[++i]); // constrain je makro, argument se vyhodnotí víckrát
+            channels = (uint8_t)constrain(count, 1, maxSensors);
+        }
+        else if (!strcmp(argv[i], "--repeat") && hasValue)
+            repeat = max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--rest") && hasValue)
+            restPath = argv[++i];
+        else if (!strcmp(argv[i], "--filters"))
+            filters = true;
+        else if (argv[i][0] == '-')
+        {
+            usage(argv[0]);
+            return 2;
+        }
+        else
+            paths.push_back(argv[i]);
+    }
+    if (paths.empty())
+        for (const char *name : defaultRecordings)
+            paths.push_back(std::string(EMG_DATA_DIR) + "/" + name);
+
+    hostUseSimulatedTime(true);
+
+    Recording rest;
+    if (!loadRecording(restPath.c_str(), rest))
+        return 1;
+
+    // Kalibrace jednou na klidovém záznamu, každý soubor pak začíná ze stejného stavu
+    std::vector<EMGFrame> frames;
+    acquire(rest, channels, frames, (size_t)calibrationWindowMs * refreshRateHz / 1000);
+
+    if (filters)
+    {
+        benchFilters(frames, repeat);
+        free(rest.samples);
+        return 0;
+    }
+
+    EMGSensorBank calibrated;
+    if (!calibrated.setEnvelopeMode(mode))
+    {
+        fprintf(stderr, "Obálka MAV/RMS vyžaduje EMG_WINDOW_ENVELOPE\n");
+        free(rest.samples);
+        return 1;
+    }
+    calibrated.begin(channels);
+    calibrated.beginCalibration();
+    for (const EMGFrame &frame : frames)
+    {
+        calibrated.update(frame);
+        calibrated.addCalibrationSample(frame);
+    }
+    calibrated.finishCalibration();
+    calibrated.resetOnsetStats();
+
+#ifdef EMG_FLOAT_PIPELINE
+    printf("obálka EMA ve float bez filtrů (původní cesta, jen historické srovnání), kanály %u, %d Hz, "
+           "kalibrace %u ms na %s\n", channels, refreshRateHz, calibrationWindowMs, restPath.c_str());
+#else
+    static const char *const modeNames[] = {"EMA", "MAV", "RMS"};
+    printf("obálka %s, kanály %u, %d Hz, kalibrace %u ms na %s\n", modeNames[mode], channels, refreshRateHz,
+           calibrationWindowMs, restPath.c_str());
+#endif
+    printf("  práh horní/dolní kanálu 0: %.2f / %.2f mV\n\n", calibrated.getThresholdUpper(0) * 1000.0,
+           calibrated.getThresholdLower(0) * 1000.0);
+    printPadded("záznam", 30);
+    printf(" %8s %9s %7s %7s  %s\n", "vzorky", "ns/vzorek", "nástupy", "konce", "zpoždění min/avg/max ms");
+
+    size_t totalFrames = 0;
+    double totalNs = 0;
+    uint32_t totalOnsets = 0;
+
+    for (const std::string &path : paths)
+    {
+        Recording recording;
+        if (!loadRecording(path.c_str(), recording))
+            return 1;
+
+        acquire(recording, channels, frames, 0);
+        ReplayResult result = replay(calibrated, frames, channels, repeat);
+        free(recording.samples);
+
+        const EMGOnsetStats &stats = result.latency[0];
+        double msPerSample = 1000.0 / refreshRateHz;
+        const char *name = strrchr(path.c_str(), '/');
+        printPadded(name ? name + 1 : path.c_str(), 30);
+        printf(" %8zu %9.1f %7u %7u  %6.0f/%5.1f/%5.0f\n", result.frames,
+               result.nsPerSample, result.onsets, result.offsets, stats.minLatency * msPerSample,
+               stats.events ? (double)stats.totalLatency / stats.events * msPerSample : 0.0,
+               stats.maxLatency * msPerSample);
+
+        totalFrames += result.frames;
+        totalNs += result.nsPerSample * result.frames;
+        totalOnsets += result.onsets;
+    }
+
+    printf("\ncelkem %zu snímků, %.1f ns/vzorek, %u nástupů, přetečení bufferu %lu\n", totalFrames,
+           totalFrames ? totalNs / totalFrames : 0.0, totalOnsets, (unsigned long)emgAcquisition.getOverrunCount());
+    free(rest.samples);
+    return 0;
+}
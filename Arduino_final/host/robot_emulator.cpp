@@ -0,0 +1,647 @@
+/**
+ * @file robot_emulator.cpp
+ * @brief Emulátor řídicího klienta (robot ABB GoFa) a zátěžový test TCP serveru EMG
+ *
+ * Spouští opakované relace proti zařízení nebo firmwaru přeloženému pro PC,
+ * nejvýše --parallel současně, celkem --sessions. První relace každé vlny se
+ * ohlásí jako robot (ROLE CONTROL, RTT ON): odpovídá na ALIVE a PING
+ * zařízení a počítá přijaté příkazy. Ostatní jsou monitory (ROLE OBSERVE) s binární
+ * telemetrií (STREAM). Každá relace posílá vlastní PINGy a doba do PONG je
+ * doba odezvy protokolu (oba směry přes fronty modulu, smyčku, parser a TX),
+ * ne zpoždění příkazu. To se měří jen s --udp-port: robot zapne kopie příkazů
+ * přes UDP a čas vzniku příkazu z datagramu se převede na místní hodiny podle
+ * PING/PONG s nejkratší odezvou (chyba nejvýše polovina této odezvy).
+ *
+ * Poruchy: --abort-pct relací skončí uprostřed bez DISCONNECT (RST), a
+ * --slow-pct relací čte jen --slow-bytes každých --slow-ms (malý přijímací
+ * buffer, zaplní se buffery zařízení). Po odmítnutí (BUSY) nebo neúspěšném
+ * connect zkusí slot další relaci až za --retry-ms.
+ *
+ * Na konci vypíše počty relací podle výsledku, p50/p99/max doby od connect
+ * do potvrzení role (ROLE ...), odezvy PING/PONG a případně zpoždění příkazu
+ * od vzniku na zařízení po příjem datagramu, a propustnost příkazů a telemetrie. Jednotný výstup slouží k porovnání změn firmwaru.
+ *
+ * Použití: emg_robot_emulator [--host IP] [--port N] [--sessions N] [--parallel N] [--session-ms MS]
+ *          [--ping-ms MS] [--samples N] [--abort-pct P] [--slow-pct P] [--slow-ms MS] [--slow-bytes N]
+ *          [--retry-ms MS] [--udp-port N] [--seed N] [--verbose]
+ */
+
+#include "EMGCommandLink.h"
+#include "EMGTelemetry.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+static uint64_t monotonicUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Vrací percentil z neseřazených hodnot (v ms)
+ */
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+/**
+ * @brief Nastavení zátěže z příkazové řádky
+ */
+struct Options
+{
+    const char *host = "127.0.0.1";
+    int port = tcpPort;
+    int sessions = 20;
+    int parallel = 3;
+    int sessionMs = 3000;
+    int pingMs = 100;
+    int samples = telemetrySamplesPerFrame;
+    int abortPct = 0;
+    int slowPct = 0;
+    int slowMs = 200;
+    int slowBytes = 64;
+    int retryMs = 1000;
+    int udpPort = 0; // 0 = příkazy jen přes TCP, zpoždění příkazu se neměří
+    unsigned seed = 1;
+    bool verbose = false;
+};
+
+/**
+ * @brief Příchod příkazu přes UDP (první kopie)
+ */
+struct CommandStamp
+{
+    uint32_t deviceUs;  // Čas vzniku příkazu na zařízení
+    uint32_t arrivalUs; // Příchod datagramu (místní čas)
+};
+
+/**
+ * @brief Souhrnné výsledky všech relací
+ */
+struct Results
+{
+    uint64_t started = 0;      // Zahájené relace
+    uint64_t ready = 0;        // Relace s potvrzenou rolí
+    uint64_t connectFail = 0;  // connect selhal
+    uint64_t busy = 0;         // Zařízení odmítlo (BUSY, všechny sloty obsazené)
+    uint64_t readyTimeout = 0; // Role nepotvrzena (časový limit nebo zavření spojení)
+    uint64_t clean = 0;        // Ukončeno DISCONNECT a zavřením ze strany zařízení
+    uint64_t closeTimeout = 0; // Po DISCONNECT zařízení spojení nezavřelo
+    uint64_t aborted = 0;      // Záměrně přerušeno (RST)
+    uint64_t dropped = 0;      // Zařízení zavřelo spojení uprostřed relace
+    uint64_t demoted = 0;      // Robot ztratil řízení (převzala ho další relace)
+    uint64_t commands = 0;     // Příkazy robotovi (číselné řádky)
+    uint64_t pings = 0;        // PINGy zařízení zodpovězené robotem
+    uint64_t pongLost = 0;     // Vlastní PINGy bez odpovědi do pongTimeoutUs
+    uint64_t datagrams = 0;    // Datagramy příkazů včetně kopií
+    uint64_t frames = 0;       // Rámce telemetrie
+    uint64_t samples = 0;      // Vzorky telemetrie
+    uint64_t gaps = 0;         // Chybějící rámce podle pořadových čísel
+    uint64_t bytes = 0;        // Všechny přijaté bajty
+    std::vector<double> readyMs;            // Doba od connect do potvrzení role
+    std::vector<double> rttMs;              // Odezva protokolu PING -> PONG (oba směry)
+    std::vector<CommandStamp> udpCommands;  // Příkazy doručené přes UDP
+    uint32_t clockOffsetUs = 0;             // Čas zařízení - místní čas (mod 2^32)
+    uint32_t bestRttUs = UINT32_MAX;        // Nejkratší odezva, ze které je offset
+    bool haveUdpSequence = false;           // Dorazil už nějaký datagram
+    uint16_t lastUdpSequence = 0;           // Pořadové číslo posledního příkazu přes UDP
+};
+
+/**
+ * @brief Stav jedné relace
+ */
+struct Session
+{
+    enum Phase
+    {
+        IDLE,
+        CONNECTING,
+        WAIT_READY,
+        RUNNING,
+        CLOSING
+    };
+
+    int fd = -1;
+    Phase phase = IDLE;
+    bool control = false;
+    bool abort = false;
+    bool slow = false;
+    bool rejected = false;     // Zařízení odpovědělo BUSY
+    uint64_t startUs = 0;      // Zahájení connect
+    uint64_t runUntilUs = 0;   // Konec relace (DISCONNECT)
+    uint64_t abortAtUs = 0;    // Okamžik přerušení (jen abort)
+    uint64_t deadlineUs = 0;   // Časový limit čekání (WAIT_READY, CLOSING)
+    uint64_t nextPingUs = 0;   // Další vlastní PING
+    uint64_t pingSentUs = 0;   // Odeslání čekajícího PINGu
+    uint64_t nextReadUs = 0;   // Další čtení pomalého čtenáře
+    uint64_t nextStartUs = 0;  // Nejbližší zahájení další relace v tomto slotu
+    uint32_t pingToken = 0;
+    bool pingPending = false;
+    bool haveSequence = false;
+    uint16_t expected = 0;
+    size_t filled = 0;
+    uint8_t buffer[1 << 14];
+};
+
+static const uint64_t readyTimeoutUs = 3000000; // Role musí být potvrzena do 3 s
+static const uint64_t closeTimeoutUs = 1000000; // Po DISCONNECT musí zařízení zavřít do 1 s
+static const uint64_t pongTimeoutUs = 1000000;  // PING bez odpovědi po 1 s se počítá jako ztracený
+
+static Options options;
+static Results results;
+static uint32_t randomState;
+
+/**
+ * @brief Pseudonáhodné číslo 0 až 99 (xorshift, opakovatelné podle --seed)
+ */
+static int randomPercent()
+{
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState % 100;
+}
+
+static void sendText(Session &s, const char *text)
+{
+    send(s.fd, text, strlen(text), MSG_NOSIGNAL | MSG_DONTWAIT);
+}
+
+/**
+ * @brief Zavře socket relace, abort = RST místo FIN
+ */
+static void closeSession(Session &s, bool abort)
+{
+    if (abort)
+    {
+        struct linger lingerOff = {1, 0};
+        setsockopt(s.fd, SOL_SOCKET, SO_LINGER, &lingerOff, sizeof(lingerOff));
+    }
+    close(s.fd);
+    s.fd = -1;
+    s.phase = Session::IDLE;
+}
+
+/**
+ * @brief Zahájí neblokující connect nové relace
+ */
+static void startSession(Session &s, bool control)
+{
+    s.control = control;
+    s.abort = randomPercent() < options.abortPct;
+    s.slow = !s.abort && randomPercent() < options.slowPct;
+    s.rejected = false;
+    s.filled = 0;
+    s.haveSequence = false;
+    s.pingPending = false;
+    s.startUs = monotonicUs();
+    results.started++;
+
+    s.fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (s.slow)
+    {
+        int rcvbuf = 4096;
+        setsockopt(s.fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    }
+    fcntl(s.fd, F_SETFL, fcntl(s.fd, F_GETFL) | O_NONBLOCK);
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(options.port);
+    inet_pton(AF_INET, options.host, &addr.sin_addr);
+    if (connect(s.fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 && errno != EINPROGRESS)
+    {
+        results.connectFail++;
+        closeSession(s, false);
+        s.nextStartUs = s.startUs + (uint64_t)options.retryMs * 1000;
+        return;
+    }
+    s.phase = Session::CONNECTING;
+}
+
+/**
+ * @brief Spojení navázáno, ohlásí roli (server přijme klienta až podle prvních dat)
+ */
+static void onConnected(Session &s, uint64_t now)
+{
+    int error = 0;
+    socklen_t length = sizeof(error);
+    getsockopt(s.fd, SOL_SOCKET, SO_ERROR, &error, &length);
+    if (error)
+    {
+        results.connectFail++;
+        closeSession(s, false);
+        s.nextStartUs = now + (uint64_t)options.retryMs * 1000;
+        return;
+    }
+
+    char hello[48];
+    if (s.control && options.udpPort > 0)
+        snprintf(hello, sizeof(hello), "ROLE CONTROL\nRTT ON\nUDP %d\n", options.udpPort);
+    else if (s.control)
+        snprintf(hello, sizeof(hello), "ROLE CONTROL\nRTT ON\n"); // Robot odpovídá i na PINGy zařízení
+    else
+        snprintf(hello, sizeof(hello), "ROLE OBSERVE\nSTREAM %d\n", options.samples);
+    sendText(s, hello);
+    s.phase = Session::WAIT_READY;
+    s.deadlineUs = now + readyTimeoutUs;
+}
+
+/**
+ * @brief Zpracuje jeden textový řádek od zařízení
+ */
+static void handleLine(Session &s, char *line, uint64_t now)
+{
+    unsigned token;
+    unsigned long deviceUs;
+
+    if (!strncmp(line, "ROLE ", 5))
+    {
+        if (s.phase == Session::WAIT_READY)
+        {
+            results.ready++;
+            results.readyMs.push_back((now - s.startUs) / 1000.0);
+            s.phase = Session::RUNNING;
+            s.runUntilUs = now + (uint64_t)options.sessionMs * 1000;
+            s.abortAtUs = now + (uint64_t)options.sessionMs * (20 + randomPercent() * 3 / 5) * 10; // 20 až 80 %
+            s.nextPingUs = now;
+        }
+        else if (s.control && !strcmp(line, "ROLE OBSERVE"))
+            results.demoted++;
+    }
+    else if (!strcmp(line, "BUSY"))
+    {
+        results.busy++;
+        s.rejected = true;
+    }
+    else if (!strcmp(line, "ALIVE"))
+    {
+        if (s.control)
+            sendText(s, "ALIVE\n");
+    }
+    else if (!strncmp(line, "PING ", 5))
+    {
+        char pong[48];
+        snprintf(pong, sizeof(pong), "PONG %s\n", line + 5);
+        sendText(s, pong);
+        results.pings++;
+    }
+    else if (sscanf(line, "PONG %u %lu", &token, &deviceUs) == 2)
+    {
+        if (s.pingPending && token == s.pingToken)
+        {
+            uint32_t rtt = now - s.pingSentUs;
+            results.rttMs.push_back(rtt / 1000.0);
+            if (rtt < results.bestRttUs)
+            {
+                results.bestRttUs = rtt;
+                results.clockOffsetUs = (uint32_t)deviceUs - (uint32_t)(s.pingSentUs + rtt / 2);
+            }
+            s.pingPending = false;
+        }
+    }
+    else if (line[0] >= '0' && line[0] <= '9' && strspn(line, "0123456789") == strlen(line))
+        results.commands++;
+    else if (options.verbose)
+        printf("< %s\n", line);
+}
+
+/**
+ * @brief Rozdělí přijatá data na textové řádky a binární rámce
+ * @return Počet zpracovaných bajtů (zbytek čeká na další data)
+ */
+static size_t parse(Session &s, uint64_t now)
+{
+    uint8_t *data = s.buffer;
+    size_t size = s.filled;
+    size_t pos = 0;
+    while (pos < size)
+    {
+        if (data[pos] == telemetrySync)
+        {
+            if (size - pos < telemetryHeaderBytes)
+                break;
+            const uint8_t *header = data + pos;
+            size_t valuesPerSample = header[2] * ((header[1] & telemetryFlagRaw) ? 2 : 1);
+            size_t frameBytes = telemetryHeaderBytes + header[3] * valuesPerSample * sizeof(uint16_t);
+            if (size - pos < frameBytes)
+                break;
+
+            uint16_t sequence = get16(header + 4);
+            if (s.haveSequence && sequence != s.expected)
+                results.gaps += (uint16_t)(sequence - s.expected);
+            s.expected = sequence + 1;
+            s.haveSequence = true;
+            results.frames++;
+            results.samples += header[3];
+            pos += frameBytes;
+            continue;
+        }
+
+        uint8_t *end = (uint8_t *)memchr(data + pos, '\n', size - pos);
+        if (!end)
+        {
+            // Řádek delší než buffer by čtení zablokoval
+            if (pos == 0 && size == sizeof(s.buffer))
+                pos = size;
+            break;
+        }
+        *end = '\0';
+        if (end > data + pos && end[-1] == '\r')
+            end[-1] = '\0';
+        handleLine(s, (char *)data + pos, now);
+        pos = end - data + 1;
+    }
+    return pos;
+}
+
+/**
+ * @brief Přečte data relace, při zavření spojení relaci ukončí
+ */
+static void onReadable(Session &s, uint64_t now)
+{
+    size_t room = sizeof(s.buffer) - s.filled;
+    if (s.slow && s.phase == Session::RUNNING)
+    {
+        room = std::min(room, (size_t)options.slowBytes);
+        s.nextReadUs = now + (uint64_t)options.slowMs * 1000;
+    }
+
+    ssize_t n = recv(s.fd, s.buffer + s.filled, room, 0);
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        return;
+    if (n <= 0)
+    {
+        if (s.phase == Session::CLOSING)
+            results.clean++;
+        else if (s.phase == Session::RUNNING)
+            results.dropped++;
+        else if (!s.rejected)
+            results.readyTimeout++;
+        closeSession(s, false);
+        if (s.rejected)
+            s.nextStartUs = now + (uint64_t)options.retryMs * 1000;
+        return;
+    }
+
+    results.bytes += n;
+    s.filled += n;
+    size_t used = parse(s, now);
+    memmove(s.buffer, s.buffer + used, s.filled - used);
+    s.filled -= used;
+}
+
+/**
+ * @brief Časované akce relace (PING, přerušení, konec, časové limity)
+ */
+static void onTick(Session &s, uint64_t now)
+{
+    if (s.phase == Session::WAIT_READY && now >= s.deadlineUs)
+    {
+        results.readyTimeout++;
+        closeSession(s, false);
+    }
+    else if (s.phase == Session::CLOSING && now >= s.deadlineUs)
+    {
+        results.closeTimeout++;
+        closeSession(s, false);
+    }
+    else if (s.phase == Session::RUNNING)
+    {
+        if (s.abort && now >= s.abortAtUs)
+        {
+            results.aborted++;
+            closeSession(s, true);
+            return;
+        }
+        if (now >= s.runUntilUs)
+        {
+            sendText(s, s.control ? "DISCONNECT\n" : "STREAM OFF\nDISCONNECT\n");
+            s.pingPending = false; // Odpověď na poslední PING může zůstat za DISCONNECT
+            s.phase = Session::CLOSING;
+            s.deadlineUs = now + closeTimeoutUs;
+            return;
+        }
+        // Další PING až po odpovědi, jinak by pomalý čtenář počítal jen ztráty
+        if (s.pingPending && now - s.pingSentUs >= pongTimeoutUs)
+        {
+            results.pongLost++;
+            s.pingPending = false;
+        }
+        if (now >= s.nextPingUs && !s.pingPending && options.pingMs > 0)
+        {
+            char ping[24];
+            snprintf(ping, sizeof(ping), "PING %u\n", ++s.pingToken);
+            s.pingSentUs = now;
+            s.pingPending = true;
+            sendText(s, ping);
+            s.nextPingUs = now + (uint64_t)options.pingMs * 1000;
+        }
+    }
+}
+
+/**
+ * @brief Přečte datagram příkazu a zaznamená příchod jeho první kopie
+ */
+static void readDatagram(int fd, uint64_t now)
+{
+    uint8_t datagram[64];
+    ssize_t n = recv(fd, datagram, sizeof(datagram), MSG_DONTWAIT);
+    if (n != commandDatagramBytes || datagram[0] != commandDatagramSync)
+        return;
+    results.datagrams++;
+
+    // Kopie mají stejné pořadové číslo, započte se jen první
+    uint16_t sequence = get16(datagram + 4);
+    if (results.haveUdpSequence && (int16_t)(sequence - results.lastUdpSequence) <= 0)
+        return;
+    results.haveUdpSequence = true;
+    results.lastUdpSequence = sequence;
+    results.udpCommands.push_back({get32(datagram + 6), (uint32_t)now});
+}
+
+static bool parseOptions(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--host") && hasValue)
+            options.host = argv[++i];
+        else if (!strcmp(argv[i], "--port") && hasValue)
+            options.port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--sessions") && hasValue)
+            options.sessions = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--parallel") && hasValue)
+            options.parallel = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--session-ms") && hasValue)
+            options.sessionMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--ping-ms") && hasValue)
+            options.pingMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--samples") && hasValue)
+            options.samples = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--abort-pct") && hasValue)
+            options.abortPct = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--slow-pct") && hasValue)
+            options.slowPct = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--slow-ms") && hasValue)
+            options.slowMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--slow-bytes") && hasValue)
+            options.slowBytes = std::max(1, atoi(argv[++i]));
+        else if (!strcmp(argv[i], "--retry-ms") && hasValue)
+            options.retryMs = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--udp-port") && hasValue)
+            options.udpPort = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seed") && hasValue)
+            options.seed = strtoul(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--verbose"))
+            options.verbose = true;
+        else
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    if (!parseOptions(argc, argv))
+    {
+        fprintf(stderr,
+                "Použití: %s [--host IP] [--port N] [--sessions N] [--parallel N] [--session-ms MS]\n"
+                "          [--ping-ms MS] [--samples N] [--abort-pct P] [--slow-pct P] [--slow-ms MS]\n"
+                "          [--slow-bytes N] [--retry-ms MS] [--udp-port N] [--seed N] [--verbose]\n",
+                argv[0]);
+        return 2;
+    }
+    randomState = options.seed ? options.seed : 1;
+
+    int udp = -1;
+    if (options.udpPort > 0)
+    {
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        addr.sin_port = htons(options.udpPort);
+        udp = socket(AF_INET, SOCK_DGRAM, 0);
+        if (bind(udp, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            perror("bind");
+            return 1;
+        }
+    }
+
+    // Poslední položka je socket UDP (fd -1 poll přeskočí)
+    std::vector<Session> sessions(options.parallel);
+    std::vector<struct pollfd> fds(options.parallel + 1);
+    int launched = 0;
+    uint64_t start = monotonicUs();
+
+    while (true)
+    {
+        uint64_t now = monotonicUs();
+
+        // Volné místo dostane další relace; první ve vlně je robot
+        int active = 0;
+        for (Session &s : sessions)
+        {
+            if (s.phase == Session::IDLE && launched < options.sessions && now >= s.nextStartUs)
+            {
+                startSession(s, launched % options.parallel == 0);
+                launched++;
+            }
+            if (s.phase != Session::IDLE)
+                active++;
+        }
+        if (active == 0 && launched >= options.sessions)
+            break;
+
+        for (size_t i = 0; i < sessions.size(); i++)
+        {
+            Session &s = sessions[i];
+            fds[i].fd = s.fd;
+            fds[i].revents = 0;
+            if (s.phase == Session::IDLE)
+                fds[i].events = 0;
+            else if (s.phase == Session::CONNECTING)
+                fds[i].events = POLLOUT;
+            else
+                fds[i].events = (s.slow && now < s.nextReadUs) ? 0 : POLLIN;
+        }
+        fds[sessions.size()] = {udp, POLLIN, 0};
+        poll(fds.data(), fds.size(), 2);
+
+        now = monotonicUs();
+        if (fds[sessions.size()].revents & POLLIN)
+            readDatagram(udp, now);
+        for (size_t i = 0; i < sessions.size(); i++)
+        {
+            Session &s = sessions[i];
+            if (s.phase == Session::CONNECTING && (fds[i].revents & (POLLOUT | POLLERR | POLLHUP)))
+                onConnected(s, now);
+            else if (s.phase != Session::IDLE && (fds[i].revents & (POLLIN | POLLERR | POLLHUP)))
+                onReadable(s, now);
+            if (s.phase != Session::IDLE)
+                onTick(s, now);
+        }
+    }
+
+    double elapsed = (monotonicUs() - start) / 1e6;
+    printf("relace: %llu zahájeno, %llu připraveno, %llu ukončeno čistě\n", (unsigned long long)results.started,
+           (unsigned long long)results.ready, (unsigned long long)results.clean);
+    printf("poruchy: connect %llu, BUSY %llu, bez potvrzení role %llu, nezavřeno po DISCONNECT %llu\n",
+           (unsigned long long)results.connectFail, (unsigned long long)results.busy,
+           (unsigned long long)results.readyTimeout, (unsigned long long)results.closeTimeout);
+    printf("         přerušeno záměrně %llu, odpojeno zařízením %llu, robot ztratil řízení %llu\n",
+           (unsigned long long)results.aborted, (unsigned long long)results.dropped,
+           (unsigned long long)results.demoted);
+    printf("%-16s %9s %9s %9s %7s\n", "", "p50 ms", "p99 ms", "max ms", "počet");
+    printf("%-16s %9.3f %9.3f %9.3f %7zu\n", "connect->ROLE", percentile(results.readyMs, 0.50),
+           percentile(results.readyMs, 0.99), percentile(results.readyMs, 1.0), results.readyMs.size());
+    printf("%-16s %9.3f %9.3f %9.3f %7zu (bez odpovědi %llu)\n", "RTT PING->PONG", percentile(results.rttMs, 0.50),
+           percentile(results.rttMs, 0.99), percentile(results.rttMs, 1.0), results.rttMs.size(),
+           (unsigned long long)results.pongLost);
+    if (udp >= 0)
+    {
+        // Čas vzniku se převádí až na konci, offset z nejkratší odezvy celého běhu
+        std::vector<double> commandMs;
+        for (const CommandStamp &stamp : results.udpCommands)
+        {
+            uint32_t originUs = stamp.deviceUs - results.clockOffsetUs;
+            commandMs.push_back((int32_t)(stamp.arrivalUs - originUs) / 1000.0);
+        }
+        printf("%-16s %9.3f %9.3f %9.3f %7zu (datagramy %llu, chyba hodin do %.3f ms)\n", "vznik->UDP",
+               percentile(commandMs, 0.50), percentile(commandMs, 0.99), percentile(commandMs, 1.0),
+               commandMs.size(), (unsigned long long)results.datagrams,
+               results.bestRttUs == UINT32_MAX ? 0.0 : results.bestRttUs / 2000.0);
+        close(udp);
+    }
+    printf("propustnost za %.1f s: příkazy %llu (%.2f/s), PINGy zařízení %llu, rámce %llu (%.0f/s), vzorky %.0f/s,"
+           " %.0f B/s, mezery %llu\n",
+           elapsed, (unsigned long long)results.commands, results.commands / elapsed,
+           (unsigned long long)results.pings, (unsigned long long)results.frames, results.frames / elapsed,
+           results.samples / elapsed, results.bytes / elapsed, (unsigned long long)results.gaps);
+    return 0;
+}
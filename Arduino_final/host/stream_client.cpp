@@ -0,0 +1,240 @@
+/**
+ * @file stream_client.cpp
+ * @brief Příjem binární telemetrie (příkaz STREAM) a měření propustnosti
+ *
+ * Připojí se k TCP serveru EMG, zapne proud rámců a každou sekundu vypíše
+ * rámce/s, vzorky/s, B/s, mezery v pořadových číslech a počet rámců, které
+ * zařízení zahodilo. Textové zprávy (příkazy, ALIVE) prokládané mezi rámci
+ * vypisuje beze změny (kromě heartbeatu ALIVE). Na konci si vyžádá čítače zařízení (STREAM STATS).
+ * Rámec se přijme, jen pokud má hlavička platné hodnoty a za ním následuje
+ * další rámec nebo text; jinak se bajt 0xA5 bere jako součást poškozených
+ * dat a příjem se synchronizuje znovu od dalšího bajtu (přeskočené bajty se počítají).
+ * Ohlásí se jako monitor (ROLE OBSERVE), řízení robota tedy nepřebírá.
+ *
+ * Použití: emg_stream_client [--host IP] [--port N] [--samples N] [--raw] [--seconds S]
+ */
+
+#include "EMGTelemetry.h"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint64_t monotonicMs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static uint16_t get16(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8);
+}
+
+/**
+ * @brief Čítače přijímače za celé měření a za aktuální sekundu
+ */
+struct Counters
+{
+    uint64_t frames = 0;
+    uint64_t samples = 0;
+    uint64_t bytes = 0;
+    uint64_t gaps = 0;
+    uint64_t skippedBytes = 0;
+    uint16_t deviceDropped = 0;
+};
+
+/**
+ * @brief Ověří, že bajt může začínat další zprávu (rámec nebo ASCII text)
+ */
+static bool isMessageStart(uint8_t c)
+{
+    return c == telemetrySync || c == '\n' || c == '\r' || (c >= 0x20 && c < 0x7F);
+}
+
+/**
+ * @brief Vrací délku rámce podle hlavičky, 0 pokud hlavička nedává smysl
+ */
+static size_t frameLength(const uint8_t *header)
+{
+    uint8_t channels = header[2];
+    uint8_t samples = header[3];
+    if ((header[1] & ~telemetryFlagRaw) != 0 || channels == 0 || channels > maxSensors || samples == 0 ||
+        samples > telemetryMaxSamplesPerFrame)
+        return 0;
+
+    size_t valuesPerSample = channels * ((header[1] & telemetryFlagRaw) ? 2 : 1);
+    size_t frameBytes = telemetryHeaderBytes + samples * valuesPerSample * sizeof(uint16_t);
+    return frameBytes <= telemetryMaxFrameBytes ? frameBytes : 0;
+}
+
+/**
+ * @brief Rozdělí přijatá data na textové řádky a binární rámce
+ * @return Počet zpracovaných bajtů (zbytek čeká na další data)
+ */
+static size_t parse(const uint8_t *data, size_t size, Counters &counters, bool &haveSequence, uint16_t &expected)
+{
+    size_t pos = 0;
+    while (pos < size)
+    {
+        if (data[pos] == telemetrySync)
+        {
+            if (size - pos < telemetryHeaderBytes)
+                break;
+            const uint8_t *header = data + pos;
+            size_t frameBytes = frameLength(header);
+            if (frameBytes == 0)
+            {
+                counters.skippedBytes++;
+                pos++;
+                continue;
+            }
+            // Rámec platí, až když za ním začíná další zpráva (useknutý rámec by jinak posunul vše za ním)
+            if (size - pos <= frameBytes)
+                break;
+            if (!isMessageStart(data[pos + frameBytes]))
+            {
+                counters.skippedBytes++;
+                pos++;
+                continue;
+            }
+
+            uint16_t sequence = get16(header + 4);
+            if (haveSequence && sequence != expected)
+                counters.gaps += (uint16_t)(sequence - expected);
+            expected = sequence + 1;
+            haveSequence = true;
+            counters.deviceDropped = get16(header + 10);
+            counters.frames++;
+            counters.samples += header[3];
+            pos += frameBytes;
+            continue;
+        }
+
+        // Textová zpráva je jen ASCII, rámec uprostřed řádku znamená zbytek useknuté zprávy
+        size_t end = pos;
+        while (end < size && data[end] != '\n' && data[end] != telemetrySync && isMessageStart(data[end]))
+            end++;
+        if (end == size)
+            break;
+        if (data[end] != '\n')
+        {
+            size_t next = data[end] == telemetrySync ? end : end + 1;
+            counters.skippedBytes += next - pos;
+            pos = next;
+            continue;
+        }
+        if (end - pos != 5 || memcmp(data + pos, "ALIVE", 5) != 0)
+            printf("< %.*s\n", (int)(end - pos), (const char *)data + pos);
+        pos = end + 1;
+    }
+    return pos;
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = "127.0.0.1";
+    int port = tcpPort;
+    int frameSamples = telemetrySamplesPerFrame;
+    bool raw = false;
+    int seconds = 10;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--host") && hasValue)
+            host = argv[++i];
+        else if (!strcmp(argv[i], "--port") && hasValue)
+            port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--samples") && hasValue)
+            frameSamples = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--raw"))
+            raw = true;
+        else if (!strcmp(argv[i], "--seconds") && hasValue)
+            seconds = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Použití: %s [--host IP] [--port N] [--samples N] [--raw] [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("connect");
+        return 1;
+    }
+    struct timeval timeout = {0, 100000};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    char command[48];
+    snprintf(command, sizeof(command), "ROLE OBSERVE\nSTREAM %d%s\n", frameSamples, raw ? " RAW" : "");
+    send(fd, command, strlen(command), 0);
+
+    static uint8_t buffer[1 << 16];
+    size_t filled = 0;
+    Counters total, second;
+    bool haveSequence = false;
+    uint16_t expected = 0;
+    uint64_t start = monotonicMs(), secondStart = start;
+    bool statsRequested = false;
+
+    printf("%4s %8s %9s %9s %6s %8s\n", "s", "rámce/s", "vzorky/s", "B/s", "mezery", "zahozeno");
+    while (true)
+    {
+        uint64_t now = monotonicMs();
+        if (!statsRequested && now - start >= (uint64_t)seconds * 1000)
+        {
+            const char stats[] = "STREAM STATS\n";
+            send(fd, stats, sizeof(stats) - 1, 0);
+            statsRequested = true;
+        }
+        if (now - start >= (uint64_t)seconds * 1000 + 1000)
+            break;
+
+        ssize_t n = recv(fd, buffer + filled, sizeof(buffer) - filled, 0);
+        if (n == 0)
+        {
+            printf("spojení ukončeno\n");
+            break;
+        }
+        if (n > 0)
+        {
+            filled += n;
+            total.bytes += n;
+            second.bytes += n;
+            Counters before = total;
+            size_t used = parse(buffer, filled, total, haveSequence, expected);
+            second.frames += total.frames - before.frames;
+            second.samples += total.samples - before.samples;
+            second.gaps += total.gaps - before.gaps;
+            memmove(buffer, buffer + used, filled - used);
+            filled -= used;
+        }
+
+        if (now - secondStart >= 1000 && !statsRequested)
+        {
+            printf("%4llu %8llu %9llu %9llu %6llu %8u\n", (unsigned long long)((now - start) / 1000),
+                   (unsigned long long)second.frames, (unsigned long long)second.samples,
+                   (unsigned long long)second.bytes, (unsigned long long)second.gaps, total.deviceDropped);
+            second = Counters();
+            secondStart = now;
+        }
+    }
+
+    double elapsed = (monotonicMs() - start) / 1000.0;
+    printf("celkem: %llu rámců, %llu vzorků, %.0f B/s, mezery %llu, zahozeno zařízením %u, přeskočeno %llu B\n",
+           (unsigned long long)total.frames, (unsigned long long)total.samples, total.bytes / elapsed,
+           (unsigned long long)total.gaps, total.deviceDropped, (unsigned long long)total.skippedBytes);
+
+    const char off[] = "STREAM OFF\nDISCONNECT\n";
+    send(fd, off, sizeof(off) - 1, 0);
+    close(fd);
+    return 0;
+}
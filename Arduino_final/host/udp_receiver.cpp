@@ -0,0 +1,259 @@
+/**
+ * @file udp_receiver.cpp
+ * @brief Příjem příkazů přes UDP i TCP a porovnání zpoždění a ztrát obou cest
+ *
+ * Připojí se k TCP serveru EMG jako řídicí klient (robot), zapne kopie
+ * příkazů přes UDP (příkaz UDP) a zaznamená příchod každého příkazu po obou
+ * cestách. Hodiny zařízení se k místním vztahují přes PING/PONG (vzorek
+ * s nejkratší odezvou, chyba nejvýše polovina jeho doby odezvy). Na konci
+ * vypíše p50/p99 jednosměrného zpoždění UDP (první doručená kopie) a TCP,
+ * ztracené příkazy a datagramy a čítače zařízení (UDP STATS).
+ *
+ * Použití: emg_udp_receiver [--host IP] [--port N] [--udp-port N] [--repeats N] [--seconds S]
+ */
+
+#include "EMGCommandLink.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+static uint32_t monotonicUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000);
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Záznam jednoho příkazu (index = pořadové číslo)
+ */
+struct CommandRecord
+{
+    bool haveUdp = false;      // Dorazila aspoň jedna kopie
+    uint32_t deviceUs = 0;     // Čas vzniku příkazu na zařízení
+    uint32_t udpArrivalUs = 0; // Příchod první kopie (místní čas)
+    uint8_t copies = 0;        // Počet doručených kopií
+};
+
+/**
+ * @brief Vrací percentil z neseřazených hodnot (v ms)
+ */
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t)(p * (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+int main(int argc, char **argv)
+{
+    const char *host = "127.0.0.1";
+    int port = tcpPort;
+    int udpPort = 9999;
+    int repeats = udpCommandRepeats;
+    int seconds = 30;
+
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--host") && hasValue)
+            host = argv[++i];
+        else if (!strcmp(argv[i], "--port") && hasValue)
+            port = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--udp-port") && hasValue)
+            udpPort = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--repeats") && hasValue)
+            repeats = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--seconds") && hasValue)
+            seconds = atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Použití: %s [--host IP] [--port N] [--udp-port N] [--repeats N] [--seconds S]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(udpPort);
+    int udp = socket(AF_INET, SOCK_DGRAM, 0);
+    if (bind(udp, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("bind");
+        return 1;
+    }
+
+    addr.sin_port = htons(port);
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) != 1 || connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+    {
+        perror("connect");
+        return 1;
+    }
+
+    char command[64];
+    snprintf(command, sizeof(command), "ROLE CONTROL\nUDP %d %d\n", udpPort, repeats);
+    send(fd, command, strlen(command), 0);
+
+    std::vector<CommandRecord> records;
+    std::vector<uint32_t> tcpArrivalUs; // Příchod k-tého příkazu přes TCP (k = pořadové číslo)
+    uint64_t datagrams = 0;
+    bool udpOn = false;
+
+    // Synchronizace hodin: offset = čas zařízení - místní čas (mod 2^32)
+    uint32_t offsetUs = 0, bestRttUs = UINT32_MAX;
+    uint32_t pingSentUs = 0, pingToken = 0, lastPingUs = 0;
+    bool pingPending = false;
+
+    char line[128];
+    size_t lineLength = 0;
+    uint32_t start = monotonicUs();
+    bool statsRequested = false;
+
+    while (true)
+    {
+        uint32_t now = monotonicUs();
+        uint32_t elapsedUs = now - start;
+        if (!statsRequested && elapsedUs >= (uint32_t)seconds * 1000000)
+        {
+            const char stats[] = "UDP STATS\n";
+            send(fd, stats, sizeof(stats) - 1, 0);
+            statsRequested = true;
+        }
+        if (elapsedUs >= (uint32_t)seconds * 1000000 + 500000)
+            break;
+
+        if (!pingPending && now - lastPingUs >= 200000)
+        {
+            snprintf(command, sizeof(command), "PING %u\n", ++pingToken);
+            pingSentUs = monotonicUs();
+            send(fd, command, strlen(command), 0);
+            lastPingUs = pingSentUs;
+            pingPending = true;
+        }
+
+        struct pollfd fds[2] = {{fd, POLLIN, 0}, {udp, POLLIN, 0}};
+        if (poll(fds, 2, 10) <= 0)
+            continue;
+        uint32_t arrival = monotonicUs();
+
+        if (fds[1].revents & POLLIN)
+        {
+            uint8_t datagram[64];
+            ssize_t n = recv(udp, datagram, sizeof(datagram), 0);
+            if (n == commandDatagramBytes && datagram[0] == commandDatagramSync)
+            {
+                uint16_t sequence = datagram[4] | (datagram[5] << 8);
+                if (sequence >= records.size())
+                    records.resize(sequence + 1);
+                CommandRecord &record = records[sequence];
+                if (!record.haveUdp)
+                {
+                    record.haveUdp = true;
+                    record.deviceUs = get32(datagram + 6);
+                    record.udpArrivalUs = arrival;
+                }
+                record.copies++;
+                datagrams++;
+            }
+        }
+
+        if (fds[0].revents & POLLIN)
+        {
+            char buffer[512];
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0)
+            {
+                printf("spojení ukončeno\n");
+                break;
+            }
+            for (ssize_t i = 0; i < n; i++)
+            {
+                if (buffer[i] != '\n')
+                {
+                    if (lineLength < sizeof(line) - 1)
+                        line[lineLength++] = buffer[i];
+                    continue;
+                }
+                line[lineLength] = '\0';
+                lineLength = 0;
+
+                unsigned token;
+                unsigned long deviceUs;
+                if (sscanf(line, "PONG %u %lu", &token, &deviceUs) == 2 && pingPending && token == pingToken)
+                {
+                    uint32_t rtt = arrival - pingSentUs;
+                    if (rtt < bestRttUs)
+                    {
+                        bestRttUs = rtt;
+                        offsetUs = (uint32_t)deviceUs - (pingSentUs + rtt / 2);
+                    }
+                    pingPending = false;
+                }
+                else if (line[0] >= '0' && line[0] <= '9' && strspn(line, "0123456789") == strlen(line))
+                {
+                    if (udpOn)
+                        tcpArrivalUs.push_back(arrival);
+                }
+                else if (strcmp(line, "ALIVE") != 0)
+                {
+                    if (!strncmp(line, "UDP ON", 6))
+                        udpOn = true;
+                    printf("< %s\n", line);
+                }
+            }
+        }
+    }
+
+    const char off[] = "UDP OFF\nDISCONNECT\n";
+    send(fd, off, sizeof(off) - 1, 0);
+    close(fd);
+    close(udp);
+
+    // Ztráty se počítají proti TCP, které doručí každý příkaz
+    size_t commands = std::max(tcpArrivalUs.size(), records.size());
+    std::vector<double> udpLatency, tcpLatency;
+    size_t udpDelivered = 0;
+    uint64_t duplicates = 0;
+    for (size_t k = 0; k < records.size(); k++)
+    {
+        const CommandRecord &record = records[k];
+        if (!record.haveUdp)
+            continue;
+        udpDelivered++;
+        duplicates += record.copies - 1;
+
+        // Čas vzniku příkazu převedený na místní hodiny
+        uint32_t originUs = record.deviceUs - offsetUs;
+        udpLatency.push_back((int32_t)(record.udpArrivalUs - originUs) / 1000.0);
+        if (k < tcpArrivalUs.size())
+            tcpLatency.push_back((int32_t)(tcpArrivalUs[k] - originUs) / 1000.0);
+    }
+
+    printf("synchronizace hodin: nejkratší odezva %.3f ms (chyba offsetu do %.3f ms)\n", bestRttUs / 1000.0,
+           bestRttUs / 2000.0);
+    printf("příkazy: %zu, přes UDP doručeno %zu (ztráta %.1f %%)\n", commands, udpDelivered,
+           commands ? 100.0 * (commands - udpDelivered) / commands : 0.0);
+    printf("datagramy: %llu z %zu (ztráta %.1f %%), duplicity zahozeny %llu\n", (unsigned long long)datagrams,
+           commands * repeats, commands ? 100.0 * (commands * repeats - datagrams) / (commands * repeats) : 0.0,
+           (unsigned long long)duplicates);
+    printf("%-4s %9s %9s %9s\n", "", "p50 ms", "p99 ms", "max ms");
+    printf("%-4s %9.3f %9.3f %9.3f\n", "UDP", percentile(udpLatency, 0.50), percentile(udpLatency, 0.99),
+           percentile(udpLatency, 1.0));
+    printf("%-4s %9.3f %9.3f %9.3f\n", "TCP", percentile(tcpLatency, 0.50), percentile(tcpLatency, 0.99),
+           percentile(tcpLatency, 1.0));
+    return 0;
+}
@@ -0,0 +1,243 @@
+"""Převod HTML šablon z web/ na gzip bloky v PROGMEM (WebPages.h, WebPages.cpp).
+
+Každá šablona se rozdělí podle zástupných polí {{NAZEV}} na statické části.
+Statické části se komprimují zvlášť jako deflate bloky zakončené synchronizačním
+(prázdným uloženým) blokem, takže končí na hranici bajtu. Firmware mezi ně
+vloží hodnoty polí jako nekomprimované (uložené) bloky deflate a na konec
+přidá závěrečný blok a patičku gzip. CRC-32 celé stránky se skládá z CRC
+statických částí (předpočítané zde) a CRC polí (počítané za běhu) stejně
+jako crc32_combine v zlib, k čemuž každá část nese i x^(8·délka) mod P.
+
+    python3 build_pages.py            # přegeneruje WebPages.h a WebPages.cpp
+    python3 build_pages.py --check    # jen ověří, že vygenerované soubory odpovídají šablonám
+"""
+
+import gzip
+import os
+import re
+import sys
+import zlib
+
+# --- Konstanty ---
+WEB_DIR = os.path.dirname(os.path.abspath(__file__))
+SKETCH_DIR = os.path.dirname(WEB_DIR)
+PAGES = [  # (soubor šablony, název struktury GzipPage)
+    ("config.html", "webConfigPage"),
+    ("success.html", "webSuccessPage"),
+    ("restart.html", "webRestartPage"),
+]
+FIELD_PATTERN = re.compile(r"\{\{([A-Z_]+)\}\}")
+CRC_POLY = 0xEDB88320
+GZIP_HEADER = bytes([0x1F, 0x8B, 0x08, 0, 0, 0, 0, 0, 0, 0x03])  # Bez jména a času, OS Unix
+FINAL_BLOCK = bytes([0x01, 0x00, 0x00, 0xFF, 0xFF])  # Prázdný závěrečný uložený blok
+TRAILER_BYTES = 8  # CRC-32 a ISIZE
+
+
+def mult_mod_p(a, b):
+    """Součin a·b mod P v GF(2) v obráceném bitovém pořadí (multmodp ze zlib)."""
+    m = 1 << 31
+    p = 0
+    while True:
+        if a & m:
+            p ^= b
+            if (a & (m - 1)) == 0:
+                return p
+        m >>= 1
+        b = (b >> 1) ^ CRC_POLY if b & 1 else b >> 1
+
+
+def shift_operator(length):
+    """x^(8·length) mod P - posun CRC o length bajtů (crc32_combine_gen ze zlib)."""
+    result = 1 << 31  # x^0
+    power = 1 << 30  # x^1
+    bits = 8 * length
+    while bits:
+        if bits & 1:
+            result = mult_mod_p(power, result)
+        power = mult_mod_p(power, power)
+        bits >>= 1
+    return result
+
+
+def combine_crc(crc1, crc2, shift):
+    """CRC spojení dvou bloků ze CRC jednotlivých bloků."""
+    return mult_mod_p(shift, crc1) ^ crc2
+
+
+def stored_block(data):
+    """Nekomprimovaný (uložený) blok deflate, jak ho zapisuje GzipPageWriter."""
+    if not data:
+        return b""
+    length = len(data)
+    return bytes([0x00, length & 0xFF, length >> 8, ~length & 0xFF, (~length >> 8) & 0xFF]) + data
+
+
+def compress_segment(text):
+    """Deflate bloky jedné statické části končící na hranici bajtu.
+
+    Krátké části by komprese jen prodloužila, ty se uloží jako uložený blok.
+    """
+    if not text:
+        return b""
+    compressor = zlib.compressobj(9, zlib.DEFLATED, -15, 9)
+    packed = compressor.compress(text) + compressor.flush(zlib.Z_SYNC_FLUSH)
+    stored = stored_block(text)
+    return packed if len(packed) < len(stored) else stored
+
+
+def parse_template(path, field_names):
+    """Rozdělí šablonu na statické části a pořadí polí."""
+    with open(path, "rb") as f:
+        text = f.read().decode("utf-8")
+    parts = FIELD_PATTERN.split(text)
+    segments = [part.encode("utf-8") for part in parts[0::2]]
+    fields = parts[1::2]
+    field_names.update(fields)
+    return segments, fields
+
+
+def assemble(segments, values):
+    """Sestaví gzip stránky stejně jako firmware (pro kontrolu)."""
+    out = bytearray(GZIP_HEADER)
+    crc = 0
+    size = 0
+    for i, segment in enumerate(segments):
+        out += compress_segment(segment)
+        crc = combine_crc(crc, zlib.crc32(segment), shift_operator(len(segment)))
+        size += len(segment)
+        if i < len(values):
+            out += stored_block(values[i])
+            crc = zlib.crc32(values[i], crc)
+            size += len(values[i])
+    out += FINAL_BLOCK
+    out += crc.to_bytes(4, "little") + (size & 0xFFFFFFFF).to_bytes(4, "little")
+    return bytes(out)
+
+
+def self_check(pages):
+    """Ověří skládání CRC a dekódovatelnost stránek s ukázkovými hodnotami polí."""
+    a, b = b"<p>statika</p>", "Síť 5 GHz".encode("utf-8")
+    assert combine_crc(zlib.crc32(a), zlib.crc32(b), shift_operator(len(b))) == zlib.crc32(a + b)
+
+    for name, segments, fields in pages:
+        for sample in ([b""] * len(fields), [("{" + f + "}").encode() * 40 for f in fields]):
+            plain = b"".join(s + (sample[i] if i < len(sample) else b"") for i, s in enumerate(segments))
+            assert gzip.decompress(assemble(segments, sample)) == plain, name
+
+
+def format_bytes(data, indent="    "):
+    """Pole bajtů po 16 na řádek."""
+    lines = []
+    for i in range(0, len(data), 16):
+        lines.append(indent + ", ".join("0x%02x" % x for x in data[i:i + 16]) + ",")
+    return "\n".join(lines)
+
+
+def generate(pages, field_names):
+    """Vrátí obsah WebPages.h a WebPages.cpp."""
+    header = [
+        "// Vygenerováno skriptem web/build_pages.py ze šablon web/*.html - neupravovat ručně",
+        "#ifndef WEB_PAGES_H",
+        "#define WEB_PAGES_H",
+        "",
+        "#include <Arduino.h>",
+        "#include \"GzipPage.h\"",
+        "",
+        "/**",
+        " * @brief Dynamická pole stránek ({{NAZEV}} v šabloně)",
+        " */",
+        "enum WebPageField : uint8_t",
+        "{",
+    ]
+    header += ["    PAGE_FIELD_%s," % name for name in field_names]
+    header += ["};", ""]
+    header.append("const uint8_t webPageMaxFields = %d; // Nejvíc polí na jedné stránce (velikost pole délek)" %
+                  max(len(fields) for _, _, fields in pages))
+    header.append("")
+
+    declarations = []
+    source = [
+        "// Vygenerováno skriptem web/build_pages.py ze šablon web/*.html - neupravovat ručně",
+        "#include \"WebPages.h\"",
+        "",
+    ]
+
+    for name, segments, fields in pages:
+        plain = sum(len(s) for s in segments)
+        static_bytes = len(GZIP_HEADER) + len(FINAL_BLOCK) + TRAILER_BYTES
+        table = []
+        for i, segment in enumerate(segments):
+            data = compress_segment(segment)
+            static_bytes += len(data)
+            if data:
+                source.append("static const uint8_t %sSegment%d[] PROGMEM = {" % (name, i))
+                source.append(format_bytes(data))
+                source.append("};")
+                source.append("")
+            table.append("    {%s, %d, %d, 0x%08xUL, 0x%08xUL}," % (
+                "%sSegment%d" % (name, i) if data else "nullptr",
+                len(data), len(segment), zlib.crc32(segment), shift_operator(len(segment))))
+
+        source.append("static const GzipSegment %sSegments[] PROGMEM = {" % name)
+        source += table
+        source.append("};")
+        source.append("")
+        if fields:
+            source.append("static const uint8_t %sFields[] PROGMEM = {" % name)
+            source.append("    " + ", ".join("PAGE_FIELD_%s" % f for f in fields) + ",")
+            source.append("};")
+            source.append("")
+        source.append("// %d B textu, %d B gzip bez polí" % (plain, static_bytes))
+        source.append("const GzipPage %s PROGMEM = {%sSegments, %s, %d, %d};" % (
+            name, name, "%sFields" % name if fields else "nullptr", len(fields), static_bytes))
+        source.append("")
+
+        declarations.append(("extern const GzipPage %s;" % name, "// %d B textu, %d B gzip" % (plain, static_bytes)))
+
+    width = max(len(code) for code, _ in declarations)
+    header += ["%s %s" % (code.ljust(width), comment) for code, comment in declarations]
+    header += ["", "#endif // WEB_PAGES_H", ""]
+    return "\n".join(header), "\n".join(source)
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    field_names = set()
+    pages = []
+    for template, name in PAGES:
+        segments, fields = parse_template(os.path.join(WEB_DIR, template), field_names)
+        pages.append((name, segments, fields))
+    self_check(pages)
+
+    header, source = generate(pages, sorted(field_names))
+    outputs = [("WebPages.h", header), ("WebPages.cpp", source)]
+
+    stale = False
+    for filename, content in outputs:
+        path = os.path.join(SKETCH_DIR, filename)
+        current = None
+        if os.path.exists(path):
+            with open(path, "rb") as f:
+                current = f.read().decode("utf-8")
+        if current == content:
+            continue
+        stale = True
+        if not check:
+            with open(path, "wb") as f:
+                f.write(content.encode("utf-8"))
+            print("Zapsáno: %s" % filename)
+
+    for name, segments, fields in pages:
+        plain = sum(len(s) for s in segments)
+        packed = sum(len(compress_segment(s)) for s in segments)
+        print("%-16s %5d B textu -> %5d B deflate (%d %%), polí: %d" % (
+            name, plain, packed, 100 * packed // max(plain, 1), len(fields)))
+
+    if check and stale:
+        print("WebPages.h/WebPages.cpp neodpovídají šablonám, spusťte build_pages.py")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,14 +9,20 @@ try:
     client_socket.connect((arduino_ip, arduino_port))
     print(f"Připojeno k Arduinu na {arduino_ip}:{arduino_port}")
 
-    # Pošli první znak, aby se Arduino "aktivovalo"
-    client_socket.sendall(b"\n")
+    # Pošli první znak, aby se Arduino "aktivovalo", a zapni měření odezvy
+    client_socket.sendall(b"\nRTT ON\n")
 
     # Získej file-like objekt pro čtení po řádcích
     with client_socket.makefile("r") as sock_file:
         for line in sock_file:
             value = line.strip()  # odstraní \n a mezery
-            if value.isdigit():
+            if value == "ALIVE":
+                # Heartbeat - Arduino odpojí robota, který ztichne na 3 s
+                client_socket.sendall(b"ALIVE\n")
+            elif value.startswith("PING "):
+                # Arduino měří odezvu, odpověď musí odejít hned
+                client_socket.sendall(f"PONG {value[5:]}\n".encode())
+            elif value.isdigit():
                 print(f"Přijatá hodnota: {value}")
             else:
                 print(f"Neplatná data: {value}")